@@ -17,6 +17,7 @@
 #include "util/db/dbconnectionpooled.h"
 #include "util/db/dbconnectionpooler.h"
 #include "util/logger.h"
+#include "util/tracerecorder.h"
 
 namespace {
 
@@ -250,11 +251,13 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
         DEBUG_ASSERT(!chunkFrameRange.empty());
 
         // Request the next chunk of audio data
-        const auto readableSampleFrames =
-                audioSource->readSampleFrames(
-                        mixxx::WritableSampleFrames(
-                                chunkFrameRange,
-                                mixxx::SampleBuffer::WritableSlice(m_sampleBuffer)));
+        const auto readableSampleFrames = [&] {
+            mixxx::ScopedTraceEvent trace("analyzer", "AnalyzerThread::readSampleFrames");
+            return audioSource->readSampleFrames(
+                    mixxx::WritableSampleFrames(
+                            chunkFrameRange,
+                            mixxx::SampleBuffer::WritableSlice(m_sampleBuffer)));
+        }();
         // The returned range fits into the requested range
         DEBUG_ASSERT(readableSampleFrames.frameIndexRange().isSubrangeOf(chunkFrameRange));
 
@@ -299,6 +302,7 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
 
         // 2nd: step: Analyze chunk of decoded audio data
         if (!readableSampleFrames.frameIndexRange().empty()) {
+            mixxx::ScopedTraceEvent trace("analyzer", "AnalyzerThread::processSamples");
             for (auto&& analyzer : m_analyzers) {
                 analyzer.processSamples(
                         readableSampleFrames.readableData(),
@@ -0,0 +1,119 @@
+#include "control/controlsocketserver.h"
+
+#include <QLocalSocket>
+#include <QStringList>
+
+#include "control/controlobject.h"
+#include "moc_controlsocketserver.cpp"
+#include "util/logger.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("ControlSocketServer");
+
+// Protects against clients that never send a newline
+constexpr qint64 kMaxRequestLength = 1024;
+
+// For checking if another instance is listening on the socket
+constexpr int kConnectTimeoutMillis = 1000;
+
+QString errorResponse(const QString& message) {
+    return QStringLiteral("error ") + message;
+}
+
+} // anonymous namespace
+
+ControlSocketServer::ControlSocketServer(QObject* pParent)
+        : QObject(pParent) {
+    m_server.setSocketOptions(QLocalServer::UserAccessOption);
+    connect(&m_server,
+            &QLocalServer::newConnection,
+            this,
+            &ControlSocketServer::slotNewConnection);
+}
+
+ControlSocketServer::~ControlSocketServer() = default;
+
+bool ControlSocketServer::listen(const QString& name) {
+    if (!m_server.listen(name)) {
+        if (m_server.serverError() != QAbstractSocket::AddressInUseError) {
+            kLogger.warning() << "Failed to listen on" << name << ":" << m_server.errorString();
+            return false;
+        }
+        // Only remove the socket if it has been left behind by a crashed
+        // instance, but not if another instance is still listening on it
+        QLocalSocket socket;
+        socket.connectToServer(name);
+        if (socket.waitForConnected(kConnectTimeoutMillis)) {
+            kLogger.warning() << "Another instance is already listening on" << name;
+            return false;
+        }
+        QLocalServer::removeServer(name);
+        if (!m_server.listen(name)) {
+            kLogger.warning() << "Failed to listen on" << name << ":" << m_server.errorString();
+            return false;
+        }
+    }
+    kLogger.info() << "Listening on" << m_server.fullServerName();
+    return true;
+}
+
+void ControlSocketServer::slotNewConnection() {
+    while (QLocalSocket* pSocket = m_server.nextPendingConnection()) {
+        connect(pSocket, &QLocalSocket::disconnected, pSocket, &QLocalSocket::deleteLater);
+        connect(pSocket, &QLocalSocket::readyRead, this, [this, pSocket]() {
+            readRequests(pSocket);
+        });
+    }
+}
+
+void ControlSocketServer::readRequests(QLocalSocket* pSocket) {
+    while (pSocket->canReadLine()) {
+        const QString request = QString::fromUtf8(pSocket->readLine()).trimmed();
+        if (request.isEmpty()) {
+            continue;
+        }
+        const QString response = handleRequest(request);
+        pSocket->write(response.toUtf8() + '\n');
+    }
+    if (pSocket->bytesAvailable() > kMaxRequestLength) {
+        kLogger.warning() << "Closing connection after an overlong request";
+        pSocket->disconnectFromServer();
+    }
+}
+
+QString ControlSocketServer::handleRequest(const QString& request) {
+    const QStringList args = request.split(QChar(' '), Qt::SkipEmptyParts);
+    if (args.isEmpty()) {
+        return errorResponse(QStringLiteral("empty request"));
+    }
+    const QString& command = args.first();
+    if (command == QStringLiteral("get") && args.size() == 2) {
+        const ConfigKey key = ConfigKey::parseCommaSeparated(args[1]);
+        if (!ControlObject::exists(key)) {
+            return errorResponse(QStringLiteral("unknown control: ") + args[1]);
+        }
+        return QString::number(ControlObject::get(key));
+    } else if (command == QStringLiteral("set") && args.size() == 3) {
+        const ConfigKey key = ConfigKey::parseCommaSeparated(args[1]);
+        if (!ControlObject::exists(key)) {
+            return errorResponse(QStringLiteral("unknown control: ") + args[1]);
+        }
+        bool ok = false;
+        const double value = args[2].toDouble(&ok);
+        if (!ok) {
+            return errorResponse(QStringLiteral("invalid value: ") + args[2]);
+        }
+        ControlObject::set(key, value);
+        return QStringLiteral("ok");
+    } else if (command == QStringLiteral("quit") && args.size() == 1) {
+        kLogger.info() << "Quit requested by client";
+        emit quitRequested();
+        return QStringLiteral("ok");
+    }
+    return errorResponse(QStringLiteral("invalid request: ") + request);
+}
+
+} // namespace mixxx
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QLocalServer>
+#include <QObject>
+#include <QString>
+
+class QLocalSocket;
+
+namespace mixxx {
+
+/// Allows local processes to read and write controls through a local socket
+/// (a Unix domain socket or a named pipe on Windows), e.g. to remote control
+/// a headless instance from scripts. The protocol is line based, each
+/// request is answered by exactly one line:
+///
+///   get [Channel1],play        -> 1
+///   set [Channel1],play 0      -> ok
+///   set [Channel1],play x      -> error invalid value: x
+///   quit                       -> ok (and emits quitRequested())
+///
+/// Only the user that runs Mixxx may connect to the socket.
+class ControlSocketServer : public QObject {
+    Q_OBJECT
+  public:
+    explicit ControlSocketServer(QObject* pParent = nullptr);
+    ~ControlSocketServer() override;
+
+    /// Starts listening on the given socket name. A stale socket from
+    /// a previous instance is removed.
+    bool listen(const QString& name);
+
+    QString fullServerName() const {
+        return m_server.fullServerName();
+    }
+
+    /// Processes a single request and returns the response line without
+    /// the trailing newline.
+    QString handleRequest(const QString& request);
+
+  signals:
+    void quitRequested();
+
+  private slots:
+    void slotNewConnection();
+
+  private:
+    void readRequests(QLocalSocket* pSocket);
+
+    QLocalServer m_server;
+};
+
+} // namespace mixxx
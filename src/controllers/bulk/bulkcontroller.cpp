@@ -7,55 +7,23 @@
 #endif
 
 #include "controllers/bulk/bulksupported.h"
+#include "controllers/bulk/bulktransferscheduler.h"
+#include "controllers/bulk/libusbbulktransport.h"
 #include "controllers/defs_controllers.h"
 #include "moc_bulkcontroller.cpp"
 #include "util/cmdlineargs.h"
 #include "util/time.h"
 #include "util/trace.h"
 
-BulkReader::BulkReader(libusb_device_handle *handle, unsigned char in_epaddr)
-        : QThread(),
-          m_phandle(handle),
-          m_stop(0),
-          m_in_epaddr(in_epaddr) {
-}
+namespace {
 
-BulkReader::~BulkReader() {
-}
+// The maximum size of the packets of all supported devices
+constexpr int kInputTransferLength = 255;
 
-void BulkReader::stop() {
-    m_stop = 1;
-}
+// How long closing the device waits for the queued output to be sent
+constexpr int kCloseTimeoutMillis = 1000;
 
-void BulkReader::run() {
-    m_stop = 0;
-    unsigned char data[255];
-
-    while (m_stop.loadAcquire() == 0) {
-        // Blocked polling: The only problem with this is that we can't close
-        // the device until the block is released, which means the controller
-        // has to send more data
-        //result = hid_read_timeout(m_pHidDevice, data, 255, -1);
-
-        // This relieves that at the cost of higher CPU usage since we only
-        // block for a short while (500ms)
-        int transferred;
-        int result;
-
-        result = libusb_bulk_transfer(m_phandle,
-                                      m_in_epaddr,
-                                      data, sizeof(data),
-                                      &transferred, 500);
-        Trace timeout("BulkReader timeout");
-        if (result >= 0) {
-            Trace process("BulkReader process packet");
-            //qDebug() << "Read" << result << "bytes, pointer:" << data;
-            QByteArray byteArray(reinterpret_cast<char*>(data), transferred);
-            emit incomingData(byteArray, mixxx::Time::elapsed());
-        }
-    }
-    qDebug() << "Stopped Reader";
-}
+} // anonymous namespace
 
 #ifndef Q_OS_ANDROID
 static QString get_string(libusb_device_handle* handle, uint8_t id) {
@@ -77,8 +45,7 @@ BulkController::BulkController(libusb_context* context,
           m_context(context),
           m_phandle(handle),
           m_inEndpointAddr(0),
-          m_outEndpointAddr(0),
-          m_pReader(nullptr) {
+          m_outEndpointAddr(0) {
     m_vendorId = desc->idVendor;
     m_productId = desc->idProduct;
 
@@ -98,8 +65,7 @@ BulkController::BulkController(const QJniObject& usbDevice)
           m_phandle(nullptr),
           m_androidUsbDevice(usbDevice),
           m_inEndpointAddr(0),
-          m_outEndpointAddr(0),
-          m_pReader(nullptr) {
+          m_outEndpointAddr(0) {
     m_vendorId = static_cast<unsigned short>(usbDevice.callMethod<jint>("getVendorId"));
     m_productId = static_cast<unsigned short>(usbDevice.callMethod<jint>("getProductId"));
 
@@ -303,25 +269,41 @@ int BulkController::open(const QString& resourcePath) {
         }
     }
 
+#ifdef Q_OS_ANDROID
+    // The device has been wrapped in the default context
+    libusb_context* pTransferContext = nullptr;
+#else
+    libusb_context* pTransferContext = m_context;
+#endif
+    m_pTransport = std::make_unique<LibusbBulkTransport>(pTransferContext,
+            m_phandle,
+            m_inEndpointAddr,
+            m_outEndpointAddr,
+            getName(),
+            m_logBase);
+    m_pTransfers = std::make_unique<BulkTransferScheduler>(m_pTransport.get(), m_logBase);
+
     startEngine();
 
-    if (m_pReader != nullptr) {
-        qCWarning(m_logBase) << "BulkReader already present for" << getName();
-    } else if (m_pMapping &&
+    if (m_pMapping &&
             !(m_pMapping->getDeviceDirection() &
                     LegacyControllerMapping::DeviceDirection::Incoming)) {
         qDebug() << "The mapping for the bulk device" << getName()
-                 << "doesn't require reading the data. Ignoring BulkReader "
-                    "setup.";
-    } else {
-        m_pReader = new BulkReader(m_phandle, m_inEndpointAddr);
-        m_pReader->setObjectName(QString("BulkReader %1").arg(getName()));
-
-        connect(m_pReader, &BulkReader::incomingData, this, &BulkController::receive);
-
-        // Controller input needs to be prioritized since it can affect the
-        // audio directly, like when scratching
-        m_pReader->start(QThread::HighPriority);
+                 << "doesn't require reading the data. Ignoring input "
+                    "transfers setup.";
+    } else if (!m_pTransfers->startInput(kInputTransferLength,
+                       [this](const QByteArray& data) {
+                           // Invoked from the event thread of the transport
+                           Trace process("BulkController process packet");
+                           const mixxx::Duration timestamp = mixxx::Time::elapsed();
+                           QMetaObject::invokeMethod(
+                                   this,
+                                   [this, data, timestamp] {
+                                       receive(data, timestamp);
+                                   },
+                                   Qt::QueuedConnection);
+                       })) {
+        qCWarning(m_logBase) << "Cannot start reading from" << getName();
     }
     applyMapping(resourcePath);
     setOpen(true);
@@ -336,25 +318,24 @@ int BulkController::close() {
 
     qCInfo(m_logBase) << "Shutting down USB Bulk device" << getName();
 
-    // Stop the reading thread
-    if (m_pReader == nullptr &&
-            m_pMapping->getDeviceDirection() &
-                    LegacyControllerMapping::DeviceDirection::Incoming) {
-        qCWarning(m_logBase) << "BulkReader not present for" << getName()
-                             << "yet the device is open!";
-    } else if (m_pReader) {
-        disconnect(m_pReader, &BulkReader::incomingData, this, &BulkController::receive);
-        m_pReader->stop();
-        qCInfo(m_logBase) << "  Waiting on reader to finish";
-        m_pReader->wait();
-        delete m_pReader;
-        m_pReader = nullptr;
+    // Stop delivering input, the transfers are cancelled below after the
+    // final messages of the controller engine have been sent
+    if (m_pTransfers) {
+        m_pTransfers->stopInput();
     }
 
     // Stop controller engine here to ensure it's done before the device is
     // closed in case it has any final parting messages
     stopEngine();
 
+    if (m_pTransfers) {
+        qCInfo(m_logBase) << "  Waiting for the transfers to finish";
+        m_pTransfers->requestShutdown();
+        m_pTransfers->waitForShutdown(kCloseTimeoutMillis);
+        m_pTransfers.reset();
+    }
+    m_pTransport.reset();
+
     // Close device
     if (m_interfaceNumber.has_value()) {
         int error = libusb_release_interface(m_phandle, *m_interfaceNumber);
@@ -395,23 +376,17 @@ bool BulkController::sendBytes(const QByteArray& data) {
         return false;
     }
 
-    int ret;
-    int transferred;
-
-    // XXX: don't get drunk again.
-    ret = libusb_bulk_transfer(m_phandle,
-            m_outEndpointAddr,
-            (unsigned char*)data.constData(),
-            data.size(),
-            &transferred,
-            5000 // Send timeout in milliseconds
-    );
-    if (ret < 0) {
+    VERIFY_OR_DEBUG_ASSERT(m_pTransfers) {
+        return false;
+    }
+    // The data is sent in the background without blocking the controller
+    // thread. Identical data that is still queued is only sent once.
+    if (!m_pTransfers->send(data)) {
         qCWarning(m_logOutput) << "Unable to send data to" << getName()
-                               << "serial #" << m_sUID << "-" << libusb_error_name(ret);
+                               << "serial #" << m_sUID;
         return false;
     } else if (CmdlineArgs::Instance().getControllerDebug()) {
-        qCDebug(m_logOutput) << transferred << "bytes sent to" << getName()
+        qCDebug(m_logOutput) << data.size() << "bytes queued for" << getName()
                              << "serial #" << m_sUID;
     }
     return true;
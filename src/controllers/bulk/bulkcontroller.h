@@ -1,7 +1,6 @@
 #pragma once
 
-#include <QAtomicInt>
-#include <QThread>
+#include <memory>
 #include <optional>
 #ifdef Q_OS_ANDROID
 #include <QJniObject>
@@ -13,27 +12,10 @@
 struct libusb_device_handle;
 struct libusb_context;
 
-/// USB Bulk controller backend
-class BulkReader : public QThread {
-    Q_OBJECT
-  public:
-    BulkReader(libusb_device_handle *handle, unsigned char in_epaddr);
-    virtual ~BulkReader();
-
-    void stop();
-
-  signals:
-    void incomingData(const QByteArray& data, mixxx::Duration timestamp);
-
-  protected:
-    void run();
-
-  private:
-    libusb_device_handle* m_phandle;
-    QAtomicInt m_stop;
-    unsigned char m_in_epaddr;
-};
+class BulkTransferScheduler;
+class BulkTransport;
 
+/// USB Bulk controller backend
 class BulkController : public Controller {
     Q_OBJECT
   public:
@@ -133,6 +115,7 @@ class BulkController : public Controller {
     QString m_product;
 
     QString m_sUID;
-    BulkReader* m_pReader;
+    std::unique_ptr<BulkTransport> m_pTransport;
+    std::unique_ptr<BulkTransferScheduler> m_pTransfers;
     std::unique_ptr<LegacyHidControllerMapping> m_pMapping;
 };
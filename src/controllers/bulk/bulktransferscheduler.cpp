@@ -0,0 +1,289 @@
+#include "controllers/bulk/bulktransferscheduler.h"
+
+#include <QDeadlineTimer>
+#include <QtDebug>
+
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+
+namespace {
+
+constexpr int kDestructionTimeoutMillis = 1000;
+
+const char* statusName(BulkTransport::Status status) {
+    switch (status) {
+    case BulkTransport::Status::Completed:
+        return "completed";
+    case BulkTransport::Status::TimedOut:
+        return "timed out";
+    case BulkTransport::Status::Cancelled:
+        return "cancelled";
+    case BulkTransport::Status::NoDevice:
+        return "no device";
+    case BulkTransport::Status::Stall:
+        return "stall";
+    case BulkTransport::Status::Error:
+        return "error";
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return "unknown";
+}
+
+} // anonymous namespace
+
+BulkTransferScheduler::BulkTransferScheduler(BulkTransport* pTransport,
+        const RuntimeLoggingCategory& logBase)
+        : m_pTransport(pTransport),
+          m_logBase(logBase),
+          m_inputTransferLength(0),
+          m_inputStopped(true),
+          m_inputTransfersInFlight(0),
+          m_inputFailureLogged(false),
+          m_outputTransfersInFlight(0),
+          m_outputOverflowLogged(false),
+          m_shutdownRequested(false),
+          m_cancelled(false),
+          m_deviceLost(false) {
+    DEBUG_ASSERT(m_pTransport);
+}
+
+BulkTransferScheduler::~BulkTransferScheduler() {
+    requestShutdown();
+    if (waitForShutdown(kDestructionTimeoutMillis)) {
+        return;
+    }
+    // The transfers have been cancelled, but the callbacks of those that
+    // are still in flight would access this object after its destruction
+    const auto locked = lockMutex(&m_mutex);
+    DEBUG_ASSERT(m_cancelled);
+    while (!isIdleLocked()) {
+        m_idle.wait(&m_mutex);
+    }
+}
+
+bool BulkTransferScheduler::startInput(int transferLength, InputCallback callback) {
+    DEBUG_ASSERT(transferLength > 0);
+    const auto locked = lockMutex(&m_mutex);
+    VERIFY_OR_DEBUG_ASSERT(m_inputStopped && m_inputTransfersInFlight == 0) {
+        return false;
+    }
+    if (m_shutdownRequested || m_deviceLost) {
+        return false;
+    }
+    m_inputTransferLength = transferLength;
+    m_inputCallback = std::move(callback);
+    m_inputStopped = false;
+    for (int i = 0; i < kInputTransfersInFlight; ++i) {
+        if (!submitInputLocked()) {
+            m_inputStopped = true;
+            return false;
+        }
+    }
+    return true;
+}
+
+void BulkTransferScheduler::stopInput() {
+    const auto locked = lockMutex(&m_mutex);
+    m_inputStopped = true;
+}
+
+bool BulkTransferScheduler::submitInputLocked() {
+    if (!m_pTransport->submitInput(m_inputTransferLength,
+                [this](BulkTransport::Status status, const QByteArray& data) {
+                    onInputCompleted(status, data);
+                })) {
+        qCWarning(m_logBase) << "Failed to submit bulk input transfer";
+        return false;
+    }
+    ++m_inputTransfersInFlight;
+    return true;
+}
+
+void BulkTransferScheduler::onInputCompleted(
+        BulkTransport::Status status, const QByteArray& data) {
+    InputCallback callback;
+    {
+        const auto locked = lockMutex(&m_mutex);
+        DEBUG_ASSERT(m_inputTransfersInFlight > 0);
+        --m_inputTransfersInFlight;
+        if (status == BulkTransport::Status::Completed && !m_inputStopped && !data.isEmpty()) {
+            callback = m_inputCallback;
+        }
+        switch (status) {
+        case BulkTransport::Status::Completed:
+        case BulkTransport::Status::TimedOut:
+            m_inputFailureLogged = false;
+            break;
+        case BulkTransport::Status::Cancelled:
+            break;
+        case BulkTransport::Status::NoDevice:
+            logFailure(status, "input");
+            break;
+        case BulkTransport::Status::Stall:
+        case BulkTransport::Status::Error:
+            // Transient failures don't stop the input, otherwise the
+            // device would become unresponsive after a few of them
+            if (!m_inputFailureLogged) {
+                logFailure(status, "input");
+                m_inputFailureLogged = true;
+            }
+            break;
+        }
+        if (status != BulkTransport::Status::Cancelled &&
+                status != BulkTransport::Status::NoDevice &&
+                !m_inputStopped && !m_cancelled) {
+            submitInputLocked();
+        }
+        if (isIdleLocked()) {
+            m_idle.wakeAll();
+        }
+    }
+    // Invoked without holding the lock, because the callback might send data
+    if (callback) {
+        callback(data);
+    }
+}
+
+bool BulkTransferScheduler::send(const QByteArray& data) {
+    const auto locked = lockMutex(&m_mutex);
+    if (m_shutdownRequested || m_deviceLost) {
+        return false;
+    }
+    if (!m_queuedOutputs.empty() && m_queuedOutputs.back() == data) {
+        // Sending the same data twice in a row would not change anything
+        return true;
+    }
+    if (static_cast<int>(m_queuedOutputs.size()) >= kMaxQueuedOutputs) {
+        if (!m_outputOverflowLogged) {
+            qCWarning(m_logBase) << "The bulk device does not accept data fast enough,"
+                                 << "rejecting data until the queue has been drained";
+            m_outputOverflowLogged = true;
+        }
+        return false;
+    }
+    m_queuedOutputs.push_back(data);
+    submitOutputsLocked();
+    return true;
+}
+
+void BulkTransferScheduler::submitOutputsLocked() {
+    while (m_outputTransfersInFlight < kMaxOutputTransfersInFlight &&
+            !m_queuedOutputs.empty()) {
+        const QByteArray data = std::move(m_queuedOutputs.front());
+        m_queuedOutputs.pop_front();
+        if (!m_pTransport->submitOutput(data,
+                    [this](BulkTransport::Status status, const QByteArray&) {
+                        onOutputCompleted(status);
+                    })) {
+            qCWarning(m_logBase) << "Failed to submit bulk output transfer of"
+                                 << data.size() << "bytes";
+            continue;
+        }
+        ++m_outputTransfersInFlight;
+    }
+    if (m_queuedOutputs.empty()) {
+        m_outputOverflowLogged = false;
+    }
+}
+
+void BulkTransferScheduler::onOutputCompleted(BulkTransport::Status status) {
+    const auto locked = lockMutex(&m_mutex);
+    DEBUG_ASSERT(m_outputTransfersInFlight > 0);
+    --m_outputTransfersInFlight;
+    if (status != BulkTransport::Status::Completed) {
+        logFailure(status, "output");
+    }
+    if (!m_cancelled && !m_deviceLost) {
+        submitOutputsLocked();
+    }
+    cancelIfDrainedLocked();
+    if (isIdleLocked()) {
+        m_idle.wakeAll();
+    }
+}
+
+void BulkTransferScheduler::logFailure(BulkTransport::Status status, const char* direction) {
+    switch (status) {
+    case BulkTransport::Status::Completed:
+    case BulkTransport::Status::Cancelled:
+        return;
+    case BulkTransport::Status::NoDevice:
+        if (!m_deviceLost) {
+            qCWarning(m_logBase) << "The bulk device has been disconnected";
+            m_deviceLost = true;
+        }
+        m_inputStopped = true;
+        m_queuedOutputs.clear();
+        return;
+    case BulkTransport::Status::TimedOut:
+    case BulkTransport::Status::Stall:
+    case BulkTransport::Status::Error:
+        qCWarning(m_logBase) << "Bulk" << direction << "transfer failed:" << statusName(status);
+        return;
+    }
+}
+
+void BulkTransferScheduler::requestShutdown() {
+    const auto locked = lockMutex(&m_mutex);
+    m_shutdownRequested = true;
+    m_inputStopped = true;
+    cancelIfDrainedLocked();
+    if (isIdleLocked()) {
+        m_idle.wakeAll();
+    }
+}
+
+void BulkTransferScheduler::cancelIfDrainedLocked() {
+    if (!m_shutdownRequested || m_cancelled ||
+            !m_queuedOutputs.empty() || m_outputTransfersInFlight > 0) {
+        return;
+    }
+    m_cancelled = true;
+    if (m_inputTransfersInFlight > 0) {
+        m_pTransport->cancelAll();
+    }
+}
+
+bool BulkTransferScheduler::isIdleLocked() const {
+    return m_inputTransfersInFlight == 0 &&
+            m_outputTransfersInFlight == 0 &&
+            m_queuedOutputs.empty();
+}
+
+bool BulkTransferScheduler::waitForShutdown(int timeoutMillis) {
+    const auto locked = lockMutex(&m_mutex);
+    QDeadlineTimer deadline(timeoutMillis);
+    while (!isIdleLocked()) {
+        if (m_idle.wait(&m_mutex, deadline)) {
+            continue;
+        }
+        if (m_cancelled) {
+            qCWarning(m_logBase) << "Timed out waiting for the cancellation of"
+                                 << m_inputTransfersInFlight + m_outputTransfersInFlight
+                                 << "bulk transfers";
+            return false;
+        }
+        qCWarning(m_logBase) << "Timed out sending to the bulk device, discarding"
+                             << m_queuedOutputs.size() << "queued outputs";
+        m_queuedOutputs.clear();
+        m_cancelled = true;
+        m_pTransport->cancelAll();
+        deadline = QDeadlineTimer(timeoutMillis);
+    }
+    return true;
+}
+
+int BulkTransferScheduler::inputTransfersInFlight() const {
+    const auto locked = lockMutex(&m_mutex);
+    return m_inputTransfersInFlight;
+}
+
+int BulkTransferScheduler::outputTransfersInFlight() const {
+    const auto locked = lockMutex(&m_mutex);
+    return m_outputTransfersInFlight;
+}
+
+int BulkTransferScheduler::queuedOutputs() const {
+    const auto locked = lockMutex(&m_mutex);
+    return static_cast<int>(m_queuedOutputs.size());
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QByteArray>
+#include <QMutex>
+#include <QWaitCondition>
+#include <deque>
+#include <functional>
+
+#include "controllers/bulk/bulktransport.h"
+#include "util/runtimeloggingcategory.h"
+
+/// Keeps multiple asynchronous transfers of a USB bulk device in flight.
+///
+/// Input transfers are resubmitted as soon as they complete, so there is
+/// always a transfer ready to receive the next packet from the device and
+/// the received data is delivered without polling.
+///
+/// Failed input transfers are resubmitted unless the device has been
+/// disconnected.
+///
+/// Output data is queued and written in the background without blocking
+/// the caller. Data that is identical to the most recently queued data is
+/// only sent once. Otherwise the order is preserved, e.g. A, B, A is sent
+/// as is, because the devices might interpret the data relative to the
+/// previous data.
+///
+/// All methods are thread-safe.
+class BulkTransferScheduler final {
+  public:
+    using InputCallback = std::function<void(const QByteArray& data)>;
+
+    static constexpr int kInputTransfersInFlight = 4;
+    static constexpr int kMaxOutputTransfersInFlight = 2;
+    /// More data is rejected if a stalled device does not accept the
+    /// queued data. Queued data is never dropped, because it might be
+    /// a delta to the previous data, like the screen updates of the
+    /// Traktor Kontrol S4 MK3.
+    static constexpr int kMaxQueuedOutputs = 64;
+
+    BulkTransferScheduler(BulkTransport* pTransport,
+            const RuntimeLoggingCategory& logBase);
+    /// Cancels all transfers and waits until their callbacks have been
+    /// invoked, because they access this object.
+    ~BulkTransferScheduler();
+
+    /// Submits the input transfers. The callback is invoked from the event
+    /// thread of the transport with the data of each completed transfer.
+    bool startInput(int transferLength, InputCallback callback);
+    /// Stops delivering input and resubmitting input transfers.
+    void stopInput();
+
+    /// Queues the data for sending. Returns false if the data could not be
+    /// queued, e.g. while shutting down or if the queue is full.
+    bool send(const QByteArray& data);
+
+    /// Cancels all transfers as soon as the queued output has been sent.
+    /// No more data is accepted for sending.
+    void requestShutdown();
+    /// Blocks until all transfers have completed or the timeout expired,
+    /// in which case the remaining transfers are cancelled without
+    /// waiting for the queued output. Returns false on timeout.
+    bool waitForShutdown(int timeoutMillis);
+
+    int inputTransfersInFlight() const;
+    int outputTransfersInFlight() const;
+    int queuedOutputs() const;
+
+  private:
+    bool submitInputLocked();
+    void submitOutputsLocked();
+    void cancelIfDrainedLocked();
+    bool isIdleLocked() const;
+
+    void onInputCompleted(BulkTransport::Status status, const QByteArray& data);
+    void onOutputCompleted(BulkTransport::Status status);
+    /// Also handles the disconnection of the device.
+    void logFailure(BulkTransport::Status status, const char* direction);
+
+    BulkTransport* const m_pTransport;
+    const RuntimeLoggingCategory m_logBase;
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_idle;
+
+    int m_inputTransferLength;
+    InputCallback m_inputCallback;
+    bool m_inputStopped;
+    int m_inputTransfersInFlight;
+    /// Only the first of consecutive input failures is logged.
+    bool m_inputFailureLogged;
+
+    std::deque<QByteArray> m_queuedOutputs;
+    int m_outputTransfersInFlight;
+    bool m_outputOverflowLogged;
+
+    bool m_shutdownRequested;
+    bool m_cancelled;
+    bool m_deviceLost;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QByteArray>
+#include <functional>
+
+/// Asynchronous transfers to and from the endpoints of a USB bulk device.
+///
+/// Transfers complete in the background and report their result through
+/// a callback, which is invoked from an internal event thread. A callback
+/// is never invoked from within one of the methods of this interface, so
+/// callers may hold a lock while submitting or cancelling transfers that is
+/// also locked by the callback.
+class BulkTransport {
+  public:
+    enum class Status {
+        Completed,
+        TimedOut,
+        Cancelled,
+        /// The device has been disconnected
+        NoDevice,
+        /// The endpoint has been halted. The halt has been cleared before
+        /// the callback is invoked, so transfers can be submitted again.
+        Stall,
+        Error,
+    };
+
+    /// Receives the status and, for input transfers, the received data.
+    using Callback = std::function<void(Status status, const QByteArray& data)>;
+
+    virtual ~BulkTransport() = default;
+
+    /// Reads up to length bytes from the input endpoint. Returns false if
+    /// the transfer could not be submitted, in which case the callback is
+    /// never invoked.
+    virtual bool submitInput(int length, Callback callback) = 0;
+    /// Writes the data to the output endpoint. Returns false if the transfer
+    /// could not be submitted, in which case the callback is never invoked.
+    virtual bool submitOutput(const QByteArray& data, Callback callback) = 0;
+
+    /// Requests the cancellation of all submitted transfers. The callbacks
+    /// of cancelled transfers are invoked with Status::Cancelled.
+    virtual void cancelAll() = 0;
+};
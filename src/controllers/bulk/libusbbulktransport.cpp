@@ -0,0 +1,226 @@
+#include "controllers/bulk/libusbbulktransport.h"
+
+#include <QAtomicInt>
+#include <QDeadlineTimer>
+#include <QThread>
+#include <QtDebug>
+
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+
+namespace {
+
+// The same timeout as for the former blocking writes
+constexpr unsigned int kOutputTimeoutMillis = 5000;
+
+// Input transfers wait for the device as long as they are not cancelled
+constexpr unsigned int kInputTimeoutMillis = 0;
+
+// How often the event thread checks if it should stop
+constexpr int kEventTimeoutMicros = 100 * 1000;
+
+// After this timeout a warning is logged while waiting for the
+// cancellation of the transfers
+constexpr int kCancellationTimeoutMillis = 1000;
+
+BulkTransport::Status statusFromLibusb(libusb_transfer_status status) {
+    switch (status) {
+    case LIBUSB_TRANSFER_COMPLETED:
+        return BulkTransport::Status::Completed;
+    case LIBUSB_TRANSFER_TIMED_OUT:
+        return BulkTransport::Status::TimedOut;
+    case LIBUSB_TRANSFER_CANCELLED:
+        return BulkTransport::Status::Cancelled;
+    case LIBUSB_TRANSFER_NO_DEVICE:
+        return BulkTransport::Status::NoDevice;
+    case LIBUSB_TRANSFER_STALL:
+        return BulkTransport::Status::Stall;
+    case LIBUSB_TRANSFER_ERROR:
+    case LIBUSB_TRANSFER_OVERFLOW:
+        break;
+    }
+    return BulkTransport::Status::Error;
+}
+
+} // anonymous namespace
+
+class LibusbBulkTransport::EventThread : public QThread {
+  public:
+    EventThread(libusb_context* pContext, LibusbBulkTransport* pTransport)
+            : m_pContext(pContext),
+              m_pTransport(pTransport),
+              m_stop(0) {
+    }
+
+    void stop() {
+        m_stop = 1;
+    }
+
+  protected:
+    void run() override {
+        while (m_stop.loadAcquire() == 0) {
+            timeval timeout{0, kEventTimeoutMicros};
+            libusb_handle_events_timeout_completed(m_pContext, &timeout, nullptr);
+            m_pTransport->clearStalledEndpoints();
+        }
+    }
+
+  private:
+    libusb_context* const m_pContext;
+    LibusbBulkTransport* const m_pTransport;
+    QAtomicInt m_stop;
+};
+
+LibusbBulkTransport::LibusbBulkTransport(libusb_context* pContext,
+        libusb_device_handle* pHandle,
+        unsigned char inEndpointAddr,
+        unsigned char outEndpointAddr,
+        const QString& name,
+        const RuntimeLoggingCategory& logBase)
+        : m_pHandle(pHandle),
+          m_inEndpointAddr(inEndpointAddr),
+          m_outEndpointAddr(outEndpointAddr),
+          m_logBase(logBase),
+          m_pEventThread(std::make_unique<EventThread>(pContext, this)) {
+    DEBUG_ASSERT(m_pHandle);
+    m_pEventThread->setObjectName(QStringLiteral("BulkTransport %1").arg(name));
+    // Controller input needs to be prioritized since it can affect the
+    // audio directly, like when scratching
+    m_pEventThread->start(QThread::HighPriority);
+}
+
+LibusbBulkTransport::~LibusbBulkTransport() {
+    cancelAll();
+    {
+        // Neither the transfers nor this object, which is accessed by
+        // their callbacks, may be freed while they are still submitted
+        const auto locked = lockMutex(&m_mutex);
+        bool timedOut = false;
+        while (!m_transfers.empty()) {
+            if (!m_idle.wait(&m_mutex, QDeadlineTimer(kCancellationTimeoutMillis)) &&
+                    !timedOut) {
+                qCWarning(m_logBase) << "Still waiting for the cancellation of"
+                                     << m_transfers.size() << "bulk transfers";
+                timedOut = true;
+            }
+        }
+    }
+    m_pEventThread->stop();
+    m_pEventThread->wait();
+}
+
+bool LibusbBulkTransport::submitInput(int length, Callback callback) {
+    VERIFY_OR_DEBUG_ASSERT(length > 0) {
+        return false;
+    }
+    return submit(m_inEndpointAddr,
+            QByteArray(length, '\0'),
+            true,
+            kInputTimeoutMillis,
+            std::move(callback));
+}
+
+bool LibusbBulkTransport::submitOutput(const QByteArray& data, Callback callback) {
+    return submit(m_outEndpointAddr,
+            data,
+            false,
+            kOutputTimeoutMillis,
+            std::move(callback));
+}
+
+bool LibusbBulkTransport::submit(unsigned char endpointAddr,
+        QByteArray buffer,
+        bool isInput,
+        unsigned int timeoutMillis,
+        Callback callback) {
+    libusb_transfer* pTransfer = libusb_alloc_transfer(0);
+    VERIFY_OR_DEBUG_ASSERT(pTransfer) {
+        return false;
+    }
+    auto* pUserData = new Transfer{this, std::move(callback), std::move(buffer), isInput};
+    libusb_fill_bulk_transfer(pTransfer,
+            m_pHandle,
+            endpointAddr,
+            // Output buffers are only read by libusb, so they aren't detached
+            isInput ? reinterpret_cast<unsigned char*>(pUserData->buffer.data())
+                    : reinterpret_cast<unsigned char*>(
+                              const_cast<char*>(pUserData->buffer.constData())),
+            pUserData->buffer.size(),
+            &LibusbBulkTransport::onTransferCompleted,
+            pUserData,
+            timeoutMillis);
+
+    const auto locked = lockMutex(&m_mutex);
+    const int error = libusb_submit_transfer(pTransfer);
+    if (error < 0) {
+        qCWarning(m_logBase) << "Cannot submit bulk transfer:" << libusb_error_name(error);
+        delete pUserData;
+        libusb_free_transfer(pTransfer);
+        return false;
+    }
+    m_transfers.insert(pTransfer);
+    return true;
+}
+
+void LibusbBulkTransport::cancelAll() {
+    const auto locked = lockMutex(&m_mutex);
+    for (libusb_transfer* pTransfer : m_transfers) {
+        // Fails for transfers that have already completed, but whose
+        // callback has not been invoked yet
+        libusb_cancel_transfer(pTransfer);
+    }
+}
+
+// static
+void LIBUSB_CALL LibusbBulkTransport::onTransferCompleted(libusb_transfer* pTransfer) {
+    auto* pUserData = static_cast<Transfer*>(pTransfer->user_data);
+    LibusbBulkTransport* pTransport = pUserData->pTransport;
+    if (pTransfer->status == LIBUSB_TRANSFER_STALL) {
+        // The halt is cleared by the event thread after the events have
+        // been handled, because synchronous requests would fail here
+        const auto locked = lockMutex(&pTransport->m_mutex);
+        pTransport->m_stalledTransfers.push_back(pTransfer);
+        return;
+    }
+    pTransport->finishTransfer(pTransfer, statusFromLibusb(pTransfer->status));
+}
+
+void LibusbBulkTransport::clearStalledEndpoints() {
+    std::vector<libusb_transfer*> stalledTransfers;
+    {
+        const auto locked = lockMutex(&m_mutex);
+        stalledTransfers.swap(m_stalledTransfers);
+    }
+    std::unordered_set<unsigned char> clearedEndpoints;
+    for (libusb_transfer* pTransfer : stalledTransfers) {
+        if (clearedEndpoints.insert(pTransfer->endpoint).second) {
+            const int error = libusb_clear_halt(m_pHandle, pTransfer->endpoint);
+            if (error < 0) {
+                qCWarning(m_logBase) << "Cannot clear the halt of bulk endpoint"
+                                     << static_cast<int>(pTransfer->endpoint) << ":"
+                                     << libusb_error_name(error);
+            }
+        }
+        finishTransfer(pTransfer, Status::Stall);
+    }
+}
+
+void LibusbBulkTransport::finishTransfer(libusb_transfer* pTransfer, Status status) {
+    auto* pUserData = static_cast<Transfer*>(pTransfer->user_data);
+    if (pUserData->isInput) {
+        pUserData->buffer.truncate(pTransfer->actual_length);
+    } else {
+        pUserData->buffer.clear();
+    }
+    pUserData->callback(status, pUserData->buffer);
+    delete pUserData;
+
+    // Only forget the transfer after the callback has been invoked, so the
+    // transport is not destroyed before
+    const auto locked = lockMutex(&m_mutex);
+    m_transfers.erase(pTransfer);
+    libusb_free_transfer(pTransfer);
+    if (m_transfers.empty()) {
+        m_idle.wakeAll();
+    }
+}
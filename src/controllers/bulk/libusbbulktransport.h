@@ -0,0 +1,71 @@
+#pragma once
+
+#include <libusb.h>
+
+#include <QMutex>
+#include <QWaitCondition>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "controllers/bulk/bulktransport.h"
+#include "util/runtimeloggingcategory.h"
+
+/// Asynchronous bulk transfers with libusb.
+///
+/// The completion callbacks are invoked from a dedicated thread that
+/// handles the libusb events of the context. The halt of a stalled endpoint
+/// is cleared on that thread before the callback of the stalled transfer is
+/// invoked, because synchronous requests can't be made from a callback.
+class LibusbBulkTransport final : public BulkTransport {
+  public:
+    LibusbBulkTransport(libusb_context* pContext,
+            libusb_device_handle* pHandle,
+            unsigned char inEndpointAddr,
+            unsigned char outEndpointAddr,
+            const QString& name,
+            const RuntimeLoggingCategory& logBase);
+    /// Cancels all transfers and waits until their callbacks have been
+    /// invoked, however long it takes.
+    ~LibusbBulkTransport() override;
+
+    bool submitInput(int length, Callback callback) override;
+    bool submitOutput(const QByteArray& data, Callback callback) override;
+    void cancelAll() override;
+
+  private:
+    class EventThread;
+
+    struct Transfer {
+        LibusbBulkTransport* pTransport;
+        Callback callback;
+        /// Owns the memory that libusb reads from or writes to.
+        QByteArray buffer;
+        bool isInput;
+    };
+
+    bool submit(unsigned char endpointAddr,
+            QByteArray buffer,
+            bool isInput,
+            unsigned int timeoutMillis,
+            Callback callback);
+
+    static void LIBUSB_CALL onTransferCompleted(libusb_transfer* pTransfer);
+    void finishTransfer(libusb_transfer* pTransfer, Status status);
+    /// Invoked from the event thread outside of the libusb callbacks.
+    void clearStalledEndpoints();
+
+    libusb_device_handle* const m_pHandle;
+    const unsigned char m_inEndpointAddr;
+    const unsigned char m_outEndpointAddr;
+    const RuntimeLoggingCategory m_logBase;
+
+    QMutex m_mutex;
+    QWaitCondition m_idle;
+    std::unordered_set<libusb_transfer*> m_transfers;
+    /// Completed transfers whose callback is deferred until the halt of
+    /// their endpoint has been cleared.
+    std::vector<libusb_transfer*> m_stalledTransfers;
+
+    std::unique_ptr<EventThread> m_pEventThread;
+};
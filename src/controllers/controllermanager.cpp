@@ -8,11 +8,13 @@
 #include "controllers/controllermappinginfoenumerator.h"
 #include "controllers/defs_controllers.h"
 #include "controllers/legacycontrollermappingfilehandler.h"
+#include "controllers/midi/midicontroller.h"
 #include "moc_controllermanager.cpp"
 #include "preferences/usersettings.h"
 #include "util/cmdlineargs.h"
 #include "util/compatibility/qmutex.h"
 #include "util/duration.h"
+#include "util/realtimethreads.h"
 #include "util/thread_affinity.h"
 #include "util/time.h"
 
@@ -71,6 +73,20 @@ QFileInfo findMappingFile(const QString& pathOrFilename, const QStringList& path
 // kept for backwards compatibility.
 const QString kSettingsGroup = QLatin1String("[ControllerPreset]");
 
+/// The maximum number of bytes per second of short MIDI messages for each
+/// device, e.g. 3125 for a classic MIDI DIN connection. Unlimited if unset.
+const QString kOutputBandwidthGroup = QLatin1String("[ControllerOutputBandwidth]");
+
+void configureOutputBandwidth(Controller* pController, const UserSettingsPointer& pConfig) {
+    auto* pMidiController = qobject_cast<MidiController*>(pController);
+    if (!pMidiController) {
+        return;
+    }
+    pMidiController->setOutputBytesPerSecond(pConfig->getValue(
+            ConfigKey(kOutputBandwidthGroup, sanitizeDeviceName(pController->getName())),
+            0));
+}
+
 } // anonymous namespace
 
 QString firstAvailableFilename(QSet<QString>& filenames,
@@ -146,6 +162,8 @@ ControllerLearningEventFilter* ControllerManager::getControllerLearningEventFilt
 
 void ControllerManager::slotInitialize() {
     qDebug() << "ControllerManager:slotInitialize";
+    mixxx::RealtimeThreads::applyToCurrentThread(
+            mixxx::RealtimeThreads::ThreadClass::Controller);
 
     // Initialize mapping info parsers. This object is only for use in the main
     // thread. Do not touch it from within ControllerManager.
@@ -300,6 +318,7 @@ void ControllerManager::slotSetUpDevices() {
 
         qDebug() << "Opening controller:" << name;
 
+        configureOutputBandwidth(pController, m_pConfig);
         int value = pController->open(m_pConfig->getResourcePath());
         if (value != 0) {
             qWarning() << "There was a problem opening" << name;
@@ -391,6 +410,7 @@ void ControllerManager::openController(Controller* pController) {
     if (pController->isOpen()) {
         pController->close();
     }
+    configureOutputBandwidth(pController, m_pConfig);
     int result = pController->open(m_pConfig->getResourcePath());
     pollIfAnyControllersOpen();
 
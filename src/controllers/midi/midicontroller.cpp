@@ -13,8 +13,11 @@
 #include "errordialoghandler.h"
 #include "mixer/playermanager.h"
 #include "moc_midicontroller.cpp"
+#include "util/inputeventtime.h"
 #include "util/make_const_iterator.h"
 #include "util/math.h"
+#include "util/time.h"
+#include "util/tracerecorder.h"
 
 const QString kMakeInputHandlerError = QStringLiteral(
         "Invalid timer callback provided to midi.makeInputHandler. "
@@ -33,7 +36,12 @@ bool MidiInputHandleJSProxy::disconnect() {
 }
 
 MidiController::MidiController(const QString& deviceName)
-        : Controller(deviceName) {
+        : Controller(deviceName),
+          m_outputTimer(this) {
+    m_outputTimer.setSingleShot(true);
+    // Short messages are coalesced and sent in frames
+    m_outputTimer.setInterval(MidiOutputScheduler::kFrameMillis);
+    connect(&m_outputTimer, &QTimer::timeout, this, &MidiController::slotSendOutputFrame);
 }
 
 void MidiController::slotBeforeEngineShutdown() {
@@ -92,9 +100,72 @@ QList<LegacyControllerMapping::ScreenInfo> MidiController::getMappingInfoScreens
 
 int MidiController::close() {
     destroyOutputHandlers();
+    // Send the messages from the shutdown of the scripts while
+    // the device is still open
+    flushShortMsgs();
+    m_outputScheduler.clear();
     return 0;
 }
 
+void MidiController::setOutputBytesPerSecond(int bytesPerSecond) {
+    m_outputScheduler.setBytesPerSecond(bytesPerSecond);
+}
+
+void MidiController::queueShortMsg(unsigned char status,
+        unsigned char byte1,
+        unsigned char byte2) {
+    if (MidiUtils::opCodeFromStatus(status) >= MidiOpCode::SystemExclusive) {
+        // System messages are not scheduled
+        flushShortMsgs();
+        sendShortMsg(status, byte1, byte2);
+        return;
+    }
+    if (m_outputScheduler.queue(status, byte1, byte2) && !m_outputTimer.isActive()) {
+        m_outputTimer.start();
+    }
+}
+
+void MidiController::queuePassThroughShortMsg(unsigned char status,
+        unsigned char byte1,
+        unsigned char byte2) {
+    if (MidiUtils::opCodeFromStatus(status) >= MidiOpCode::SystemExclusive) {
+        // System messages are not scheduled
+        flushShortMsgs();
+        sendShortMsg(status, byte1, byte2);
+        return;
+    }
+    m_outputScheduler.queuePassThrough(status, byte1, byte2);
+    if (!m_outputTimer.isActive()) {
+        m_outputTimer.start();
+    }
+}
+
+void MidiController::flushShortMsgs() {
+    m_outputTimer.stop();
+    m_outputScheduler.flushAll(
+            [this](unsigned char status, unsigned char byte1, unsigned char byte2) {
+                sendShortMsg(status, byte1, byte2);
+            });
+}
+
+void MidiController::slotSendOutputFrame() {
+    m_outputScheduler.flush(mixxx::Time::elapsed(),
+            [this](unsigned char status, unsigned char byte1, unsigned char byte2) {
+                sendShortMsg(status, byte1, byte2);
+            });
+    if (m_outputScheduler.hasPendingMessages()) {
+        // The bandwidth budget has been exhausted
+        m_outputTimer.start();
+    }
+}
+
+void MidiController::send(const QList<int>& data, unsigned int length) {
+    flushShortMsgs();
+    Controller::send(data, length);
+    // The message might have changed the state of the device
+    m_outputScheduler.resetSentValues();
+}
+
 bool MidiController::matchMapping(const MappingInfo& mapping) {
     // Product info mapping not implemented for MIDI devices yet
     Q_UNUSED(mapping);
@@ -274,6 +345,10 @@ void MidiController::receivedShortMessage(unsigned char status,
         unsigned char control,
         unsigned char value,
         mixxx::Duration timestamp) {
+    mixxx::ScopedTraceEvent trace("controller", "MidiController::receivedShortMessage");
+    // The backends use different clocks for the timestamp, so the time when
+    // the message is polled is used for rendering it in the engine
+    const mixxx::ScopedInputEventTime eventTime(mixxx::Time::elapsed());
     // The rest of this function is for legacy mappings
     unsigned char channel = MidiUtils::channelFromStatus(status);
     MidiOpCode opCode = MidiUtils::opCodeFromStatus(status);
@@ -594,6 +669,8 @@ double MidiController::computeValue(
 }
 
 void MidiController::receive(const QByteArray& data, mixxx::Duration timestamp) {
+    mixxx::ScopedTraceEvent trace("controller", "MidiController::receive");
+    const mixxx::ScopedInputEventTime eventTime(mixxx::Time::elapsed());
     qCDebug(m_logInput) << QStringLiteral("incoming: ")
                         << MidiUtils::formatSysexMessage(
                                    getName(), data, timestamp);
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <QJSValue>
+#include <QTimer>
 
 #include "controllers/controller.h"
 #include "controllers/midi/legacymidicontrollermapping.h"
 #include "controllers/midi/midimessage.h"
+#include "controllers/midi/midioutputscheduler.h"
 #include "controllers/softtakeover.h"
 
 class MidiOutputHandler;
@@ -62,6 +64,10 @@ class MidiController : public Controller {
     bool matchMapping(const MappingInfo& mapping) override;
     bool removeInputMapping(uint16_t key, const MidiInputMapping& mapping);
 
+    /// Limits the bandwidth of the short messages that are sent to the
+    /// device. 0 is unlimited.
+    void setOutputBytesPerSecond(int bytesPerSecond);
+
   signals:
     void messageReceived(unsigned char status, unsigned char control, unsigned char value);
 
@@ -70,6 +76,24 @@ class MidiController : public Controller {
             unsigned char byte1,
             unsigned char byte2) = 0;
 
+    /// Schedules a short message of an output mapping for sending with the
+    /// next output frame. Redundant messages are dropped and multiple
+    /// changes of the same control are coalesced, see MidiOutputScheduler.
+    void queueShortMsg(unsigned char status,
+            unsigned char byte1,
+            unsigned char byte2);
+    /// Schedules a short message of a script for sending with the next
+    /// output frame. It is sent unchanged and in order.
+    void queuePassThroughShortMsg(unsigned char status,
+            unsigned char byte1,
+            unsigned char byte2);
+    /// Sends all queued short messages immediately.
+    void flushShortMsgs();
+
+    /// Sends all queued short messages before the raw data to
+    /// preserve the order.
+    void send(const QList<int>& data, unsigned int length = 0) override;
+
     /// Alias for send()
     /// The length parameter is here for backwards compatibility for when scripts
     /// were required to specify it.
@@ -96,6 +120,7 @@ class MidiController : public Controller {
     void slotBeforeEngineShutdown() override;
 
   private slots:
+    void slotSendOutputFrame();
     void learnTemporaryInputMappings(const MidiInputMappings& mappings);
     void clearTemporaryInputMappings();
     void commitTemporaryInputMappings();
@@ -123,6 +148,9 @@ class MidiController : public Controller {
     SoftTakeoverCtrl m_st;
     QList<QPair<MidiInputMapping, unsigned char>> m_fourteen_bit_queued_mappings;
 
+    MidiOutputScheduler m_outputScheduler;
+    QTimer m_outputTimer;
+
     // So it can access sendShortMsg()
     friend class MidiOutputHandler;
     friend class MidiControllerTest;
@@ -143,7 +171,7 @@ class MidiControllerJSProxy : public ControllerJSProxy {
     Q_INVOKABLE void sendShortMsg(unsigned char status,
             unsigned char byte1,
             unsigned char byte2) {
-        m_pMidiController->sendShortMsg(status, byte1, byte2);
+        m_pMidiController->queuePassThroughShortMsg(status, byte1, byte2);
     }
 
     Q_INVOKABLE void sendSysexMsg(const QList<int>& data, unsigned int length = 0) {
@@ -50,8 +50,9 @@ void MidiOutputHandler::controlChanged(double value) {
         qCDebug(m_logger) << "sending MIDI bytes:" << m_mapping.output.status
                           << "," << m_mapping.output.control << ","
                           << byte3;
-        m_pController->sendShortMsg(m_mapping.output.status,
-                                    m_mapping.output.control, byte3);
+        m_pController->queueShortMsg(m_mapping.output.status,
+                m_mapping.output.control,
+                byte3);
         m_lastVal = static_cast<int>(byte3);
     }
 }
@@ -0,0 +1,179 @@
+#include "controllers/midi/midioutputscheduler.h"
+
+#include <algorithm>
+
+#include "controllers/midi/midiutils.h"
+#include "util/assert.h"
+#include "util/time.h"
+
+namespace {
+
+// The budget that may be saved up while idle, i.e. the size of a burst
+constexpr double kMaxBurstSeconds = 0.05;
+
+// Not a valid data byte, used for messages without a control number
+constexpr quint16 kNoControl = 0xFF;
+
+bool isChannelMessage(unsigned char status) {
+    return status >= 0x80 && status < 0xF0;
+}
+
+quint16 slotKey(unsigned char status, unsigned char byte1) {
+    const MidiOpCode opCode = MidiUtils::opCodeFromStatus(status);
+    const unsigned char channel = MidiUtils::channelFromStatus(status);
+    switch (opCode) {
+    case MidiOpCode::NoteOff:
+    case MidiOpCode::NoteOn:
+        // Both address the same note, e.g. an LED
+        return static_cast<quint16>(
+                       MidiUtils::statusFromOpCodeAndChannel(MidiOpCode::NoteOn, channel))
+                << 8 |
+                byte1;
+    case MidiOpCode::PolyphonicKeyPressure:
+    case MidiOpCode::ControlChange:
+        return static_cast<quint16>(status) << 8 | byte1;
+    default:
+        // The first data byte is part of the value
+        return static_cast<quint16>(status) << 8 | kNoControl;
+    }
+}
+
+} // anonymous namespace
+
+MidiOutputScheduler::MidiOutputScheduler(int bytesPerSecond)
+        : m_bytesPerSecond(0),
+          m_availableBytes(0) {
+    setBytesPerSecond(bytesPerSecond);
+}
+
+void MidiOutputScheduler::setBytesPerSecond(int bytesPerSecond) {
+    m_bytesPerSecond = std::max(bytesPerSecond, 0);
+    m_availableBytes = kBytesPerMessage;
+}
+
+bool MidiOutputScheduler::queue(
+        unsigned char status, unsigned char byte1, unsigned char byte2) {
+    if (!isChannelMessage(status)) {
+        queuePassThrough(status, byte1, byte2);
+        return true;
+    }
+    const Message message{status, byte1, byte2};
+    const quint16 key = slotKey(status, byte1);
+    Slot& slot = m_slots[key];
+    const qint64 frame = mixxx::Time::elapsed().toIntegerMillis() / kFrameMillis;
+    if (slot.updatedInFrame != frame) {
+        slot.isContinuous = slot.updatedInFrame >= 0 && slot.updatedInFrame + 1 == frame;
+        slot.updatedInFrame = frame;
+    }
+    if (slot.hasBeenSent && slot.sent == message) {
+        if (slot.isPending) {
+            // A change that has been reverted before it has been sent
+            slot.isPending = false;
+            m_pendingKeys.erase(
+                    std::find(m_pendingKeys.begin(), m_pendingKeys.end(), key));
+        }
+        return false;
+    }
+    slot.pending = message;
+    if (!slot.isPending) {
+        slot.isPending = true;
+        m_pendingKeys.push_back(key);
+    }
+    return true;
+}
+
+void MidiOutputScheduler::queuePassThrough(
+        unsigned char status, unsigned char byte1, unsigned char byte2) {
+    if (isChannelMessage(status)) {
+        const quint16 key = slotKey(status, byte1);
+        const auto it = m_slots.find(key);
+        if (it != m_slots.end()) {
+            // The state of the control on the device is no longer known
+            it->hasBeenSent = false;
+            if (it->isPending) {
+                it->isPending = false;
+                m_pendingKeys.erase(
+                        std::find(m_pendingKeys.begin(), m_pendingKeys.end(), key));
+            }
+        }
+    }
+    m_passThroughMessages.push_back(Message{status, byte1, byte2});
+}
+
+void MidiOutputScheduler::sendSlot(Slot* pSlot, const Sender& send) {
+    DEBUG_ASSERT(pSlot->isPending);
+    send(pSlot->pending.status, pSlot->pending.byte1, pSlot->pending.byte2);
+    pSlot->sent = pSlot->pending;
+    pSlot->hasBeenSent = true;
+    pSlot->isPending = false;
+}
+
+void MidiOutputScheduler::sendPassThroughMessages(const Sender& send) {
+    for (const auto& message : m_passThroughMessages) {
+        send(message.status, message.byte1, message.byte2);
+    }
+    m_passThroughMessages.clear();
+}
+
+void MidiOutputScheduler::flush(mixxx::Duration now, const Sender& send) {
+    if (m_bytesPerSecond <= 0) {
+        flushAll(send);
+        m_lastFlush = now;
+        return;
+    }
+
+    const double maxAvailableBytes = std::max(
+            m_bytesPerSecond * kMaxBurstSeconds, static_cast<double>(kBytesPerMessage));
+    m_availableBytes = std::min(maxAvailableBytes,
+            m_availableBytes + (now - m_lastFlush).toDoubleSeconds() * m_bytesPerSecond);
+    m_lastFlush = now;
+
+    // Passed through regardless of the budget, but accounted for
+    m_availableBytes -= static_cast<double>(
+            m_passThroughMessages.size() * kBytesPerMessage);
+    sendPassThroughMessages(send);
+
+    // Continuously updated controls are sent last
+    for (const bool continuous : {false, true}) {
+        for (const quint16 key : m_pendingKeys) {
+            if (m_availableBytes < kBytesPerMessage) {
+                break;
+            }
+            Slot& slot = m_slots[key];
+            if (!slot.isPending) {
+                continue;
+            }
+            if (slot.isContinuous != continuous) {
+                continue;
+            }
+            sendSlot(&slot, send);
+            m_availableBytes -= kBytesPerMessage;
+        }
+    }
+    m_pendingKeys.erase(std::remove_if(m_pendingKeys.begin(),
+                                m_pendingKeys.end(),
+                                [this](quint16 key) {
+                                    return !m_slots[key].isPending;
+                                }),
+            m_pendingKeys.end());
+}
+
+void MidiOutputScheduler::flushAll(const Sender& send) {
+    sendPassThroughMessages(send);
+    for (const quint16 key : m_pendingKeys) {
+        sendSlot(&m_slots[key], send);
+    }
+    m_pendingKeys.clear();
+}
+
+void MidiOutputScheduler::resetSentValues() {
+    for (auto& slot : m_slots) {
+        slot.hasBeenSent = false;
+    }
+}
+
+void MidiOutputScheduler::clear() {
+    m_slots.clear();
+    m_pendingKeys.clear();
+    m_passThroughMessages.clear();
+}
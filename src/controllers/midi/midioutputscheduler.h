@@ -0,0 +1,115 @@
+#pragma once
+
+#include <QHash>
+#include <functional>
+#include <vector>
+
+#include "util/duration.h"
+
+/// Schedules the short messages that are sent to a MIDI controller.
+///
+/// For the messages of output mappings only the latest value per
+/// (status, control) is kept until the next flush, so fast changing
+/// controls like VU meters are coalesced into a single message per frame.
+/// Messages that would not change the state of the device, because the
+/// same value has already been sent, are dropped.
+///
+/// The messages of scripts are passed through unchanged and in order with
+/// the next flush, because scripts may deliberately repeat them, e.g. to
+/// request the values of all controls, or send multi-message sequences
+/// like NRPN.
+///
+/// The number of bytes per second can be limited for slow devices. If the
+/// budget does not suffice to send all pending messages, messages of
+/// controls that have not been updated in the previous frame are
+/// preferred. This gives priority to feedback for user actions like button
+/// presses over continuously updated meters. Delayed messages stay pending
+/// and are coalesced with later updates.
+///
+/// Whether a control is updated continuously is determined by the time of
+/// the updates, i.e. by the frames of kFrameMillis they fall into.
+///
+/// System messages should be sent directly after flushing all pending
+/// messages. Messages without a channel status byte can't be coalesced and
+/// are always passed through.
+class MidiOutputScheduler final {
+  public:
+    using Sender = std::function<void(
+            unsigned char status, unsigned char byte1, unsigned char byte2)>;
+
+    static constexpr int kBytesPerMessage = 3;
+    /// The length of a frame in which updates are coalesced.
+    static constexpr int kFrameMillis = 10;
+
+    /// A budget of 0 bytes per second is unlimited.
+    explicit MidiOutputScheduler(int bytesPerSecond = 0);
+
+    int bytesPerSecond() const {
+        return m_bytesPerSecond;
+    }
+    void setBytesPerSecond(int bytesPerSecond);
+
+    /// Queues the message until the next flush. Returns false if the
+    /// message has been dropped, because it is redundant. The current frame
+    /// is derived from mixxx::Time::elapsed().
+    bool queue(unsigned char status, unsigned char byte1, unsigned char byte2);
+    /// Queues the message until the next flush without coalescing or
+    /// dropping it. A pending message of the same control that has been
+    /// queued before is discarded, because it would overwrite this one.
+    void queuePassThrough(unsigned char status, unsigned char byte1, unsigned char byte2);
+
+    /// Sends as many pending messages as the budget allows at this time.
+    void flush(mixxx::Duration now, const Sender& send);
+    /// Sends all pending messages regardless of the budget, e.g. before
+    /// a system exclusive message that must not overtake them.
+    void flushAll(const Sender& send);
+
+    /// Forgets which values have been sent, e.g. when the state of the
+    /// device is unknown after opening it or after sending a system
+    /// exclusive message.
+    void resetSentValues();
+    /// Discards all pending messages and forgets which values have been sent.
+    void clear();
+
+    bool hasPendingMessages() const {
+        return !m_pendingKeys.empty() || !m_passThroughMessages.empty();
+    }
+    int pendingMessageCount() const {
+        return static_cast<int>(m_pendingKeys.size() + m_passThroughMessages.size());
+    }
+
+  private:
+    struct Message {
+        unsigned char status = 0;
+        unsigned char byte1 = 0;
+        unsigned char byte2 = 0;
+
+        bool operator==(const Message& other) const {
+            return status == other.status && byte1 == other.byte1 && byte2 == other.byte2;
+        }
+    };
+
+    struct Slot {
+        Message pending;
+        Message sent;
+        bool isPending = false;
+        bool hasBeenSent = false;
+        /// Updated in consecutive frames, i.e. most likely a meter.
+        bool isContinuous = false;
+        /// The frame of the last update or -1 if it has never been updated.
+        qint64 updatedInFrame = -1;
+    };
+
+    void sendSlot(Slot* pSlot, const Sender& send);
+    void sendPassThroughMessages(const Sender& send);
+
+    int m_bytesPerSecond;
+    double m_availableBytes;
+    mixxx::Duration m_lastFlush;
+
+    QHash<quint16, Slot> m_slots;
+    /// The keys of the pending slots in the order they have been queued.
+    std::vector<quint16> m_pendingKeys;
+    /// The passed through messages in the order they have been queued.
+    std::vector<Message> m_passThroughMessages;
+};
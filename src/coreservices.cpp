@@ -48,15 +48,20 @@
 #include "qml/qmlpreferencesproxy.h"
 #include "qml/qmlsoundmanagerproxy.h"
 #endif
+#include "soundio/qualitygovernor.h"
 #include "soundio/soundmanager.h"
 #include "sources/soundsourceproxy.h"
+#include "track/globaltrackcache.h"
 #include "util/clipboard.h"
 #include "util/db/dbconnectionpooled.h"
 #include "util/font.h"
 #include "util/logger.h"
+#include "util/memoryusagereporter.h"
+#include "util/realtimethreads.h"
 #include "util/screensavermanager.h"
 #include "util/statsmanager.h"
 #include "util/time.h"
+#include "util/tracerecorder.h"
 #include "util/translations.h"
 #include "util/versionstore.h"
 #include "vinylcontrol/vinylcontrolmanager.h"
@@ -367,6 +372,7 @@ CoreServices::CoreServices(const CmdlineArgs& args, QApplication* pApp)
     // called after the GUI is initialized
     initializeSettings();
     initializeLogging();
+    initializeTraceRecording();
     // Only record stats in developer mode.
     if (m_cmdlineArgs.getDeveloper()) {
         StatsManager::createInstance();
@@ -386,6 +392,10 @@ CoreServices::~CoreServices() {
     CLEAR_AND_CHECK_DELETED(m_pKbdConfig);
     CLEAR_AND_CHECK_DELETED(m_pKbdConfigEmpty);
 
+    // Write a pending trace capture
+    slotTraceRecordingToggled(0.0);
+    m_pTraceRecording.reset();
+
     if (m_cmdlineArgs.getDeveloper()) {
         StatsManager::destroy();
     }
@@ -456,6 +466,48 @@ void CoreServices::initializeLogging() {
             logFlags);
 }
 
+void CoreServices::initializeTraceRecording() {
+    m_tracePath = m_cmdlineArgs.getTracePath();
+    if (m_tracePath.isEmpty()) {
+        m_tracePath = QDir(m_pSettingsManager->settings()->getSettingsPath())
+                              .filePath(QStringLiteral("mixxx-trace.json"));
+    }
+    // The memory of the buffers is allocated up front and never released
+    const int eventsPerThread = m_pSettingsManager->settings()->getValue(
+            ConfigKey(QStringLiteral("[App]"), QStringLiteral("TraceEventsPerThread")),
+            static_cast<int>(TraceRecorder::kDefaultEventsPerThread));
+    if (eventsPerThread > 0) {
+        TraceRecorder::setEventsPerThread(eventsPerThread);
+    }
+    m_pTraceRecording = std::make_unique<ControlPushButton>(
+            ConfigKey(QStringLiteral("[App]"), QStringLiteral("trace_recording")));
+    m_pTraceRecording->setButtonMode(mixxx::control::ButtonMode::Toggle);
+    connect(m_pTraceRecording.get(),
+            &ControlObject::valueChanged,
+            this,
+            &CoreServices::slotTraceRecordingToggled,
+            Qt::DirectConnection);
+    if (!m_cmdlineArgs.getTracePath().isEmpty()) {
+        // Setting the value from the owner doesn't emit valueChanged()
+        m_pTraceRecording->set(1.0);
+        slotTraceRecordingToggled(1.0);
+    }
+}
+
+void CoreServices::slotTraceRecordingToggled(double value) {
+    const bool enable = value > 0.0;
+    if (enable == TraceRecorder::isEnabled()) {
+        return;
+    }
+    if (enable) {
+        TraceRecorder::clear();
+        TraceRecorder::setEnabled(true);
+    } else {
+        TraceRecorder::setEnabled(false);
+        TraceRecorder::writeChromeTrace(m_tracePath);
+    }
+}
+
 void CoreServices::initialize(QApplication* pApp) {
     VERIFY_OR_DEBUG_ASSERT(!m_isInitialized) {
         return;
@@ -504,6 +556,12 @@ void CoreServices::initialize(QApplication* pApp) {
 
     m_pControlIndicatorTimer = std::make_shared<mixxx::ControlIndicatorTimer>(this);
 
+    m_pMemoryUsageReporter = std::make_unique<MemoryUsageReporter>(pConfig);
+
+    // Must be created before the engine, controller and worker threads
+    // are started
+    m_pRealtimeThreads = std::make_unique<RealtimeThreads>(pConfig);
+
     auto pChannelHandleFactory = std::make_shared<ChannelHandleFactory>();
 
     emit initializationProgressUpdate(20, tr("effects"));
@@ -524,6 +582,8 @@ void CoreServices::initialize(QApplication* pApp) {
     // needs to be called after m_pPlayerManager registers sound IO for each EngineChannel.
     m_pSoundManager = std::make_shared<SoundManager>(pConfig, m_pEngine.get());
     m_pEngine->registerNonEngineChannelSoundIO(gsl::make_not_null(m_pSoundManager.get()));
+    // Must be created before the decks that read its control
+    m_pQualityGovernor = std::make_shared<QualityGovernor>(pConfig);
 
     m_pRecordingManager = std::make_shared<RecordingManager>(pConfig, m_pEngine.get());
 
@@ -593,6 +653,13 @@ void CoreServices::initialize(QApplication* pApp) {
             this,
             pConfig,
             m_pDbConnectionPool);
+    // Avoid writing file tags at full speed while tracks are playing
+    connect(&PlayerInfo::instance(),
+            &PlayerInfo::currentPlayingDeckChanged,
+            this,
+            [](int deck) {
+                GlobalTrackCache::setMetadataExportThrottled(deck >= 0);
+            });
 
     m_pLibrary = std::make_shared<Library>(
             this,
@@ -601,6 +668,13 @@ void CoreServices::initialize(QApplication* pApp) {
             m_pTrackCollectionManager.get(),
             m_pPlayerManager.get(),
             m_pRecordingManager.get());
+    connect(m_pQualityGovernor.get(),
+            &QualityGovernor::levelChanged,
+            m_pLibrary.get(),
+            [this](QualityGovernor::Level level) {
+                m_pLibrary->slotThrottleBatchAnalysis(
+                        level == QualityGovernor::Level::Minimal);
+            });
 
     OverviewCache* pOverviewCache = OverviewCache::createInstance(pConfig, m_pDbConnectionPool);
     connect(&(m_pTrackCollectionManager->internalCollection()->getTrackDAO()),
@@ -929,6 +1003,9 @@ void CoreServices::finalize() {
     qDebug() << t.elapsed(false).debugMillisWithUnit() << "deleting SoundManager";
     CLEAR_AND_CHECK_DELETED(m_pSoundManager);
 
+    qDebug() << t.elapsed(false).debugMillisWithUnit() << "deleting QualityGovernor";
+    CLEAR_AND_CHECK_DELETED(m_pQualityGovernor);
+
     // ControllerManager depends on Config
     qDebug() << t.elapsed(false).debugMillisWithUnit() << "deleting ControllerManager";
     CLEAR_AND_CHECK_DELETED(m_pControllerManager);
@@ -998,6 +1075,9 @@ void CoreServices::finalize() {
 
     m_pSkinControls.reset();
 
+    m_pMemoryUsageReporter.reset();
+    m_pRealtimeThreads.reset();
+
     m_pControlIndicatorTimer.reset();
 
     t.elapsed(true);
@@ -28,6 +28,9 @@ namespace mixxx {
 
 class ControlIndicatorTimer;
 class DbConnectionPool;
+class MemoryUsageReporter;
+class QualityGovernor;
+class RealtimeThreads;
 class ScreensaverManager;
 
 class CoreServices : public QObject {
@@ -98,6 +101,10 @@ class CoreServices : public QObject {
         return m_pSettingsManager->settings();
     }
 
+    std::shared_ptr<QualityGovernor> getQualityGovernor() const {
+        return m_pQualityGovernor;
+    }
+
     std::shared_ptr<ScreensaverManager> getScreensaverManager() const {
         return m_pScreensaverManager;
     }
@@ -111,12 +118,16 @@ class CoreServices : public QObject {
   public slots:
     void slotOptionsKeyboard(bool toggle);
 
+  private slots:
+    void slotTraceRecordingToggled(double value);
+
   private:
     bool initializeDatabase();
     void initializeKeyboard();
     void initializeSettings();
     void initializeScreensaverManager();
     void initializeLogging();
+    void initializeTraceRecording();
 #ifdef MIXXX_USE_QML
     void initializeQMLSingletons();
 #endif
@@ -129,6 +140,7 @@ class CoreServices : public QObject {
     std::shared_ptr<EffectsManager> m_pEffectsManager;
     std::shared_ptr<EngineMixer> m_pEngine;
     std::shared_ptr<SoundManager> m_pSoundManager;
+    std::shared_ptr<QualityGovernor> m_pQualityGovernor;
     std::shared_ptr<PlayerManager> m_pPlayerManager;
     std::shared_ptr<RecordingManager> m_pRecordingManager;
 #ifdef __BROADCAST__
@@ -150,6 +162,10 @@ class CoreServices : public QObject {
 
     std::unique_ptr<SkinControls> m_pSkinControls;
     std::unique_ptr<ControlPushButton> m_pTouchShift;
+    std::unique_ptr<MemoryUsageReporter> m_pMemoryUsageReporter;
+    std::unique_ptr<RealtimeThreads> m_pRealtimeThreads;
+    std::unique_ptr<ControlPushButton> m_pTraceRecording;
+    QString m_tracePath;
 
     Timer m_runtime_timer;
     const CmdlineArgs& m_cmdlineArgs;
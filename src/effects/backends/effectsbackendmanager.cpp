@@ -1,5 +1,7 @@
 #include "effects/backends/effectsbackendmanager.h"
 
+#include <QDir>
+
 #include "control/controlobject.h"
 #include "effects/backends/builtin/builtinbackend.h"
 #include "effects/backends/effectmanifest.h"
@@ -12,7 +14,13 @@
 #endif
 #include "effects/presets/effectpreset.h"
 
-EffectsBackendManager::EffectsBackendManager() {
+#ifdef __LILV__
+namespace {
+const QString kLV2ManifestCacheFileName = QStringLiteral("lv2manifests.cache");
+} // anonymous namespace
+#endif
+
+EffectsBackendManager::EffectsBackendManager(UserSettingsPointer pConfig) {
     m_pNumEffectsAvailable = std::make_unique<ControlObject>(
             ConfigKey("[Master]", "num_effectsavailable"));
     m_pNumEffectsAvailable->setReadOnly();
@@ -22,7 +30,10 @@ EffectsBackendManager::EffectsBackendManager() {
     addBackend(createAudioUnitBackend());
 #endif
 #ifdef __LILV__
-    addBackend(EffectsBackendPointer(new LV2Backend()));
+    addBackend(EffectsBackendPointer(new LV2Backend(
+            QDir(pConfig->getSettingsPath()).filePath(kLV2ManifestCacheFileName))));
+#else
+    Q_UNUSED(pConfig);
 #endif
 }
 
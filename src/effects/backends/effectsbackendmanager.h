@@ -1,6 +1,7 @@
 #pragma once
 
 #include "effects/defs.h"
+#include "preferences/usersettings.h"
 
 class ControlObject;
 class EffectProcessor;
@@ -9,7 +10,7 @@ class EffectProcessor;
 /// available EffectManifests, and creates EffectProcessors from EffectManifests.
 class EffectsBackendManager {
   public:
-    EffectsBackendManager();
+    explicit EffectsBackendManager(UserSettingsPointer pConfig);
     ~EffectsBackendManager() = default;
 
     const QList<EffectManifestPointer>& getManifests() const {
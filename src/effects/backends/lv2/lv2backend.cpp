@@ -4,12 +4,32 @@
 
 #include "effects/backends/lv2/lv2effectprocessor.h"
 #include "effects/backends/lv2/lv2manifest.h"
+#include "effects/backends/lv2/lv2manifestcache.h"
+#include "util/timer.h"
 
-LV2Backend::LV2Backend() {
+namespace {
+
+QString bundlePathOf(const LilvPlugin* pPlugin) {
+    char* pPath = lilv_file_uri_parse(
+            lilv_node_as_uri(lilv_plugin_get_bundle_uri(pPlugin)), nullptr);
+    if (!pPath) {
+        return QString();
+    }
+    const QString bundlePath = QString::fromLocal8Bit(pPath);
+    lilv_free(pPath);
+    return bundlePath;
+}
+
+} // anonymous namespace
+
+LV2Backend::LV2Backend(const QString& manifestCacheFilePath) {
+    ScopedTimer timer(QStringLiteral("LV2Backend::LV2Backend"));
     m_pWorld = lilv_world_new();
     initializeProperties();
+    // Only loads the manifest.ttl of each bundle. The plugin data is
+    // loaded lazily when a plugin is queried for the first time.
     lilv_world_load_all(m_pWorld);
-    enumeratePlugins();
+    enumeratePlugins(manifestCacheFilePath);
 }
 
 LV2Backend::~LV2Backend() {
@@ -20,17 +40,47 @@ LV2Backend::~LV2Backend() {
     m_registeredEffects.clear();
 }
 
-void LV2Backend::enumeratePlugins() {
+void LV2Backend::enumeratePlugins(const QString& manifestCacheFilePath) {
+    LV2ManifestCache cache(manifestCacheFilePath);
+    const bool useCache = !manifestCacheFilePath.isEmpty();
+    if (useCache) {
+        cache.load();
+    }
+    int numScannedPlugins = 0;
     const LilvPlugins* plugs = lilv_world_get_all_plugins(m_pWorld);
     LILV_FOREACH(plugins, i, plugs) {
         const LilvPlugin* plug = lilv_plugins_get(plugs, i);
         if (lilv_plugin_is_replaced(plug)) {
             continue;
         }
-        auto lv2Manifest = LV2EffectManifestPointer::create(m_pWorld, plug, m_properties);
+        LV2EffectManifestPointer lv2Manifest;
+        QString bundlePath;
+        qint64 bundleLastModified = 0;
+        if (useCache) {
+            bundlePath = bundlePathOf(plug);
+            bundleLastModified = cache.bundleLastModified(bundlePath);
+            lv2Manifest = cache.lookup(plug,
+                    QString::fromUtf8(lilv_node_as_uri(lilv_plugin_get_uri(plug))),
+                    bundlePath,
+                    bundleLastModified);
+        }
+        if (!lv2Manifest) {
+            // Unknown plugin or modified bundle
+            lv2Manifest = LV2EffectManifestPointer::create(m_pWorld, plug, m_properties);
+            ++numScannedPlugins;
+            if (useCache) {
+                cache.insert(lv2Manifest, bundlePath, bundleLastModified);
+            }
+        }
         lv2Manifest->setBackendType(getType());
         m_registeredEffects.insert(lv2Manifest->id(), lv2Manifest);
     }
+    if (useCache) {
+        cache.retain(getDiscoveredPluginIds());
+        cache.save();
+    }
+    qInfo() << "LV2Backend: Discovered" << m_registeredEffects.size()
+            << "plugins," << numScannedPlugins << "of them not cached";
 }
 
 void LV2Backend::initializeProperties() {
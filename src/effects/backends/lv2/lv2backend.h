@@ -9,7 +9,9 @@
 /// Refer to EffectsBackend for documentation
 class LV2Backend : public EffectsBackend {
   public:
-    LV2Backend();
+    /// The manifests of discovered plugins are cached in manifestCacheFilePath
+    /// unless it is empty.
+    explicit LV2Backend(const QString& manifestCacheFilePath = QString());
     virtual ~LV2Backend();
 
     EffectBackendType getType() const {
@@ -26,7 +28,7 @@ class LV2Backend : public EffectsBackend {
     bool canInstantiateEffect(const QString& effectId) const;
 
   private:
-    void enumeratePlugins();
+    void enumeratePlugins(const QString& manifestCacheFilePath);
     void initializeProperties();
     LilvWorld* m_pWorld;
     QHash<QString, LilvNode*> m_properties;
@@ -188,6 +188,17 @@ LV2Manifest::LV2Manifest(LilvWorld* world,
     lilv_nodes_free(features);
 }
 
+LV2Manifest::LV2Manifest(const LilvPlugin* plug,
+        Status status,
+        const QList<int>& audioPorts,
+        const QList<int>& controlPorts)
+        : EffectManifest(),
+          m_pLV2plugin(plug),
+          audioPortIndices(audioPorts),
+          controlPortIndices(controlPorts),
+          m_status(status) {
+}
+
 QList<int> LV2Manifest::getAudioPortIndices() {
     return audioPortIndices;
 }
@@ -17,6 +17,13 @@ class LV2Manifest : public EffectManifest {
     };
 
     LV2Manifest(LilvWorld* world, const LilvPlugin* plug, QHash<QString, LilvNode*>& properties);
+    /// Restores a previously discovered manifest without querying the
+    /// plugin ports, which would force lilv to load the plugin data.
+    /// The caller is responsible for restoring the EffectManifest fields.
+    LV2Manifest(const LilvPlugin* plug,
+            Status status,
+            const QList<int>& audioPorts,
+            const QList<int>& controlPorts);
 
     QList<int> getAudioPortIndices();
     QList<int> getControlPortIndices();
@@ -0,0 +1,203 @@
+#include "effects/backends/lv2/lv2manifestcache.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtDebug>
+#include <algorithm>
+#include <utility>
+
+#include "effects/backends/effectmanifestparameter.h"
+
+namespace {
+
+// Increment whenever the manifest discovery in LV2Manifest changes,
+// otherwise stale manifests would be restored from the cache.
+constexpr quint32 kCacheVersion = 1;
+
+const QString kLogPrefix = QStringLiteral("LV2ManifestCache:");
+
+} // anonymous namespace
+
+LV2ManifestCache::LV2ManifestCache(QString filePath)
+        : m_filePath(std::move(filePath)),
+          m_dirty(false) {
+}
+
+bool LV2ManifestCache::load() {
+    m_plugins.clear();
+    m_dirty = false;
+    QFile file(m_filePath);
+    if (!file.exists()) {
+        return true;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << kLogPrefix << "Failed to open" << m_filePath;
+        return false;
+    }
+    const QByteArray data = file.readAll();
+    mixxx::effects::LV2ManifestCache cache;
+    if (!cache.ParseFromArray(data.constData(), static_cast<int>(data.size()))) {
+        qWarning() << kLogPrefix << "Failed to parse" << m_filePath;
+        m_dirty = true;
+        return false;
+    }
+    if (cache.version() != kCacheVersion) {
+        qInfo() << kLogPrefix << "Discarding outdated cache version" << cache.version();
+        m_dirty = true;
+        return true;
+    }
+    for (int i = 0; i < cache.plugin_size(); ++i) {
+        const auto& plugin = cache.plugin(i);
+        m_plugins.insert(QString::fromStdString(plugin.uri()), plugin);
+    }
+    return true;
+}
+
+bool LV2ManifestCache::save() {
+    if (!m_dirty) {
+        return true;
+    }
+    mixxx::effects::LV2ManifestCache cache;
+    cache.set_version(kCacheVersion);
+    for (const auto& plugin : std::as_const(m_plugins)) {
+        *cache.add_plugin() = plugin;
+    }
+    const std::string data = cache.SerializeAsString();
+
+    QDir().mkpath(QFileInfo(m_filePath).absolutePath());
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly) ||
+            file.write(data.data(), static_cast<qint64>(data.size())) !=
+                    static_cast<qint64>(data.size()) ||
+            !file.commit()) {
+        qWarning() << kLogPrefix << "Failed to write" << m_filePath << file.errorString();
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+LV2EffectManifestPointer LV2ManifestCache::lookup(
+        const LilvPlugin* pPlugin,
+        const QString& pluginUri,
+        const QString& bundlePath,
+        qint64 bundleLastModified) const {
+    const auto it = m_plugins.constFind(pluginUri);
+    if (it == m_plugins.constEnd()) {
+        return {};
+    }
+    const mixxx::effects::LV2PluginManifest& plugin = it.value();
+    if (QString::fromStdString(plugin.bundle_path()) != bundlePath ||
+            plugin.bundle_last_modified_ms() != bundleLastModified) {
+        return {};
+    }
+
+    QList<int> audioPortIndices;
+    audioPortIndices.reserve(plugin.audio_port_index_size());
+    for (int i = 0; i < plugin.audio_port_index_size(); ++i) {
+        audioPortIndices.append(plugin.audio_port_index(i));
+    }
+    QList<int> controlPortIndices;
+    controlPortIndices.reserve(plugin.control_port_index_size());
+    for (int i = 0; i < plugin.control_port_index_size(); ++i) {
+        controlPortIndices.append(plugin.control_port_index(i));
+    }
+    auto pManifest = LV2EffectManifestPointer::create(pPlugin,
+            static_cast<LV2Manifest::Status>(plugin.status()),
+            audioPortIndices,
+            controlPortIndices);
+    pManifest->setId(pluginUri);
+    pManifest->setName(QString::fromStdString(plugin.name()));
+    pManifest->setAuthor(QString::fromStdString(plugin.author()));
+
+    for (int i = 0; i < plugin.parameter_size(); ++i) {
+        const auto& parameter = plugin.parameter(i);
+        EffectManifestParameterPointer pParameter = pManifest->addParameter();
+        pParameter->setId(QString::fromStdString(parameter.id()));
+        pParameter->setName(QString::fromStdString(parameter.name()));
+        pParameter->setUnitsHint(
+                static_cast<EffectManifestParameter::UnitsHint>(parameter.units_hint()));
+        pParameter->setValueScaler(
+                static_cast<EffectManifestParameter::ValueScaler>(parameter.value_scaler()));
+        for (int j = 0; j < parameter.step_size(); ++j) {
+            pParameter->appendStep(qMakePair(
+                    QString::fromStdString(parameter.step(j).label()),
+                    parameter.step(j).value()));
+        }
+        pParameter->setRange(parameter.minimum(),
+                parameter.default_value(),
+                parameter.maximum());
+    }
+    return pManifest;
+}
+
+void LV2ManifestCache::insert(
+        const LV2EffectManifestPointer& pManifest,
+        const QString& bundlePath,
+        qint64 bundleLastModified) {
+    VERIFY_OR_DEBUG_ASSERT(pManifest) {
+        return;
+    }
+    mixxx::effects::LV2PluginManifest plugin;
+    plugin.set_uri(pManifest->id().toStdString());
+    plugin.set_bundle_path(bundlePath.toStdString());
+    plugin.set_bundle_last_modified_ms(bundleLastModified);
+    plugin.set_name(pManifest->name().toStdString());
+    plugin.set_author(pManifest->author().toStdString());
+    plugin.set_status(static_cast<int>(pManifest->getStatus()));
+    for (int index : pManifest->getAudioPortIndices()) {
+        plugin.add_audio_port_index(index);
+    }
+    for (int index : pManifest->getControlPortIndices()) {
+        plugin.add_control_port_index(index);
+    }
+    for (const auto& pParameter : pManifest->parameters()) {
+        auto* pCachedParameter = plugin.add_parameter();
+        pCachedParameter->set_id(pParameter->id().toStdString());
+        pCachedParameter->set_name(pParameter->name().toStdString());
+        pCachedParameter->set_units_hint(static_cast<int>(pParameter->unitsHint()));
+        pCachedParameter->set_value_scaler(static_cast<int>(pParameter->valueScaler()));
+        pCachedParameter->set_minimum(pParameter->getMinimum());
+        pCachedParameter->set_default_value(pParameter->getDefault());
+        pCachedParameter->set_maximum(pParameter->getMaximum());
+        for (const auto& step : pParameter->getSteps()) {
+            auto* pStep = pCachedParameter->add_step();
+            pStep->set_label(step.first.toStdString());
+            pStep->set_value(step.second);
+        }
+    }
+    m_plugins.insert(pManifest->id(), std::move(plugin));
+    m_dirty = true;
+}
+
+void LV2ManifestCache::retain(const QSet<QString>& pluginUris) {
+    for (auto it = m_plugins.begin(); it != m_plugins.end();) {
+        if (pluginUris.contains(it.key())) {
+            ++it;
+        } else {
+            it = m_plugins.erase(it);
+            m_dirty = true;
+        }
+    }
+}
+
+qint64 LV2ManifestCache::bundleLastModified(const QString& bundlePath) {
+    const auto it = m_bundleLastModified.constFind(bundlePath);
+    if (it != m_bundleLastModified.constEnd()) {
+        return it.value();
+    }
+    // Bundles are flat directories with a few Turtle files and the plugin
+    // binaries. Checking all files is required, because modifying a file
+    // in place does not update the modification time of the directory.
+    QFileInfo bundleInfo(bundlePath);
+    qint64 lastModified = bundleInfo.lastModified().toMSecsSinceEpoch();
+    const QFileInfoList fileInfos = QDir(bundlePath).entryInfoList(QDir::Files);
+    for (const QFileInfo& fileInfo : fileInfos) {
+        lastModified = std::max(lastModified, fileInfo.lastModified().toMSecsSinceEpoch());
+    }
+    m_bundleLastModified.insert(bundlePath, lastModified);
+    return lastModified;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <lilv/lilv.h>
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+
+#include "effects/backends/lv2/lv2manifest.h"
+#include "proto/effects.pb.h"
+
+/// Persists the manifests of discovered LV2 plugins between sessions.
+///
+/// Building an LV2Manifest queries all ports of a plugin, which forces lilv
+/// to load and parse the complete plugin data of its bundle. With a cached
+/// manifest this is deferred until the plugin is actually instantiated.
+/// Entries are keyed by plugin URI and invalidated when any file in the
+/// plugin's bundle directory has been modified.
+class LV2ManifestCache {
+  public:
+    explicit LV2ManifestCache(QString filePath);
+
+    const QString& filePath() const {
+        return m_filePath;
+    }
+
+    /// Reads the cache file. A missing or outdated file results
+    /// in an empty cache.
+    bool load();
+    /// Writes the cache file if entries have been modified since loading.
+    bool save();
+
+    /// Returns the cached manifest for the plugin or a null pointer if
+    /// the plugin is unknown or its bundle has been modified.
+    LV2EffectManifestPointer lookup(
+            const LilvPlugin* pPlugin,
+            const QString& pluginUri,
+            const QString& bundlePath,
+            qint64 bundleLastModified) const;
+
+    void insert(
+            const LV2EffectManifestPointer& pManifest,
+            const QString& bundlePath,
+            qint64 bundleLastModified);
+
+    /// Removes the entries of all plugins that are not installed anymore.
+    void retain(const QSet<QString>& pluginUris);
+
+    int size() const {
+        return m_plugins.size();
+    }
+
+    /// The most recent modification time of all files in the bundle
+    /// directory in ms since epoch. Bundles often contain many plugins,
+    /// so the result is computed once per bundle and memoized for the
+    /// lifetime of this cache, i.e. while enumerating the plugins.
+    qint64 bundleLastModified(const QString& bundlePath);
+
+  private:
+    const QString m_filePath;
+    QHash<QString, mixxx::effects::LV2PluginManifest> m_plugins;
+    QHash<QString, qint64> m_bundleLastModified;
+    bool m_dirty;
+};
@@ -29,6 +29,9 @@ class EngineBufferScaleRubberBand final : public EngineBufferScale {
 
     // Enable engine v3 if available
     void useEngineFiner(bool enable);
+    bool isEngineFiner() const {
+        return m_useEngineFiner;
+    }
 
     void setScaleParameters(double base_rate,
                             double* pTempoRatio,
@@ -3,6 +3,7 @@
 #include "engine/engine.h"
 #include "util/assert.h"
 #include "util/compatibility/qmutex.h"
+#include "util/realtimethreads.h"
 
 RubberBandTask::RubberBandTask(
         size_t sampleRate, size_t channels, Options options)
@@ -35,6 +36,10 @@ void RubberBandTask::run() {
     VERIFY_OR_DEBUG_ASSERT(m_completedSema.available() == 0 && m_input && m_samples) {
         return;
     };
+    // No-op if this is the engine thread that runs the task itself,
+    // because it has been configured as the audio callback thread before.
+    mixxx::RealtimeThreads::applyToCurrentThread(
+            mixxx::RealtimeThreads::ThreadClass::RubberBandWorker);
     process(m_input,
             m_samples,
             m_isFinal);
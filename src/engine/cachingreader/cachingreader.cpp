@@ -2,6 +2,7 @@
 
 #include <QtDebug>
 
+#include "mixer/playermanager.h"
 #include "moc_cachingreader.cpp"
 #include "util/assert.h"
 #include "util/compatibility/qatomic.h"
@@ -35,6 +36,11 @@ constexpr SINT kDefaultHintFrames = 1024;
 // massive drop outs are expected to occur Mixxx should run reliably!
 constexpr SINT kNumberOfCachedChunksInMemory = 80;
 
+// Samplers keep tracks that fit into the cache entirely in memory, i.e.
+// up to ~14 s @ 48 kHz. This ensures that pads respond instantly, even
+// on the first trigger after loading.
+const ConfigKey kKeepSamplesResidentConfigKey("[Sampler]", "keep_samples_resident");
+
 } // anonymous namespace
 
 CachingReader::CachingReader(const QString& group,
@@ -60,6 +66,14 @@ CachingReader::CachingReader(const QString& group,
           m_lruCachingReaderChunk(nullptr),
           m_sampleBuffer(CachingReaderChunk::kFrames * maxSupportedChannel *
                   kNumberOfCachedChunksInMemory),
+          m_sampleBufferMemoryUsage(mixxx::MemoryUsage::Subsystem::CachingReader,
+                  m_sampleBuffer.size() * sizeof(CSAMPLE)),
+          m_keepTrackResident(PlayerManager::isSamplerGroup(group) &&
+                  config->getValue(kKeepSamplesResidentConfigKey, true)),
+          m_residentFirstChunkIndex(0),
+          m_residentChunkCount(0),
+          m_residentReadyChunkCount(0),
+          m_residentChunks(kNumberOfCachedChunksInMemory, nullptr),
           m_worker(group,
                   &m_chunkReadRequestFIFO,
                   &m_readerStatusUpdateFIFO,
@@ -99,6 +113,12 @@ CachingReader::~CachingReader() {
 }
 
 void CachingReader::freeChunkFromList(CachingReaderChunkForOwner* pChunk) {
+    const SINT chunkIndex = pChunk->getIndex();
+    if (chunkIndex >= m_residentFirstChunkIndex && chunkIndex < m_residentChunkCount &&
+            m_residentChunks[chunkIndex] == pChunk) {
+        m_residentChunks[chunkIndex] = nullptr;
+        --m_residentReadyChunkCount;
+    }
     pChunk->removeFromList(
             &m_mruCachingReaderChunk,
             &m_lruCachingReaderChunk);
@@ -255,6 +275,13 @@ void CachingReader::process() {
                 // Insert or freshen the chunk in the MRU/LRU list after
                 // obtaining ownership from the worker.
                 freshenChunk(pChunk);
+                const SINT chunkIndex = pChunk->getIndex();
+                if (chunkIndex >= m_residentFirstChunkIndex &&
+                        chunkIndex < m_residentChunkCount &&
+                        !m_residentChunks[chunkIndex]) {
+                    m_residentChunks[chunkIndex] = pChunk;
+                    ++m_residentReadyChunkCount;
+                }
             } else {
                 // Discard chunks that don't carry any data
                 freeChunk(pChunk);
@@ -284,6 +311,20 @@ void CachingReader::process() {
                 }
                 // Reset the readable frame index range
                 m_readableFrameIndexRange = update.readableFrameIndexRange();
+                DEBUG_ASSERT(m_residentReadyChunkCount == 0);
+                m_residentChunkCount = 0;
+                if (m_keepTrackResident && !m_readableFrameIndexRange.empty()) {
+                    const SINT firstChunkIndex = CachingReaderChunk::indexForFrame(
+                            m_readableFrameIndexRange.start());
+                    const SINT chunkCount = CachingReaderChunk::indexForFrame(
+                                                    m_readableFrameIndexRange.end() - 1) +
+                            1;
+                    if (chunkCount <= kNumberOfCachedChunksInMemory) {
+                        // The chunks are requested with the next hints
+                        m_residentFirstChunkIndex = firstChunkIndex;
+                        m_residentChunkCount = chunkCount;
+                    }
+                }
                 m_state.storeRelease(STATE_TRACK_LOADED);
             } else {
                 DEBUG_ASSERT(update.status == TRACK_UNLOADED);
@@ -448,7 +489,10 @@ CachingReader::ReadResult CachingReader::read(SINT startSample,
                 }
 
                 mixxx::IndexRange bufferedFrameIndexRange;
-                const CachingReaderChunkForOwner* const pChunk = lookupChunkAndFreshen(chunkIndex);
+                DEBUG_ASSERT(!isTrackResident() || chunkIndex < m_residentChunkCount);
+                const CachingReaderChunkForOwner* const pChunk = isTrackResident()
+                        ? m_residentChunks[chunkIndex]
+                        : lookupChunkAndFreshen(chunkIndex);
                 if (pChunk && (pChunk->getState() == CachingReaderChunkForOwner::READY)) {
                     if (reverse) {
                         bufferedFrameIndexRange =
@@ -542,6 +586,11 @@ void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
         return;
     }
 
+    // All chunks of a resident track are already in memory and never expire
+    if (isTrackResident()) {
+        return;
+    }
+
     // For every chunk that the hints indicated, check if it is in the cache. If
     // any are not, then wake.
     bool shouldWake = false;
@@ -583,31 +632,7 @@ void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
             CachingReaderChunkForOwner* pChunk = lookupChunk(chunkIndex);
             if (!pChunk) {
                 shouldWake = true;
-                pChunk = allocateChunkExpireLRU(chunkIndex);
-                if (!pChunk) {
-                    kLogger.warning()
-                            << "Failed to allocate chunk"
-                            << chunkIndex
-                            << "for read request";
-                    continue;
-                }
-                // Do not insert the allocated chunk into the MRU/LRU list,
-                // because it will be handed over to the worker immediately
-                CachingReaderChunkReadRequest request;
-                request.giveToWorker(pChunk);
-                if (kLogger.traceEnabled()) {
-                    kLogger.trace()
-                            << "Requesting read of chunk"
-                            << request.chunk;
-                }
-                if (m_chunkReadRequestFIFO.write(&request, 1) != 1) {
-                    kLogger.warning()
-                            << "Failed to submit read request for chunk"
-                            << chunkIndex;
-                    // Revoke the chunk from the worker and free it
-                    pChunk->takeFromWorker();
-                    freeChunk(pChunk);
-                }
+                requestChunk(chunkIndex);
             } else if (pChunk->getState() == CachingReaderChunkForOwner::READY) {
                 // This will cause the chunk to be 'freshened' in the cache. The
                 // chunk will be moved to the end of the LRU list.
@@ -616,8 +641,65 @@ void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
         }
     }
 
+    // Request the remaining chunks of a resident track after the hinted
+    // chunks, which are needed first.
+    if (m_residentChunkCount > 0 && requestResidentChunks()) {
+        shouldWake = true;
+    }
+
     // If there are chunks to be read, wake up.
     if (shouldWake) {
         m_worker.workReady();
     }
 }
+
+bool CachingReader::requestChunk(SINT chunkIndex) {
+    CachingReaderChunkForOwner* pChunk = allocateChunkExpireLRU(chunkIndex);
+    if (!pChunk) {
+        kLogger.warning()
+                << "Failed to allocate chunk"
+                << chunkIndex
+                << "for read request";
+        return false;
+    }
+    // Do not insert the allocated chunk into the MRU/LRU list,
+    // because it will be handed over to the worker immediately
+    CachingReaderChunkReadRequest request;
+    request.giveToWorker(pChunk);
+    if (kLogger.traceEnabled()) {
+        kLogger.trace()
+                << "Requesting read of chunk"
+                << request.chunk;
+    }
+    if (m_chunkReadRequestFIFO.write(&request, 1) != 1) {
+        kLogger.warning()
+                << "Failed to submit read request for chunk"
+                << chunkIndex;
+        // Revoke the chunk from the worker and free it
+        pChunk->takeFromWorker();
+        freeChunk(pChunk);
+        return false;
+    }
+    return true;
+}
+
+bool CachingReader::requestResidentChunks() {
+    DEBUG_ASSERT(m_residentChunkCount <= kNumberOfCachedChunksInMemory);
+    bool requested = false;
+    for (SINT chunkIndex = m_residentFirstChunkIndex;
+            chunkIndex < m_residentChunkCount;
+            ++chunkIndex) {
+        if (lookupChunk(chunkIndex)) {
+            // Either ready or pending
+            continue;
+        }
+        // Don't flood the FIFO, the remaining chunks are requested
+        // with the next hints
+        if (m_chunkReadRequestFIFO.writeAvailable() <= 0 ||
+                !requestChunk(chunkIndex)) {
+            break;
+        }
+        requested = true;
+    }
+    return requested;
+}
@@ -6,11 +6,13 @@
 #include <QVarLengthArray>
 #include <QVector>
 #include <list>
+#include <vector>
 
 #include "engine/cachingreader/cachingreaderworker.h"
 #include "preferences/usersettings.h"
 #include "track/track_decl.h"
 #include "util/fifo.h"
+#include "util/memoryusage.h"
 #include "util/types.h"
 
 // A Hint is an indication to the CachingReader that a certain section of a
@@ -168,6 +170,22 @@ class CachingReader : public QObject {
     // Gets a chunk from the free list, frees the LRU CachingReaderChunk if none available.
     CachingReaderChunkForOwner* allocateChunkExpireLRU(SINT chunkIndex);
 
+    // Allocates a chunk and hands it over to the worker for reading. Returns
+    // false if no chunk is available or the request could not be submitted.
+    bool requestChunk(SINT chunkIndex);
+
+    // Requests all chunks of a resident track that are not yet in memory,
+    // limited by the capacity of the request FIFO. Returns true if the worker
+    // needs to be woken up.
+    bool requestResidentChunks();
+
+    // True if all chunks of the track are kept in memory and can be looked up
+    // directly by their index.
+    bool isTrackResident() const {
+        return m_residentChunkCount > 0 &&
+                m_residentReadyChunkCount == m_residentChunkCount - m_residentFirstChunkIndex;
+    }
+
     enum State {
         STATE_IDLE,
         STATE_TRACK_LOADING,
@@ -193,9 +211,23 @@ class CachingReader : public QObject {
 
     // The raw memory buffer which is divided up into chunks.
     mixxx::SampleBuffer m_sampleBuffer;
+    mixxx::ScopedMemoryUsage m_sampleBufferMemoryUsage;
 
     // The readable frame index range as reported by the worker.
     mixxx::IndexRange m_readableFrameIndexRange;
 
+    // Samplers decode short tracks entirely at load time. All chunks of such a
+    // track fit into the cache and are never expired, so after they have been
+    // read they are looked up in m_residentChunks by their index instead of
+    // going through the hash and the MRU/LRU list.
+    const bool m_keepTrackResident;
+    // The chunk index range [first, count) of the loaded track if it is
+    // kept resident, otherwise count is 0
+    SINT m_residentFirstChunkIndex;
+    SINT m_residentChunkCount;
+    SINT m_residentReadyChunkCount;
+    // Preallocated for the maximum number of chunks, indexed by chunk index
+    std::vector<CachingReaderChunkForOwner*> m_residentChunks;
+
     CachingReaderWorker m_worker;
 };
@@ -11,7 +11,9 @@
 #include "util/event.h"
 #include "util/fifo.h"
 #include "util/logger.h"
+#include "util/realtimethreads.h"
 #include "util/span.h"
+#include "util/tracerecorder.h"
 
 namespace {
 
@@ -36,6 +38,7 @@ CachingReaderWorker::CachingReaderWorker(
 
 ReaderStatusUpdate CachingReaderWorker::processReadRequest(
         const CachingReaderChunkReadRequest& request) {
+    mixxx::ScopedTraceEvent trace("reader", "CachingReaderWorker::processReadRequest");
     CachingReaderChunk* pChunk = request.chunk;
     DEBUG_ASSERT(pChunk);
 
@@ -117,6 +120,8 @@ void CachingReaderWorker::run() {
     const auto id = lastId.fetchAndAddRelaxed(1) + 1;
     QThread::currentThread()->setObjectName(
             QStringLiteral("CachingReaderWorker ") + QString::number(id));
+    mixxx::RealtimeThreads::applyToCurrentThread(
+            mixxx::RealtimeThreads::ThreadClass::CachingReaderWorker);
 
     Event::start(m_tag);
     while (!m_stop.loadAcquire()) {
@@ -193,6 +198,7 @@ void CachingReaderWorker::loadTrack(
 #else
 void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
 #endif
+    mixxx::ScopedTraceEvent trace("reader", "CachingReaderWorker::loadTrack");
     // This emit is directly connected and returns synchronized
     // after the engine has been stopped.
     emit trackLoading();
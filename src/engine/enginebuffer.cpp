@@ -1,6 +1,7 @@
 #include "engine/enginebuffer.h"
 
 #include <QtDebug>
+#include <algorithm>
 
 #include "control/controllinpotmeter.h"
 #include "control/controlpotmeter.h"
@@ -25,13 +26,17 @@
 #include "mixer/playermanager.h"
 #include "moc_enginebuffer.cpp"
 #include "preferences/usersettings.h"
+#include "soundio/qualitygovernor.h"
 #include "track/track.h"
 #include "util/assert.h"
 #include "util/compatibility/qatomic.h"
 #include "util/defs.h"
+#include "util/inputeventtime.h"
 #include "util/logger.h"
 #include "util/sample.h"
+#include "util/time.h"
 #include "util/timer.h"
+#include "util/tracerecorder.h"
 #include "waveform/visualplayposition.h"
 
 #ifdef __RUBBERBAND__
@@ -53,6 +58,8 @@ constexpr int kPlaypositionUpdateRate = 15; // updates per second
 
 const QString kAppGroup = QStringLiteral("[App]");
 
+const ConfigKey kSampleAccurateInputConfigKey("[Controller]", "sample_accurate_seeks");
+
 } // anonymous namespace
 
 EngineBuffer::EngineBuffer(const QString& group,
@@ -85,6 +92,9 @@ EngineBuffer::EngineBuffer(const QString& group,
           m_bSlipEnabledProcessing(false),
           m_slipModeState(SlipModeState::Disabled),
           m_quantize(ControlFlag::AllowMissingOrInvalid),
+          m_qualityReduction(kAppGroup,
+                  QStringLiteral("quality_reduction"),
+                  ControlFlag::AllowMissingOrInvalid),
           m_pRepeat(nullptr),
           m_startButton(nullptr),
           m_endButton(nullptr),
@@ -108,6 +118,7 @@ EngineBuffer::EngineBuffer(const QString& group,
     DEBUG_ASSERT(kInitialPlayPosition.isValid());
 
     m_queuedSeek.setValue(kNoQueuedSeek);
+    m_bSampleAccurateInput = pConfig->getValue(kSampleAccurateInputConfigKey, true);
 
     // zero out crossfade buffer
     SampleUtil::clear(m_pCrossfadeBuffer, kMaxEngineFrames * mixxx::kMaxEngineChannelInputCount);
@@ -279,6 +290,11 @@ EngineBuffer::EngineBuffer(const QString& group,
     m_pScaleST = new EngineBufferScaleST(m_pReadAheadManager);
 #ifdef __RUBBERBAND__
     m_pScaleRB = new EngineBufferScaleRubberBand(m_pReadAheadManager);
+    m_pScaleRBFaster = nullptr;
+    if (EngineBufferScaleRubberBand::isEngineFinerAvailable()) {
+        m_pScaleRBFaster = new EngineBufferScaleRubberBand(m_pReadAheadManager);
+        m_pScaleRBFaster->useEngineFiner(false);
+    }
 #endif
     slotKeylockEngineChanged(m_pKeylockEngine->get());
     m_pScaleVinyl = m_pScaleLinear;
@@ -335,6 +351,7 @@ EngineBuffer::~EngineBuffer() {
     delete m_pScaleST;
 #ifdef __RUBBERBAND__
     delete m_pScaleRB;
+    delete m_pScaleRBFaster;
 #endif
 
     delete m_pKeylock;
@@ -357,7 +374,7 @@ void EngineBuffer::enableIndependentPitchTempoScaling(bool bEnable,
 
     // m_pScaleKeylock and m_pScaleVinyl could change out from under us,
     // so cache it.
-    EngineBufferScale* keylock_scale = m_pScaleKeylock;
+    EngineBufferScale* keylock_scale = reducedQualityKeylockScale(m_pScaleKeylock);
     EngineBufferScale* vinyl_scale = m_pScaleVinyl;
 
     if (bEnable && m_pScale != keylock_scale) {
@@ -382,6 +399,34 @@ void EngineBuffer::enableIndependentPitchTempoScaling(bool bEnable,
     }
 }
 
+EngineBufferScale* EngineBuffer::reducedQualityKeylockScale(
+        EngineBufferScale* pKeylockScale) const {
+#ifdef __RUBBERBAND__
+    if (pKeylockScale != m_pScaleRB || m_bScalerOverride) {
+        return pKeylockScale;
+    }
+    // Only decks that are not audible are degraded, the audible ones
+    // keep the configured quality until the end.
+    if (m_pSyncControl->isAudible()) {
+        return pKeylockScale;
+    }
+    const auto level = static_cast<mixxx::QualityGovernor::Level>(
+            static_cast<int>(m_qualityReduction.get()));
+    switch (level) {
+    case mixxx::QualityGovernor::Level::Full:
+        return pKeylockScale;
+    case mixxx::QualityGovernor::Level::Reduced:
+        if (m_pScaleRBFaster && m_pScaleRB->isEngineFiner()) {
+            return m_pScaleRBFaster;
+        }
+        return pKeylockScale;
+    case mixxx::QualityGovernor::Level::Minimal:
+        return m_pScaleST;
+    }
+#endif
+    return pKeylockScale;
+}
+
 mixxx::Bpm EngineBuffer::getBpm() const {
     return m_pBpmControl->getBpm();
 }
@@ -415,7 +460,9 @@ void EngineBuffer::queueNewPlaypos(mixxx::audio::FramePos position, enum SeekReq
         // use SEEK_STANDARD for that
         seekType = SEEK_STANDARD;
     }
-    m_queuedSeek.setValue({position, seekType});
+    m_queuedSeek.setValue({position,
+            seekType,
+            m_bSampleAccurateInput ? mixxx::InputEventTime::currentNanos() : 0});
 }
 
 void EngineBuffer::requestSyncPhase() {
@@ -923,7 +970,7 @@ void EngineBuffer::processTrackLocked(
     processSlip(bufferSize);
 
     // Note: This may affect the m_playPos, play, scaler and crossfade buffer
-    processSeek(paused);
+    processSeek(paused, bufferSize);
 
     // speed is the ratio between track-time and real-time
     // (1.0 being normal rate. 2.0 plays at 2x speed -- 2 track seconds
@@ -1122,8 +1169,19 @@ void EngineBuffer::processTrackLocked(
 
     // If the buffer is not paused, then scale the audio.
     if (!bCurBufferPaused) {
+        // Continue with the audio from the previous position until the
+        // offset of a sample accurate seek
+        std::size_t seekOffsetSamples = 0;
+        if (m_bCrossfadeReady && m_seekFrameOffset > 0) {
+            seekOffsetSamples = static_cast<std::size_t>(m_seekFrameOffset) * m_channelCount;
+            DEBUG_ASSERT(seekOffsetSamples < bufferSize);
+            SampleUtil::copy(pOutput, m_pCrossfadeBuffer, seekOffsetSamples);
+        }
+        m_seekFrameOffset = 0;
+
         // Perform scaling of Reader buffer into buffer.
-        const double framesRead = m_pScale->scaleBuffer(pOutput, bufferSize);
+        const double framesRead = m_pScale->scaleBuffer(
+                pOutput + seekOffsetSamples, bufferSize - seekOffsetSamples);
 
         // TODO(XXX): The result framesRead might not be an integer value.
         // Converting to samples here does not make sense. All positional
@@ -1149,7 +1207,10 @@ void EngineBuffer::processTrackLocked(
             // Bring pOutput with the new parameters in and fade out the old one,
             // stored with the old parameters in m_pCrossfadeBuffer
             SampleUtil::linearCrossfadeBuffersIn(
-                    pOutput, m_pCrossfadeBuffer, bufferSize, m_channelCount);
+                    pOutput + seekOffsetSamples,
+                    m_pCrossfadeBuffer + seekOffsetSamples,
+                    bufferSize - seekOffsetSamples,
+                    m_channelCount);
         }
         // Note: we do not fade here if we pass the end or the start of
         // the track in reverse direction
@@ -1207,6 +1268,7 @@ void EngineBuffer::processTrackLocked(
 }
 
 void EngineBuffer::process(CSAMPLE* pOutput, const std::size_t bufferSize) {
+    mixxx::ScopedTraceEvent trace("engine", "EngineBuffer::process");
     // Bail if we receive a buffer size with incomplete sample frames. Assert in debug builds.
     VERIFY_OR_DEBUG_ASSERT((bufferSize % m_channelCount) == 0) {
         return;
@@ -1231,6 +1293,9 @@ void EngineBuffer::process(CSAMPLE* pOutput, const std::size_t bufferSize) {
     m_pScaleST->setSignal(m_sampleRate, m_channelCount);
 #ifdef __RUBBERBAND__
     m_pScaleRB->setSignal(m_sampleRate, m_channelCount);
+    if (m_pScaleRBFaster) {
+        m_pScaleRBFaster->setSignal(m_sampleRate, m_channelCount);
+    }
 #endif
 
     bool hasStableTrack = m_pTrackLoaded->toBool() && m_iTrackLoading.loadAcquire() == 0;
@@ -1352,8 +1417,9 @@ void EngineBuffer::processSyncRequests() {
     }
 }
 
-void EngineBuffer::processSeek(bool paused) {
+void EngineBuffer::processSeek(bool paused, const std::size_t bufferSize) {
     m_previousBufferSeek = false;
+    m_seekFrameOffset = 0;
 
     const QueuedSeek queuedSeek = m_queuedSeek.getValue();
 
@@ -1423,6 +1489,14 @@ void EngineBuffer::processSeek(bool paused) {
         }
         setNewPlaypos(position);
         m_previousBufferSeek = true;
+        // The audio of the previous position is only available in the
+        // crossfade buffer if it has been read with the same buffer size.
+        // Phase seeks are applied at the start of the buffer, because their
+        // target has been aligned to the beats for the start of the buffer.
+        if (!paused && !(seekType & SEEK_PHASE) && queuedSeek.inputEventNanos > 0 &&
+                m_bCrossfadeReady && m_lastBufferSize == bufferSize) {
+            m_seekFrameOffset = inputEventFrameOffset(queuedSeek.inputEventNanos, bufferSize);
+        }
     }
     // Reset the m_queuedSeek value after it has been processed in
     // setNewPlaypos() so that the Engine Controls have always access to the
@@ -1430,6 +1504,26 @@ void EngineBuffer::processSeek(bool paused) {
     m_queuedSeek.setValue(kNoQueuedSeek);
 }
 
+SINT EngineBuffer::inputEventFrameOffset(
+        qint64 inputEventNanos, const std::size_t bufferSize) const {
+    if (!m_sampleRate.isValid()) {
+        return 0;
+    }
+    // The event has been received during the previous buffer period. Render
+    // it with a constant latency of one buffer period instead of at the start
+    // of this buffer, which would add a jitter of up to one buffer period.
+    const SINT bufferFrames = static_cast<SINT>(bufferSize / m_channelCount);
+    const double bufferNanos = bufferFrames * 1e9 / m_sampleRate.value();
+    const qint64 eventAgeNanos = mixxx::Time::elapsed().toIntegerNanos() - inputEventNanos;
+    const double offsetNanos = bufferNanos - eventAgeNanos;
+    if (offsetNanos <= 0) {
+        // Late events are rendered immediately
+        return 0;
+    }
+    const auto offsetFrames = static_cast<SINT>(offsetNanos * m_sampleRate.value() / 1e9);
+    return std::clamp<SINT>(offsetFrames, 0, bufferFrames - 1);
+}
+
 void EngineBuffer::postProcessLocalBpm() {
     m_pBpmControl->updateLocalBpm();
 }
@@ -278,6 +278,10 @@ class EngineBuffer : public EngineObject {
     struct QueuedSeek {
         mixxx::audio::FramePos position;
         enum SeekRequest seekType;
+        // The time of the input event that requested the seek, see
+        // mixxx::InputEventTime. 0 if the seek has not been requested
+        // by a timestamped input event.
+        qint64 inputEventNanos;
     };
 
     // Add an engine control to the EngineBuffer
@@ -286,6 +290,9 @@ class EngineBuffer : public EngineObject {
 
     void enableIndependentPitchTempoScaling(bool bEnable,
             const std::size_t bufferSize);
+    /// Returns a cheaper replacement for the keylock scaler if the quality
+    /// of this deck may be reduced, see mixxx::QualityGovernor.
+    EngineBufferScale* reducedQualityKeylockScale(EngineBufferScale* pKeylockScale) const;
 
     void updateIndicators(double rate, std::size_t bufferSize);
 
@@ -305,7 +312,10 @@ class EngineBuffer : public EngineObject {
     void setNewPlaypos(mixxx::audio::FramePos playpos);
 
     void processSyncRequests();
-    void processSeek(bool paused);
+    void processSeek(bool paused, const std::size_t bufferSize);
+    // Returns the frame offset within the current buffer at which an input
+    // event is rendered with a constant latency of one buffer, see processSeek()
+    SINT inputEventFrameOffset(qint64 inputEventNanos, const std::size_t bufferSize) const;
     // For debugging / testing -- returns true if the previous buffer call resulted in a seek.
     FRIEND_TEST(EngineSyncTest, FollowerUserTweakPreservedInSyncDisable);
     bool previousBufferSeek() const {
@@ -424,6 +434,8 @@ class EngineBuffer : public EngineObject {
     ControlPushButton* m_pSlipButton;
 
     PollingControlProxy m_quantize;
+    /// See mixxx::QualityGovernor
+    PollingControlProxy m_qualityReduction;
     ControlPotmeter* m_playposSlider;
     ControlProxy* m_pSampleRate;
     ControlProxy* m_pKeylockEngine;
@@ -453,6 +465,8 @@ class EngineBuffer : public EngineObject {
     FRIEND_TEST(EngineBufferTest, ReadFadeOut);
     FRIEND_TEST(EngineBufferTest, RateTempTest);
     FRIEND_TEST(EngineBufferTest, RatePermTest);
+    FRIEND_TEST(EngineBufferTest, SeekAtInputEventOffset);
+    FRIEND_TEST(EngineBufferTest, PhaseSeekAtBufferStart);
     EngineBufferScale* m_pScaleVinyl;
     // The keylock engine is configurable, so it could flip flop between
     // ScaleST and ScaleRB during a single callback.
@@ -464,6 +478,10 @@ class EngineBuffer : public EngineObject {
     EngineBufferScaleST* m_pScaleST;
 #ifdef __RUBBERBAND__
     EngineBufferScaleRubberBand* m_pScaleRB;
+    // Fallback for m_pScaleRB in RubberBand R3 (finer) mode that uses the
+    // cheaper R2 (faster) engine while the audio engine is overloaded and
+    // the deck is not audible. Only available with RubberBand V3.
+    EngineBufferScaleRubberBand* m_pScaleRBFaster;
 #endif
 
     // Indicates whether the scaler has changed since the last process()
@@ -476,12 +494,18 @@ class EngineBuffer : public EngineObject {
     QAtomicInt m_iSyncModeQueued;
     ControlValueAtomic<QueuedSeek> m_queuedSeek;
     bool m_previousBufferSeek = false;
+    // Seeks requested by controllers are applied at the sample offset that
+    // corresponds to the time of the input event instead of at the start of
+    // the next buffer. Until this offset the audio from the previous position
+    // is played, which is read into the crossfade buffer anyway.
+    bool m_bSampleAccurateInput = true;
+    SINT m_seekFrameOffset = 0;
 
     QAtomicInt m_slipQuitAndAdopt;
     /// Indicates that no seek is queued
-    static constexpr QueuedSeek kNoQueuedSeek = {mixxx::audio::kInvalidFramePos, SEEK_NONE};
+    static constexpr QueuedSeek kNoQueuedSeek = {mixxx::audio::kInvalidFramePos, SEEK_NONE, 0};
     /// indicates a clone seek on a bosition from another deck
-    static constexpr QueuedSeek kCloneSeek = {mixxx::audio::kInvalidFramePos, SEEK_CLONE};
+    static constexpr QueuedSeek kCloneSeek = {mixxx::audio::kInvalidFramePos, SEEK_CLONE, 0};
     QAtomicPointer<EngineChannel> m_pChannelToCloneFrom;
 
     // Is true if the previous buffer was silent due to pausing
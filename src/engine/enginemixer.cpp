@@ -27,6 +27,7 @@
 #include "util/parented_ptr.h"
 #include "util/sample.h"
 #include "util/samplebuffer.h"
+#include "util/tracerecorder.h"
 
 namespace {
 const QString kAppGroup = QStringLiteral("[App]");
@@ -242,6 +243,7 @@ void EngineMixer::processChannels(std::size_t bufferSize) {
     m_activeChannels.clear();
 
     // ScopedTimer timer(QStringLiteral("EngineMixer::processChannels"));
+    mixxx::ScopedTraceEvent trace("engine", "EngineMixer::processChannels");
     EngineChannel* pLeaderChannel = m_pEngineSync->getLeaderChannel();
     // Reserve the first place for the main channel which
     // should be processed first
@@ -361,12 +363,14 @@ void EngineMixer::processChannels(std::size_t bufferSize) {
 void EngineMixer::process(const std::size_t bufferSize) {
     DEBUG_ASSERT(bufferSize <= static_cast<int>(kMaxEngineSamples));
 
-    static bool haveSetName = false;
+    // The sound device may call back from a new thread after a restart
+    static thread_local bool haveSetName = false;
     if (!haveSetName) {
         QThread::currentThread()->setObjectName("Engine");
+        mixxx::TraceRecorder::markCurrentThreadRealtime();
         haveSetName = true;
     }
-    // Trace t("EngineMixer::process");
+    mixxx::ScopedTraceEvent trace("engine", "EngineMixer::process");
 
     bool mainEnabled = m_pMainEnabled->toBool();
     bool boothEnabled = m_pBoothEnabled->toBool();
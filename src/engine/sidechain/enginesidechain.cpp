@@ -15,6 +15,7 @@
 #include "moc_enginesidechain.cpp"
 #include "util/counter.h"
 #include "util/event.h"
+#include "util/realtimethreads.h"
 #include "util/sample.h"
 #include "util/trace.h"
 
@@ -96,6 +97,8 @@ void EngineSideChain::run() {
     // factor this out somehow), -kousu 2/2009
     unsigned static id = 0;
     QThread::currentThread()->setObjectName(QString("EngineSideChain %1").arg(++id));
+    mixxx::RealtimeThreads::applyToCurrentThread(
+            mixxx::RealtimeThreads::ThreadClass::SideChain);
     static const QString tag("EngineSideChain");
     Event::start(tag);
     while (!m_bStopThread) {
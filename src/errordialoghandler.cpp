@@ -9,6 +9,7 @@
 
 #include "moc_errordialoghandler.cpp"
 #include "util/assert.h"
+#include "util/cmdlineargs.h"
 #include "util/compatibility/qmutex.h"
 #include "util/versionstore.h"
 #include "util/widgethelper.h"
@@ -21,6 +22,13 @@ constexpr int kEstimatedShowDetailedDialogHeight = 500; // px
 constexpr int kEstimatedDialogPadding = 50;             // px
 // used to push the dialog away from screen borders to not cover taskbars
 constexpr int kMinimumDialogMargin = 40; // px
+
+// Without a display nobody could close a dialog, and a modal dialog
+// would block the application forever
+bool isHeadless() {
+    return CmdlineArgs::Instance().isHeadless() ||
+            QGuiApplication::platformName() == QStringLiteral("offscreen");
+}
 } // namespace
 
 ErrorDialogProperties::ErrorDialogProperties()
@@ -152,6 +160,18 @@ void ErrorDialogHandler::errorDialog(ErrorDialogProperties* pProps) {
         return;
     }
 
+    if (isHeadless()) {
+        qWarning().noquote() << props->m_title << ":" << props->m_text;
+        if (!props->m_infoText.isEmpty()) {
+            qWarning().noquote() << props->m_infoText;
+        }
+        if (!props->m_details.isEmpty()) {
+            qWarning().noquote() << props->m_details;
+        }
+        quitOnError(*props);
+        return;
+    }
+
     QMessageBox* pMsgBox = new QMessageBox();
     pMsgBox->setIcon(props->m_icon);
     pMsgBox->setWindowTitle(props->m_title);
@@ -230,14 +250,18 @@ void ErrorDialogHandler::errorDialog(ErrorDialogProperties* pProps) {
         pMsgBox->show();
     }
 
+    quitOnError(*props);
+}
+
+void ErrorDialogHandler::quitOnError(const ErrorDialogProperties& props) {
     // If critical/fatal, gracefully exit application if possible
-    if (props->m_shouldQuit) {
+    if (props.m_shouldQuit) {
         m_errorCondition = true;
         if (QCoreApplication::instance()) {
             QCoreApplication::instance()->exit(-1);
         } else {
             qDebug() << "QCoreApplication::instance() is NULL! Abruptly quitting...";
-            if (props->m_type==DLG_FATAL) {
+            if (props.m_type==DLG_FATAL) {
                 abort();
             } else {
                 exit(-1);
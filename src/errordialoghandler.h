@@ -149,6 +149,9 @@ class ErrorDialogHandler : public QObject {
     // Private constructor
     ErrorDialogHandler();
 
+    // Exits the application after a critical or fatal error
+    void quitOnError(const ErrorDialogProperties& props);
+
     static ErrorDialogHandler *s_pInstance;
     static bool s_bEnabled;
 
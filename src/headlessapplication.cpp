@@ -0,0 +1,79 @@
+#include "headlessapplication.h"
+
+#include <QDialog>
+
+#include "control/controlobject.h"
+#include "control/controlsocketserver.h"
+#include "controllers/controllermanager.h"
+#include "coreservices.h"
+#include "moc_headlessapplication.cpp"
+#include "soundio/soundmanager.h"
+#include "util/cmdlineargs.h"
+#include "util/logger.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("HeadlessApplication");
+
+const ConfigKey kControlSocketConfigKey =
+        ConfigKey(QStringLiteral("[Headless]"), QStringLiteral("control_socket"));
+const QString kDefaultControlSocketName = QStringLiteral("mixxx-control");
+
+} // anonymous namespace
+
+HeadlessApplication::HeadlessApplication(
+        QApplication* pApp,
+        const CmdlineArgs& args)
+        : m_pCoreServices(std::make_shared<CoreServices>(args, pApp)),
+          m_initialized(false) {
+    m_pCoreServices->initialize(pApp);
+
+    const SoundDeviceStatus result = m_pCoreServices->getSoundManager()->setupDevices();
+    if (result != SoundDeviceStatus::Ok) {
+        // There is nobody who could pick another device, fail early
+        // and let a supervisor restart us.
+        kLogger.critical() << "Error setting up sound devices:"
+                           << m_pCoreServices->getSoundManager()->getErrorDeviceName()
+                           << static_cast<int>(result);
+        return;
+    }
+    if (m_pCoreServices->getSoundManager()->getConfig().getOutputs().isEmpty()) {
+        kLogger.warning() << "No sound outputs configured";
+    }
+
+    m_pDlgPreferences = m_pCoreServices->makeDlgPreferences();
+    m_pDlgPreferences->setAttribute(Qt::WA_QuitOnClose, false);
+
+    m_pCoreServices->getControllerManager()->setUpDevices();
+
+    const QString socketName = m_pCoreServices->getSettings()->getValue(
+            kControlSocketConfigKey, kDefaultControlSocketName);
+    if (!socketName.isEmpty()) {
+        m_pControlSocketServer = std::make_unique<ControlSocketServer>();
+        connect(m_pControlSocketServer.get(),
+                &ControlSocketServer::quitRequested,
+                pApp,
+                &QApplication::quit,
+                Qt::QueuedConnection);
+        m_pControlSocketServer->listen(socketName);
+    }
+
+    if (args.getStartAutoDJ()) {
+        kLogger.info() << "Enabling Auto DJ from CLI flag";
+        ControlObject::set(ConfigKey(QStringLiteral("[AutoDJ]"), QStringLiteral("enabled")),
+                1.0);
+    }
+
+    kLogger.info() << "Running headless";
+    m_initialized = true;
+}
+
+HeadlessApplication::~HeadlessApplication() {
+    m_pControlSocketServer.reset();
+    m_pDlgPreferences.reset();
+    m_pCoreServices.reset();
+}
+
+} // namespace mixxx
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QApplication>
+#include <QObject>
+#include <memory>
+
+class CmdlineArgs;
+class QDialog;
+
+namespace mixxx {
+
+class ControlSocketServer;
+class CoreServices;
+
+/// Runs the engine, library, AutoDJ, controllers and broadcasting without
+/// any skin, waveforms or VSyncThread, e.g. for unattended radio
+/// automation. Started with --headless. It can be remote controlled with
+/// controllers and through a ControlSocketServer.
+class HeadlessApplication : public QObject {
+    Q_OBJECT
+  public:
+    HeadlessApplication(
+            QApplication* pApp,
+            const CmdlineArgs& args);
+    ~HeadlessApplication() override;
+
+    /// Returns false if a fatal error occurred during startup and the
+    /// event loop should not be started.
+    bool isInitialized() const {
+        return m_initialized;
+    }
+
+  private:
+    std::shared_ptr<CoreServices> m_pCoreServices;
+    // Initializes the settings of various subsystems, e.g. the
+    // equalizers, even if it is never shown.
+    std::shared_ptr<QDialog> m_pDlgPreferences;
+    std::unique_ptr<ControlSocketServer> m_pControlSocketServer;
+    bool m_initialized;
+};
+
+} // namespace mixxx
@@ -12,6 +12,7 @@
 #include "library/trackcollection.h"
 #include "library/trackcollectionmanager.h"
 #include "library/trackset/crate/cratestorage.h"
+#include "library/tracksimilarityindex.h"
 #include "library/treeitem.h"
 #include "moc_autodjfeature.cpp"
 #include "sources/soundsourceproxy.h"
@@ -25,6 +26,16 @@
 namespace {
 constexpr int kMaxRetrieveAttempts = 3;
 
+// The number of similar tracks that are tried before falling back
+// to a random track
+constexpr int kSimilarTrackCandidates = 10;
+
+const ConfigKey kRandomQueueSimilarTracksConfigKey =
+        ConfigKey(QStringLiteral("[Auto DJ]"), QStringLiteral("RandomQueueSimilarTracks"));
+
+const ConfigKey kIgnoreTimeConfigKey =
+        ConfigKey(QStringLiteral("[Auto DJ]"), QStringLiteral("IgnoreTime"));
+
     int findOrCrateAutoDjPlaylistId(PlaylistDAO& playlistDAO) {
         int playlistId = playlistDAO.getPlaylistIdFromName(AUTODJ_TABLE);
         // If the AutoDJ playlist does not exist yet then create it.
@@ -311,9 +322,56 @@ void AutoDJFeature::slotCrateChanged(CrateId crateId) {
     }
 }
 
+TrackPointer AutoDJFeature::findSimilarTrack() {
+    const QList<TrackId> queuedTrackIds = m_playlistDao.getAutoDJTrackIds();
+    if (queuedTrackIds.isEmpty()) {
+        return TrackPointer();
+    }
+    QSet<TrackId> excludedTrackIds(queuedTrackIds.cbegin(), queuedTrackIds.cend());
+    // Like the random selection skip the tracks that have been played
+    // recently, otherwise two similar tracks would be picked alternately
+    const QTime ignoreTime = QTime::fromString(
+            m_pConfig->getValue(kIgnoreTimeConfigKey, QStringLiteral("23:59")),
+            QStringLiteral("hh:mm"));
+    const QDateTime playedSince = QDateTime::currentDateTimeUtc().addSecs(
+            -(ignoreTime.hour() * 3600 + ignoreTime.minute() * 60));
+    for (const auto& trackId : m_playlistDao.getSetLogTrackIdsSince(playedSince)) {
+        excludedTrackIds.insert(trackId);
+    }
+    mixxx::RoaringBitmap crateTrackIds;
+    for (const auto& crate : std::as_const(m_crateList)) {
+        crateTrackIds |= m_pTrackCollection->crates().crateTrackIds(crate.getId());
+    }
+    const bool restrictToCrates = !m_crateList.isEmpty();
+    const QList<TrackId> similarTrackIds =
+            m_pLibrary->trackSimilarityIndex()->findNearest(
+                    queuedTrackIds.last(),
+                    kSimilarTrackCandidates,
+                    [&](TrackId trackId) {
+                        if (excludedTrackIds.contains(trackId)) {
+                            return false;
+                        }
+                        // Like the random selection don't pick tracks
+                        // outside of the Auto DJ crates if there are any
+                        return !restrictToCrates ||
+                                crateTrackIds.contains(
+                                        CrateStorage::trackIdIndexValue(trackId));
+                    });
+    for (const auto& trackId : similarTrackIds) {
+        TrackPointer pTrack = m_pLibrary->trackCollectionManager()->getTrackById(trackId);
+        if (pTrack && pTrack->getFileInfo().checkFileExists()) {
+            return pTrack;
+        }
+    }
+    return TrackPointer();
+}
+
 void AutoDJFeature::slotAddRandomTrack() {
     if (m_iAutoDJPlaylistId >= 0) {
         TrackPointer pRandomTrack;
+        if (m_pConfig->getValue(kRandomQueueSimilarTracksConfigKey, false)) {
+            pRandomTrack = findSimilarTrack();
+        }
         for (int failedRetrieveAttempts = 0;
                 !pRandomTrack && (failedRetrieveAttempts < 2 * kMaxRetrieveAttempts); // 2 rounds
                 ++failedRetrieveAttempts) {
@@ -10,6 +10,7 @@
 #include "library/libraryfeature.h"
 #include "library/trackset/crate/crate.h"
 #include "preferences/usersettings.h"
+#include "track/track_decl.h"
 #include "util/parented_ptr.h"
 
 class DlgAutoDJ;
@@ -70,6 +71,9 @@ class AutoDJFeature : public LibraryFeature {
     // Initialize the list of crates loaded into the auto-DJ queue.
     void constructCrateChildModel();
     void removeCrateFromAutoDj(CrateId crateId = CrateId());
+    // Returns the track that mixes best with the last queued track
+    // or nullptr if there is none.
+    TrackPointer findSimilarTrack();
 
     // The "Crates" tree-item under the "Auto DJ" tree-item.
     TreeItem* m_pCratesTreeItem;
@@ -102,7 +106,8 @@ class AutoDJFeature : public LibraryFeature {
     // Implements the context-menu item.
     void slotRemoveCrateFromAutoDj();
     void slotCrateChanged(CrateId crateId);
-    // Adds a random track from all loaded crates to the auto-DJ queue.
+    // Adds a random track from all loaded crates to the auto-DJ queue,
+    // optionally preferring one that mixes well with the last queued track.
     void slotAddRandomTrack();
     // Adds a random track from the queue upon hitting minimum number
     // of tracks in the playlist
@@ -14,6 +14,21 @@ namespace {
 
 constexpr bool sDebug = false;
 
+// The heap payload of the cells, i.e. the contents of strings
+qint64 rowPayloadBytes(const QVector<QVariant>& record) {
+    qint64 bytes = 0;
+    for (const auto& value : record) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        if (value.metaType().id() == QMetaType::QString) {
+#else
+        if (value.type() == QVariant::String) {
+#endif
+            bytes += value.toString().capacity() * qint64{sizeof(QChar)};
+        }
+    }
+    return bytes;
+}
+
 }  // namespace
 
 BaseTrackCache::BaseTrackCache(TrackCollection* pTrackCollection,
@@ -31,12 +46,23 @@ BaseTrackCache::BaseTrackCache(TrackCollection* pTrackCollection,
                   pTrackCollection, std::move(searchColumns))),
           m_bIndexBuilt(false),
           m_bIsCaching(isCaching),
+          m_trackInfoPayloadBytes(0),
+          m_trackInfoMemoryUsage(mixxx::MemoryUsage::Subsystem::LibraryTableCache),
           m_database(pTrackCollection->database()) {
+    // The recently used track is only kept for populating the columns of
+    // a row and may keep a track with its waveforms in GlobalTrackCache
+    for (const auto subsystem : {mixxx::MemoryUsage::Subsystem::Track,
+                 mixxx::MemoryUsage::Subsystem::Waveform}) {
+        m_evictorIds.push_back(mixxx::MemoryUsage::addEvictor(subsystem, [this] {
+            resetRecentTrack();
+        }));
+    }
 }
 
 BaseTrackCache::~BaseTrackCache() {
-    // Required to allow forward declarations of (managed pointer) members
-    // in header file
+    for (const int evictorId : m_evictorIds) {
+        mixxx::MemoryUsage::removeEvictor(evictorId);
+    }
 }
 
 int BaseTrackCache::columnCount() const {
@@ -82,9 +108,14 @@ void BaseTrackCache::slotTracksRemoved(const QSet<TrackId>& trackIds) {
         qDebug() << this << "slotTracksRemoved" << trackIds.size();
     }
     for (const auto& trackId : std::as_const(trackIds)) {
-        m_trackInfo.remove(trackId);
+        const auto it = m_trackInfo.constFind(trackId);
+        if (it != m_trackInfo.constEnd()) {
+            m_trackInfoPayloadBytes -= rowPayloadBytes(it.value());
+            m_trackInfo.erase(it);
+        }
         m_dirtyTracks.remove(trackId);
     }
+    updateMemoryUsage();
 }
 
 void BaseTrackCache::slotTrackDirty(TrackId trackId) {
@@ -171,11 +202,14 @@ bool BaseTrackCache::updateTrackInIndex(
         // m_trackInfo[id] will insert a QVector<QVariant> into the
         // m_trackInfo HashTable with the key "id"
         QVector<QVariant>& record = m_trackInfo[trackId];
+        m_trackInfoPayloadBytes -= rowPayloadBytes(record);
         // preallocate memory for all columns at once
         record.resize(numColumns);
         for (int i = 0; i < numColumns; ++i) {
             record[i] = getTrackValueForColumn(pTrack, i);
         }
+        m_trackInfoPayloadBytes += rowPayloadBytes(record);
+        updateMemoryUsage();
         if (m_bIsCaching) {
             replaceRecentTrack(trackId, pTrack);
         }
@@ -215,6 +249,7 @@ bool BaseTrackCache::updateIndexWithQuery(const QString& queryString) {
         //m_trackInfo[id] will insert a QVector<QVariant> into the
         //m_trackInfo HashTable with the key "id"
         QVector<QVariant>& record = m_trackInfo[trackId];
+        m_trackInfoPayloadBytes -= rowPayloadBytes(record);
         record.resize(numColumns);
 
         for (int i = 0; i < numColumns; ++i) {
@@ -227,12 +262,20 @@ bool BaseTrackCache::updateIndexWithQuery(const QString& queryString) {
                 record[i] = query.value(i);
             }
         }
+        m_trackInfoPayloadBytes += rowPayloadBytes(record);
     }
+    updateMemoryUsage();
 
     qDebug() << this << "updateIndexWithQuery took" << timer.elapsed().debugMillisWithUnit();
     return true;
 }
 
+void BaseTrackCache::updateMemoryUsage() {
+    m_trackInfoMemoryUsage.setBytes(static_cast<qint64>(m_trackInfo.size()) *
+                    (sizeof(TrackId) + m_columnCount * sizeof(QVariant)) +
+            m_trackInfoPayloadBytes);
+}
+
 void BaseTrackCache::buildIndex() {
     if (sDebug) {
         qDebug() << this << "buildIndex()";
@@ -249,6 +292,7 @@ void BaseTrackCache::buildIndex() {
     // clear the table, and keep track of what IDs we see, then delete the ones
     // we don't see.
     m_trackInfo.clear();
+    m_trackInfoPayloadBytes = 0;
     if (m_bIsCaching) {
         resetRecentTrack();
     }
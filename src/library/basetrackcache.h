@@ -9,11 +9,13 @@
 #include <QStringList>
 #include <QVector>
 #include <memory>
+#include <vector>
 
 #include "library/columncache.h"
 #include "track/track_decl.h"
 #include "track/trackid.h"
 #include "util/class.h"
+#include "util/memoryusage.h"
 #include "util/string.h"
 
 class SearchQueryParser;
@@ -92,6 +94,8 @@ class BaseTrackCache : public QObject {
     void replaceRecentTrack(TrackId trackId, TrackPointer pTrack) const;
     void resetRecentTrack() const;
 
+    void updateMemoryUsage();
+
     bool updateIndexWithQuery(const QString& query);
     void updateTrackInIndex(TrackId trackId);
     bool updateTrackInIndex(const TrackPointer& pTrack);
@@ -137,6 +141,11 @@ class BaseTrackCache : public QObject {
     bool m_bIndexBuilt;
     bool m_bIsCaching;
     QHash<TrackId, QVector<QVariant>> m_trackInfo;
+    // The contents of the strings in m_trackInfo
+    qint64 m_trackInfoPayloadBytes;
+    // Estimated size of m_trackInfo, updated by updateMemoryUsage()
+    mixxx::ScopedMemoryUsage m_trackInfoMemoryUsage;
+    std::vector<int> m_evictorIds;
     QSqlDatabase m_database;
 
     DISALLOW_COPY_AND_ASSIGN(BaseTrackCache);
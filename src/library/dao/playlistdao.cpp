@@ -170,11 +170,57 @@ QList<TrackId> PlaylistDAO::getTrackIdsInPlaylistOrder(const int playlistId) con
     return trackIds;
 }
 
+void PlaylistDAO::forEachTrackLocation(const int playlistId,
+        const std::function<void(const QString&)>& function) const {
+    QSqlQuery query(m_database);
+    query.setForwardOnly(true);
+    query.prepare(QStringLiteral(
+            "SELECT track_locations.location FROM PlaylistTracks "
+            "INNER JOIN library ON library.id = PlaylistTracks.track_id "
+            "INNER JOIN track_locations ON track_locations.id = library.location "
+            "WHERE PlaylistTracks.playlist_id = :id "
+            "ORDER BY PlaylistTracks.position ASC"));
+    query.bindValue(":id", playlistId);
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return;
+    }
+
+    while (query.next()) {
+        function(query.value(0).toString());
+    }
+}
+
 QList<TrackId> PlaylistDAO::getAutoDJTrackIds() const {
     const int iAutoDJPlaylistId = getPlaylistIdFromName(AUTODJ_TABLE);
     return getTrackIds(iAutoDJPlaylistId);
 }
 
+QList<TrackId> PlaylistDAO::getSetLogTrackIdsSince(const QDateTime& since) const {
+    QList<TrackId> trackIds;
+
+    // The most recent history playlist is the one of the current session
+    QSqlQuery query(m_database);
+    query.prepare(QStringLiteral(
+            "SELECT DISTINCT track_id FROM PlaylistTracks "
+            "WHERE playlist_id IN (SELECT id FROM Playlists WHERE hidden = :hidden) "
+            "AND (pl_datetime_added >= :since OR playlist_id = "
+            "(SELECT MAX(id) FROM Playlists WHERE hidden = :hidden))"));
+    query.bindValue(":hidden", PLHT_SET_LOG);
+    // The format of CURRENT_TIMESTAMP in SQLite
+    query.bindValue(":since", since.toUTC().toString(QStringLiteral("yyyy-MM-dd hh:mm:ss")));
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return trackIds;
+    }
+
+    const int trackIdColumn = query.record().indexOf(PLAYLISTTRACKSTABLE_TRACKID);
+    while (query.next()) {
+        trackIds.append(TrackId(query.value(trackIdColumn)));
+    }
+    return trackIds;
+}
+
 int PlaylistDAO::getPlaylistIdFromName(const QString& name) const {
     //qDebug() << "PlaylistDAO::getPlaylistIdFromName" << QThread::currentThread() << m_database.connectionName();
 
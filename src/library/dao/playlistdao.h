@@ -1,8 +1,10 @@
 #pragma once
 
+#include <QDateTime>
 #include <QHash>
 #include <QObject>
 #include <QSet>
+#include <functional>
 
 #include "library/dao/dao.h"
 #include "track/trackid.h"
@@ -76,7 +78,14 @@ class PlaylistDAO : public QObject, public virtual DAO {
     int getPlaylistId(const int index) const;
     QList<TrackId> getTrackIds(const int playlistId) const;
     QList<TrackId> getTrackIdsInPlaylistOrder(const int playlistId) const;
+    // Invokes the function with the location of each track of the playlist
+    // in playlist order while the rows are read from the database
+    void forEachTrackLocation(const int playlistId,
+            const std::function<void(const QString&)>& function) const;
     QList<TrackId> getAutoDJTrackIds() const;
+    // Get the tracks of the current history playlist and of all other history
+    // playlists that have been added since the given UTC time
+    QList<TrackId> getSetLogTrackIdsSince(const QDateTime& since) const;
     // Returns true if the playlist with playlistId is hidden
     bool isHidden(const int playlistId) const;
     // Returns the HiddenType of playlistId
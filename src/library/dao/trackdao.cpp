@@ -5,6 +5,8 @@
 #include <QFileInfo>
 #include <QThread>
 #include <QtDebug>
+#include <tuple>
+#include <vector>
 
 #ifdef __SQLITE3__
 #include <sqlite3.h>
@@ -36,7 +38,9 @@
 #include "util/fileinfo.h"
 #include "util/logger.h"
 #include "util/math.h"
+#include "util/partialcontenthash.h"
 #include "util/qt.h"
+#include "util/stringinterner.h"
 #include "util/timer.h"
 
 namespace {
@@ -428,9 +432,10 @@ void TrackDAO::addTracksPrepare() {
 
     m_pQueryTrackLocationInsert->prepare("INSERT INTO track_locations "
             "("
-            "location,directory,filename,filesize,fs_deleted,needs_verification"
+            "location,directory,filename,filesize,content_hash,fs_deleted,needs_verification"
             ") VALUES ("
-            ":location,:directory,:filename,:filesize,:fs_deleted,:needs_verification"
+            ":location,:directory,:filename,:filesize,:content_hash,:fs_deleted,"
+            ":needs_verification"
             ")");
 
     m_pQueryTrackLocationSelect->prepare("SELECT id FROM track_locations WHERE location=:location");
@@ -565,6 +570,13 @@ void TrackDAO::addTracksFinish(bool rollback) {
 
 namespace {
 
+QVariant contentHashToVariant(mixxx::cache_key_t contentHash) {
+    if (!mixxx::isValidCacheKey(contentHash)) {
+        return QVariant();
+    }
+    return QVariant(static_cast<mixxx::cache_key_signed_t>(contentHash));
+}
+
 bool insertTrackLocation(
         QSqlQuery* pTrackLocationInsert,
         const mixxx::FileInfo& fileInfo) {
@@ -573,6 +585,8 @@ bool insertTrackLocation(
     pTrackLocationInsert->bindValue(":directory", fileInfo.locationPath());
     pTrackLocationInsert->bindValue(":filename", fileInfo.fileName());
     pTrackLocationInsert->bindValue(":filesize", fileInfo.sizeInBytes());
+    pTrackLocationInsert->bindValue(":content_hash",
+            contentHashToVariant(mixxx::partialContentHash(fileInfo.location())));
     pTrackLocationInsert->bindValue(":fs_deleted", 0);
     pTrackLocationInsert->bindValue(":needs_verification", 0);
     if (pTrackLocationInsert->exec()) {
@@ -1153,6 +1167,14 @@ void TrackDAO::afterPurgingTracks(
 
 namespace {
 
+// Genres, groupings and file types are shared by many tracks. Interning
+// them lets all loaded tracks share a single copy of each string instead
+// of a copy per track. Columns with a high cardinality like artists or
+// composers are not interned, because interned strings are never released.
+QString internedValue(const QSqlRecord& record, const int column) {
+    return mixxx::StringInterner::trackMetadata().intern(record.value(column).toString());
+}
+
 typedef void (*TrackPopulatorFn)(
         const QSqlRecord& record,
         const int column,
@@ -1179,7 +1201,7 @@ void setTrackYear(const QSqlRecord& record, const int column, Track* pTrack) {
 }
 
 void setTrackGenre(const QSqlRecord& record, const int column, Track* pTrack) {
-    TrackDAO::setTrackGenreInternal(pTrack, record.value(column).toString());
+    TrackDAO::setTrackGenreInternal(pTrack, internedValue(record, column));
 }
 
 void setTrackComposer(const QSqlRecord& record, const int column, Track* pTrack) {
@@ -1187,7 +1209,7 @@ void setTrackComposer(const QSqlRecord& record, const int column, Track* pTrack)
 }
 
 void setTrackGrouping(const QSqlRecord& record, const int column, Track* pTrack) {
-    pTrack->setGrouping(record.value(column).toString());
+    pTrack->setGrouping(internedValue(record, column));
 }
 
 void setTrackNumber(const QSqlRecord& record, const int column, Track* pTrack) {
@@ -1256,7 +1278,7 @@ void setTrackDateAdded(const QSqlRecord& record, const int column, Track* pTrack
 }
 
 void setTrackFiletype(const QSqlRecord& record, const int column, Track* pTrack) {
-    pTrack->setType(record.value(column).toString());
+    pTrack->setType(internedValue(record, column));
 }
 
 void setTrackHeaderParsed(const QSqlRecord& record, const int column, Track* pTrack) {
@@ -1914,179 +1936,226 @@ bool TrackDAO::detectMovedTracks(
         return true;
     }
 
-    // Query possible successors
-    // NOTE: Successors are identified by filename and duration (in seconds).
-    // Since duration is stored as double-precision floating-point and since it
-    // is sometimes truncated to nearest integer, tolerance of 1 second is used.
-    QSqlQuery newTrackQuery(m_database);
-    newTrackQuery.prepare(QStringLiteral(
-            "SELECT library.id as %1, track_locations.id as %2, "
-            "track_locations.location "
-            "FROM library INNER JOIN track_locations ON library.location=track_locations.id "
-            "WHERE track_locations.location IN (%3) AND "
-            "filename=:filename AND "
-            "ABS(duration - :duration) < 1 AND "
-            "fs_deleted=0")
-                    .arg(
-                            TRACK_ID,
-                            LOCATION_ID,
-                            SqlStringFormatter::formatList(m_database, addedTracks)));
-
-    // Query tracks, where we need a successor for
-    QSqlQuery oldTrackQuery(m_database);
-    oldTrackQuery.prepare(QStringLiteral(
-            "SELECT library.id as %1, track_locations.id as %2, "
-            "track_locations.location, filename, duration "
-            "FROM library INNER JOIN track_locations ON library.location=track_locations.id "
-            "WHERE fs_deleted=1")
-                    .arg(TRACK_ID, LOCATION_ID));
-    if (!oldTrackQuery.exec()) {
-        LOG_FAILED_QUERY(oldTrackQuery);
+    // Query all pairs of missing and added tracks that could be the same
+    // file at once instead of looking up the successors of each missing
+    // track separately.
+    // NOTE: Successors are identified by either the partial content hash,
+    // which survives renaming and re-tagging, or the filename for tracks
+    // that have not been hashed before they went missing. In both cases
+    // the duration (in seconds) must match. Since duration is stored as
+    // double-precision floating-point and since it is sometimes truncated
+    // to nearest integer, tolerance of 1 second is used.
+    QSqlQuery candidateQuery(m_database);
+    candidateQuery.setForwardOnly(true);
+    candidateQuery.prepare(QStringLiteral(
+            "SELECT old_library.id,old_locations.id,old_locations.location,"
+            "new_library.id,new_locations.id,new_locations.location,"
+            "old_locations.content_hash=new_locations.content_hash AND "
+            "old_locations.content_hash<>0,"
+            "old_locations.filesize=new_locations.filesize "
+            "FROM track_locations AS new_locations "
+            "INNER JOIN library AS new_library "
+            "ON new_library.location=new_locations.id "
+            "INNER JOIN track_locations AS old_locations "
+            "ON (old_locations.content_hash=new_locations.content_hash AND "
+            "old_locations.content_hash<>0) "
+            "OR old_locations.filename=new_locations.filename "
+            "INNER JOIN library AS old_library "
+            "ON old_library.location=old_locations.id "
+            "WHERE new_locations.location IN (%1) AND "
+            "new_locations.fs_deleted=0 AND "
+            "old_locations.fs_deleted=1 AND "
+            "ABS(new_library.duration - old_library.duration) < 1")
+                    .arg(SqlStringFormatter::formatList(m_database, addedTracks)));
+    if (!candidateQuery.exec()) {
+        LOG_FAILED_QUERY(candidateQuery);
         DEBUG_ASSERT(!"Failed query");
         return false;
     }
-    QSqlRecord oldTrackQueryRecord = oldTrackQuery.record();
-    const int oldTrackIdColumn = oldTrackQueryRecord.indexOf(TRACK_ID);
-    const int oldLocationIdColumn = oldTrackQueryRecord.indexOf(LOCATION_ID);
-    const int oldLocationColumn = oldTrackQueryRecord.indexOf(LIBRARYTABLE_LOCATION);
-    const int filenameColumn = oldTrackQueryRecord.indexOf(TRACKLOCATIONSTABLE_FILENAME);
-    const int durationColumn = oldTrackQueryRecord.indexOf(LIBRARYTABLE_DURATION);
 
-    // For each track that's been "deleted" on disk...
-    while (oldTrackQuery.next()) {
+    struct Candidate {
+        TrackId oldTrackId;
+        DbId oldTrackLocationId;
+        QString oldTrackLocation;
+        TrackId newTrackId;
+        DbId newTrackLocationId;
+        QString newTrackLocation;
+        // Ranking in descending order of significance
+        bool contentHashMatch;
+        bool fileSizeMatch;
+        int suffixMatch;
+
+        bool operator<(const Candidate& other) const {
+            return std::tie(contentHashMatch, fileSizeMatch, suffixMatch) >
+                    std::tie(other.contentHashMatch, other.fileSizeMatch, other.suffixMatch);
+        }
+    };
+    std::vector<Candidate> candidates;
+    while (candidateQuery.next()) {
         if (*pCancel) {
             return false;
         }
-        QString oldTrackLocation = oldTrackQuery.value(oldLocationColumn).toString();
-        QString filename = oldTrackQuery.value(filenameColumn).toString();
-        // rather use duration then filesize as an indicator of changes. The filesize
-        // can change by adding more ID3v2 tags
-        const int duration = oldTrackQuery.value(durationColumn).toInt();
-
-        kLogger.info()
-                << "Looking for substitute of missing track location"
-                << oldTrackLocation;
-
-        newTrackQuery.bindValue(":filename", filename);
-        newTrackQuery.bindValue(":duration", duration);
-        if (!newTrackQuery.exec()) {
-            LOG_FAILED_QUERY(newTrackQuery);
-            DEBUG_ASSERT(!"Failed query");
+        Candidate candidate;
+        candidate.oldTrackId = TrackId(candidateQuery.value(0));
+        candidate.oldTrackLocationId = DbId(candidateQuery.value(1));
+        candidate.oldTrackLocation = candidateQuery.value(2).toString();
+        candidate.newTrackId = TrackId(candidateQuery.value(3));
+        candidate.newTrackLocationId = DbId(candidateQuery.value(4));
+        candidate.newTrackLocation = candidateQuery.value(5).toString();
+        // Comparisons with NULL are NULL and converted to false
+        candidate.contentHashMatch = candidateQuery.value(6).toBool();
+        candidate.fileSizeMatch = candidateQuery.value(7).toBool();
+        VERIFY_OR_DEBUG_ASSERT(candidate.newTrackLocation != candidate.oldTrackLocation) {
             continue;
         }
-        const auto newTrackIdColumn = newTrackQuery.record().indexOf(TRACK_ID);
-        const auto newTrackLocationIdColumn = newTrackQuery.record().indexOf(LOCATION_ID);
-        const auto newTrackLocationColumn = newTrackQuery.record().indexOf(LIBRARYTABLE_LOCATION);
-        int newTrackLocationSuffixMatch = 0;
-        TrackId newTrackId;
-        DbId newTrackLocationId;
-        QString newTrackLocation;
-        while (newTrackQuery.next()) {
-            const auto nextTrackLocation =
-                    newTrackQuery.value(newTrackLocationColumn).toString();
-            VERIFY_OR_DEBUG_ASSERT(nextTrackLocation != oldTrackLocation) {
-                continue;
-            }
-            kLogger.info()
-                    << "Found potential moved track location:"
-                    << nextTrackLocation;
-            const auto nextSuffixMatch =
-                    matchStringSuffix(nextTrackLocation, oldTrackLocation);
-            DEBUG_ASSERT(nextSuffixMatch >= filename.length());
-            // When we look for a successor for 'Music/Abba-1981-Greatest Hits/1-Waterloo.mp3'
-            // we may have multiple candidates (same name, same duration).
-            // With this suffix match ranking we'll prefer
-            // 'Music/Abba/Greatest Hits/Waterloo-1.mp3' over
-            // 'Music/Falko/Track1.mp3'
-            if (newTrackLocationSuffixMatch < nextSuffixMatch) {
-                newTrackLocationSuffixMatch = nextSuffixMatch;
-                newTrackId = TrackId(newTrackQuery.value(newTrackIdColumn));
-                newTrackLocationId = DbId(newTrackQuery.value(newTrackLocationIdColumn));
-                newTrackLocation = nextTrackLocation;
-            }
+        // When we look for a successor for 'Music/Abba-1981-Greatest Hits/1-Waterloo.mp3'
+        // we may have multiple candidates (same name, same duration).
+        // With this suffix match ranking we'll prefer
+        // 'Music/Abba/Greatest Hits/Waterloo-1.mp3' over
+        // 'Music/Falko/Track1.mp3'
+        candidate.suffixMatch = matchStringSuffix(
+                candidate.newTrackLocation, candidate.oldTrackLocation);
+        candidates.push_back(std::move(candidate));
+    }
+    kLogger.info()
+            << "Found"
+            << candidates.size()
+            << "potential moved track location(s)";
+
+    // Assign the best matches first and use each missing and each added
+    // track only once
+    std::stable_sort(candidates.begin(), candidates.end());
+    QSet<TrackId> relocatedOldTrackIds;
+    QSet<TrackId> relocatedNewTrackIds;
+
+    // The library scanner will have added a new row to the Library
+    // table which corresponds to the track in the new location. We need
+    // to remove that so we don't end up with two rows in the library
+    // table for the same track.
+    QSqlQuery deleteLibraryQuery(m_database);
+    deleteLibraryQuery.prepare(QStringLiteral("DELETE FROM library WHERE id=:newid"));
+    // Update the location foreign key for the existing row in the
+    // library table to point to the correct row in the track_locations
+    // table.
+    QSqlQuery updateLibraryQuery(m_database);
+    updateLibraryQuery.prepare(QStringLiteral(
+            "UPDATE library SET location=:newloc WHERE id=:oldid"));
+    // Remove old, orphaned row from track_locations table
+    QSqlQuery deleteLocationQuery(m_database);
+    deleteLocationQuery.prepare(QStringLiteral(
+            "DELETE FROM track_locations WHERE id=:id"));
+
+    for (auto& candidate : candidates) {
+        if (*pCancel) {
+            return false;
         }
-        if (newTrackLocation.isEmpty()) {
-            kLogger.info()
-                    << "Found no substitute for missing track location"
-                    << oldTrackLocation;
+        if (relocatedOldTrackIds.contains(candidate.oldTrackId) ||
+                relocatedNewTrackIds.contains(candidate.newTrackId)) {
             continue;
         }
-        DEBUG_ASSERT(newTrackId.isValid());
-        DEBUG_ASSERT(newTrackLocationId.isValid());
+        DEBUG_ASSERT(candidate.oldTrackId.isValid());
+        DEBUG_ASSERT(candidate.oldTrackLocationId.isValid());
+        DEBUG_ASSERT(candidate.newTrackId.isValid());
+        DEBUG_ASSERT(candidate.newTrackLocationId.isValid());
+        // The query ensures that the following assertions are always true (fs_deleted=0/1)!
+        DEBUG_ASSERT(candidate.oldTrackId != candidate.newTrackId);
+        DEBUG_ASSERT(candidate.oldTrackLocationId != candidate.newTrackLocationId);
+
         kLogger.info()
                 << "Found moved track location:"
-                << oldTrackLocation
+                << candidate.oldTrackLocation
                 << "->"
-                << newTrackLocation;
-
-        TrackId oldTrackId(oldTrackQuery.value(oldTrackIdColumn));
-        DEBUG_ASSERT(oldTrackId.isValid());
-        DbId oldTrackLocationId(oldTrackQuery.value(oldLocationIdColumn));
-        DEBUG_ASSERT(oldTrackLocationId.isValid());
-
-        // The queries ensure that the following assertions are always true (fs_deleted=0/1)!
-        DEBUG_ASSERT(oldTrackId != newTrackId);
-        DEBUG_ASSERT(oldTrackLocationId != newTrackLocationId);
-
-        auto missingTrackRef = TrackRef::fromFilePath(
-                oldTrackLocation,
-                std::move(oldTrackId));
-        auto addedTrackRef = TrackRef::fromFilePath(
-                newTrackLocation,
-                std::move(newTrackId));
-        auto relocatedTrack = RelocatedTrack(
-            std::move(missingTrackRef),
-            std::move(addedTrackRef));
-
-        // The library scanner will have added a new row to the Library
-        // table which corresponds to the track in the new location. We need
-        // to remove that so we don't end up with two rows in the library
-        // table for the same track.
-        {
-            QSqlQuery query(m_database);
-            query.prepare("DELETE FROM library WHERE id=:newid");
-            query.bindValue(":newid", relocatedTrack.deletedTrackId().toVariant());
-            if (!query.exec()) {
-                LOG_FAILED_QUERY(query);
-                // Last chance to skip this entry, i.e. nothing has been
-                // deleted or updated yet!
-                DEBUG_ASSERT(!"Failed query");
-                continue;
-            }
+                << candidate.newTrackLocation;
+
+        deleteLibraryQuery.bindValue(":newid", candidate.newTrackId.toVariant());
+        if (!deleteLibraryQuery.exec()) {
+            LOG_FAILED_QUERY(deleteLibraryQuery);
+            // Last chance to skip this entry, i.e. nothing has been
+            // deleted or updated yet!
+            DEBUG_ASSERT(!"Failed query");
+            continue;
         }
+        relocatedOldTrackIds.insert(candidate.oldTrackId);
+        relocatedNewTrackIds.insert(candidate.newTrackId);
 
-        // Update the location foreign key for the existing row in the
-        // library table to point to the correct row in the track_locations
-        // table.
-        {
-            QSqlQuery query(m_database);
-            query.prepare("UPDATE library SET location=:newloc WHERE id=:oldid");
-            query.bindValue(":newloc", newTrackLocationId.toVariant());
-            query.bindValue(":oldid", relocatedTrack.updatedTrackRef().getId().toVariant());
-            if (!query.exec()) {
-                LOG_FAILED_QUERY(query);
-                DEBUG_ASSERT(!"Failed query");
-            }
+        updateLibraryQuery.bindValue(":newloc", candidate.newTrackLocationId.toVariant());
+        updateLibraryQuery.bindValue(":oldid", candidate.oldTrackId.toVariant());
+        if (!updateLibraryQuery.exec()) {
+            LOG_FAILED_QUERY(updateLibraryQuery);
+            DEBUG_ASSERT(!"Failed query");
         }
 
-        // Remove old, orphaned row from track_locations table
-        {
-            QSqlQuery query(m_database);
-            query.prepare("DELETE FROM track_locations WHERE id=:id");
-            query.bindValue(":id", oldTrackLocationId.toVariant());
-            if (!query.exec()) {
-                LOG_FAILED_QUERY(query);
-                DEBUG_ASSERT(!"Failed query");
-            }
+        deleteLocationQuery.bindValue(":id", candidate.oldTrackLocationId.toVariant());
+        if (!deleteLocationQuery.exec()) {
+            LOG_FAILED_QUERY(deleteLocationQuery);
+            DEBUG_ASSERT(!"Failed query");
         }
 
         if (pRelocatedTracks) {
-            pRelocatedTracks->append(std::move(relocatedTrack));
+            auto missingTrackRef = TrackRef::fromFilePath(
+                    candidate.oldTrackLocation,
+                    std::move(candidate.oldTrackId));
+            auto addedTrackRef = TrackRef::fromFilePath(
+                    candidate.newTrackLocation,
+                    std::move(candidate.newTrackId));
+            pRelocatedTracks->append(RelocatedTrack(
+                    std::move(missingTrackRef),
+                    std::move(addedTrackRef)));
         }
     }
     return true;
 }
 
+void TrackDAO::updateMissingContentHashes(
+        int maxCount,
+        volatile const bool* pCancel) const {
+    // Tracks that have been added before the content hash was introduced
+    // are hashed gradually, while their files still exist. Otherwise they
+    // could only be detected by filename after they have been moved.
+    QSqlQuery selectQuery(m_database);
+    selectQuery.setForwardOnly(true);
+    selectQuery.prepare(QStringLiteral(
+            "SELECT id,location FROM track_locations "
+            "WHERE content_hash IS NULL AND fs_deleted=0 LIMIT :limit"));
+    selectQuery.bindValue(":limit", maxCount);
+    if (!selectQuery.exec()) {
+        LOG_FAILED_QUERY(selectQuery);
+        DEBUG_ASSERT(!"Failed query");
+        return;
+    }
+    QList<std::pair<DbId, QString>> trackLocations;
+    while (selectQuery.next()) {
+        trackLocations.append(std::make_pair(
+                DbId(selectQuery.value(0)),
+                selectQuery.value(1).toString()));
+    }
+
+    QSqlQuery updateQuery(m_database);
+    updateQuery.prepare(QStringLiteral(
+            "UPDATE track_locations SET content_hash=:content_hash WHERE id=:id"));
+    for (const auto& [trackLocationId, trackLocation] : std::as_const(trackLocations)) {
+        if (*pCancel) {
+            return;
+        }
+        // Files that could not be read are marked with the invalid hash 0
+        // that never matches instead of being retried over and over again
+        const auto contentHash = mixxx::partialContentHash(trackLocation);
+        updateQuery.bindValue(":content_hash",
+                static_cast<mixxx::cache_key_signed_t>(contentHash));
+        updateQuery.bindValue(":id", trackLocationId.toVariant());
+        if (!updateQuery.exec()) {
+            LOG_FAILED_QUERY(updateQuery);
+            DEBUG_ASSERT(!"Failed query");
+        }
+    }
+    if (kLogger.debugEnabled()) {
+        kLogger.debug()
+                << "Updated the content hash of"
+                << trackLocations.size()
+                << "track location(s)";
+    }
+}
+
 void TrackDAO::hideAllTracks(const QDir& rootDir) const {
     const QString locationPathPrefix = locationPathPrefixFromRootDir(rootDir);
     QSqlQuery query(m_database);
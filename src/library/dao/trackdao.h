@@ -192,6 +192,11 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     bool verifyRemainingTracks(
             const QList<mixxx::FileInfo>& libraryRootDirs,
             volatile const bool* pCancel);
+    // Hashes up to maxCount existing track locations that have no
+    // content hash yet.
+    void updateMissingContentHashes(
+            int maxCount,
+            volatile const bool* pCancel) const;
 
     void detectCoverArtForTracksWithoutCover(volatile const bool* pCancel,
                                         QSet<TrackId>* pTracksChanged);
@@ -62,6 +62,7 @@ const QString TRACKLOCATIONSTABLE_DIRECTORY = QStringLiteral("directory");
 const QString TRACKLOCATIONSTABLE_FILESIZE = QStringLiteral("filesize");
 const QString TRACKLOCATIONSTABLE_FSDELETED = QStringLiteral("fs_deleted");
 const QString TRACKLOCATIONSTABLE_NEEDSVERIFICATION = QStringLiteral("needs_verification");
+const QString TRACKLOCATIONSTABLE_CONTENTHASH = QStringLiteral("content_hash");
 
 const QString TRACK_ID = QStringLiteral("track_id");
 const QString LOCATION_ID = QStringLiteral("location_id");
@@ -30,6 +30,7 @@
 #include "library/trackset/crate/cratefeature.h"
 #include "library/trackset/playlistfeature.h"
 #include "library/trackset/setlogfeature.h"
+#include "library/tracksimilarityindex.h"
 #include "library/traktor/traktorfeature.h"
 #include "mixer/playermanager.h"
 #include "moc_library.cpp"
@@ -72,6 +73,8 @@ Library::Library(
           m_pSidebarModel(make_parented<SidebarModel>(this)),
           m_pLibraryControl(make_parented<LibraryControl>(this)),
           m_pLibraryWidget(nullptr),
+          m_playerAnalysisActive(false),
+          m_batchAnalysisThrottled(false),
           m_pKeyNotation(std::make_unique<ControlObject>(
                   mixxx::library::prefs::kKeyNotationConfigKey)) {
     qRegisterMetaType<LibraryRemovalType>("LibraryRemovalType");
@@ -81,6 +84,32 @@ Library::Library(
             this,
             &Library::slotRefreshLibraryModels);
 
+    // The similarity index reloads modified tracks lazily
+    TrackCollection* pInternalCollection = m_pTrackCollectionManager->internalCollection();
+    m_pTrackSimilarityIndex = std::make_unique<TrackSimilarityIndex>(
+            pInternalCollection->database());
+    const auto invalidateSimilarTracks = [this](const QSet<TrackId>& trackIds) {
+        m_pTrackSimilarityIndex->invalidateTracks(trackIds);
+    };
+    connect(pInternalCollection,
+            &TrackCollection::tracksAdded,
+            this,
+            invalidateSimilarTracks);
+    connect(pInternalCollection,
+            &TrackCollection::tracksChanged,
+            this,
+            invalidateSimilarTracks);
+    connect(pInternalCollection,
+            &TrackCollection::tracksRemoved,
+            this,
+            invalidateSimilarTracks);
+    connect(pInternalCollection,
+            &TrackCollection::multipleTracksChanged,
+            this,
+            [this]() {
+                m_pTrackSimilarityIndex->invalidate();
+            });
+
     // TODO(rryan) -- turn this construction / adding of features into a static
     // method or something -- CreateDefaultLibrary
     m_pMixxxLibraryFeature = make_parented<MixxxLibraryFeature>(
@@ -530,13 +559,33 @@ void Library::addFeature(LibraryFeature* feature) {
 
 void Library::onPlayerManagerTrackAnalyzerProgress(
         TrackId /*trackId*/, AnalyzerProgress /*analyzerProgress*/) {
-    if (m_pAnalysisFeature) {
-        m_pAnalysisFeature->suspendAnalysis();
+    if (m_playerAnalysisActive) {
+        return;
     }
+    m_playerAnalysisActive = true;
+    updateBatchAnalysisSuspended();
 }
 
 void Library::onPlayerManagerTrackAnalyzerIdle() {
-    if (m_pAnalysisFeature) {
+    m_playerAnalysisActive = false;
+    updateBatchAnalysisSuspended();
+}
+
+void Library::slotThrottleBatchAnalysis(bool throttle) {
+    if (m_batchAnalysisThrottled == throttle) {
+        return;
+    }
+    m_batchAnalysisThrottled = throttle;
+    updateBatchAnalysisSuspended();
+}
+
+void Library::updateBatchAnalysisSuspended() {
+    if (!m_pAnalysisFeature) {
+        return;
+    }
+    if (m_playerAnalysisActive || m_batchAnalysisThrottled) {
+        m_pAnalysisFeature->suspendAnalysis();
+    } else {
         m_pAnalysisFeature->resumeAnalysis();
     }
 }
@@ -30,6 +30,7 @@ class PlaylistFeature;
 class RecordingManager;
 class SidebarModel;
 class TrackCollectionManager;
+class TrackSimilarityIndex;
 class WSearchLineEdit;
 class WLibrarySidebar;
 class WLibrary;
@@ -63,6 +64,12 @@ class Library: public QObject {
 
     TrackCollectionManager* trackCollectionManager() const;
 
+    /// Finds tracks in the internal collection that mix well with each
+    /// other. Must only be used from the main thread.
+    TrackSimilarityIndex* trackSimilarityIndex() const {
+        return m_pTrackSimilarityIndex.get();
+    }
+
     TrackAnalysisScheduler::Pointer createTrackAnalysisScheduler(
             int numWorkerThreads,
             AnalyzerModeFlags modeFlags) const;
@@ -139,6 +146,9 @@ class Library: public QObject {
     void onSkinLoadFinished();
     void slotSaveCurrentViewState() const;
     void slotRestoreCurrentViewState() const;
+    /// Suspends the batch analysis while the audio engine is overloaded,
+    /// see mixxx::QualityGovernor.
+    void slotThrottleBatchAnalysis(bool throttle);
 
   signals:
     void showTrackModel(QAbstractItemModel* model, bool restoreState = true);
@@ -182,6 +192,8 @@ class Library: public QObject {
       void onPlayerManagerTrackAnalyzerIdle();
 
   private:
+    void updateBatchAnalysisSuspended();
+
     const UserSettingsPointer m_pConfig;
 
     // The Mixxx database connection pool
@@ -189,6 +201,8 @@ class Library: public QObject {
 
     const QPointer<TrackCollectionManager> m_pTrackCollectionManager;
 
+    std::unique_ptr<TrackSimilarityIndex> m_pTrackSimilarityIndex;
+
     parented_ptr<SidebarModel> m_pSidebarModel;
     parented_ptr<LibraryControl> m_pLibraryControl;
 
@@ -204,5 +218,8 @@ class Library: public QObject {
     QFont m_trackTableFont;
     int m_iTrackTableRowHeight;
     bool m_editMetadataSelectedClick;
+    // The batch analysis is suspended if any of these is set
+    bool m_playerAnalysisActive;
+    bool m_batchAnalysisThrottled;
     std::unique_ptr<ControlObject> m_pKeyNotation;
 };
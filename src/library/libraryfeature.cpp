@@ -66,21 +66,32 @@ QStringList LibraryFeature::getPlaylistFiles(QFileDialog::FileMode mode) const {
 bool LibraryFeature::exportPlaylistItemsIntoFile(
         QString playlistFilePath,
         const QList<QString>& playlistItemLocations,
-        bool useRelativePath)    {
+        bool useRelativePath) {
+    return exportPlaylistItemsIntoFile(
+            std::move(playlistFilePath),
+            Parser::forEachLocationOf(playlistItemLocations),
+            useRelativePath);
+}
+
+bool LibraryFeature::exportPlaylistItemsIntoFile(
+        QString playlistFilePath,
+        const Parser::ForEachLocation& forEachPlaylistItemLocation,
+        bool useRelativePath) {
     if (playlistFilePath.endsWith(
             QStringLiteral(".pls"),
             Qt::CaseInsensitive)) {
         return ParserPls::writePLSFile(
                 playlistFilePath,
-                playlistItemLocations,
+                forEachPlaylistItemLocation,
                 useRelativePath);
     } else if (playlistFilePath.endsWith(
             QStringLiteral(".m3u8"),
             Qt::CaseInsensitive)) {
-        return ParserM3u::writeM3U8File(
+        return ParserM3u::writeM3UFile(
                 playlistFilePath,
-                playlistItemLocations,
-                useRelativePath);
+                forEachPlaylistItemLocation,
+                useRelativePath,
+                true);
     } else {
         //default export to M3U if file extension is missing
         if (!playlistFilePath.endsWith(
@@ -105,7 +116,8 @@ bool LibraryFeature::exportPlaylistItemsIntoFile(
         }
         return ParserM3u::writeM3UFile(
                 playlistFilePath,
-                playlistItemLocations,
-                useRelativePath);
+                forEachPlaylistItemLocation,
+                useRelativePath,
+                false);
     }
 }
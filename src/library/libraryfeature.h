@@ -10,6 +10,7 @@
 
 #include "library/coverartcache.h"
 #include "library/dao/trackdao.h"
+#include "library/parser.h"
 #include "library/treeitemmodel.h"
 #include "track/track_decl.h"
 #ifdef __STEM__
@@ -177,6 +178,10 @@ class LibraryFeature : public QObject {
             QString playlistFilePath,
             const QList<QString>& playlistItemLocations,
             bool useRelativePath);
+    static bool exportPlaylistItemsIntoFile(
+            QString playlistFilePath,
+            const Parser::ForEachLocation& forEachPlaylistItemLocation,
+            bool useRelativePath);
 
   private:
     QStringList getPlaylistFiles(QFileDialog::FileMode mode) const;
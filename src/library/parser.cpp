@@ -2,11 +2,13 @@
 
 #include <QDir>
 #include <QUrl>
+#include <QtConcurrentMap>
 #include <QtDebug>
 
 #include "library/parsercsv.h"
 #include "library/parserm3u.h"
 #include "library/parserpls.h"
+#include "util/assert.h"
 
 // static
 bool Parser::isPlaylistFilenameSupported(const QString& playlistFile) {
@@ -38,11 +40,28 @@ QList<QString> Parser::parse(const QString& playlistFile) {
 
     QFileInfo fileInfo(playlistFile);
 
-    QList<QString> existingLocations;
+    QList<mixxx::FileInfo> trackFiles;
+    trackFiles.reserve(allLocations.size());
     for (const auto& location : allLocations) {
-        mixxx::FileInfo trackFile = Parser::playlistEntryToFileInfo(
-                location, fileInfo.canonicalPath());
-        if (trackFile.checkFileExists()) {
+        trackFiles.append(Parser::playlistEntryToFileInfo(
+                location, fileInfo.canonicalPath()));
+    }
+
+    // Checking the existence of each file dominates the import of large
+    // playlists, especially from network storage. The checks are
+    // independent of each other and are executed in parallel.
+    const QList<bool> trackFilesExist = QtConcurrent::blockingMapped<QList<bool>>(
+            trackFiles,
+            [](const mixxx::FileInfo& trackFile) {
+                return trackFile.checkFileExists();
+            });
+    DEBUG_ASSERT(trackFilesExist.size() == trackFiles.size());
+
+    QList<QString> existingLocations;
+    existingLocations.reserve(trackFiles.size());
+    for (int i = 0; i < trackFiles.size(); ++i) {
+        const mixxx::FileInfo& trackFile = trackFiles.at(i);
+        if (trackFilesExist.at(i)) {
             existingLocations.append(trackFile.location());
         } else {
             qInfo() << "File" << trackFile.location() << "from playlist"
@@ -22,11 +22,26 @@ it afterwards for proper functioning
 
 #include <QList>
 #include <QString>
+#include <functional>
 
 #include "util/fileinfo.h"
 
 class Parser {
   public:
+    /// Invokes the given function with each location of an exported
+    /// playlist in order, e.g. while the locations are read from the
+    /// database. Exporting doesn't need to hold all locations in memory.
+    typedef std::function<void(const std::function<void(const QString&)>&)>
+            ForEachLocation;
+
+    static ForEachLocation forEachLocationOf(const QList<QString>& locations) {
+        return [&locations](const std::function<void(const QString&)>& function) {
+            for (const auto& location : locations) {
+                function(location);
+            }
+        };
+    }
+
     static bool isPlaylistFilenameSupported(const QString& playlistFile);
     static QList<QString> parseAllLocations(const QString& playlistFile);
     static QList<QString> parse(const QString& playlistFile);
@@ -98,61 +98,69 @@ bool ParserM3u::writeM3U8File(const QString &file_str, const QList<QString> &ite
     return writeM3UFile(file_str, items, useRelativePath, true);
 }
 
-bool ParserM3u::writeM3UFile(const QString &file_str, const QList<QString> &items, bool useRelativePath, bool useUtf8)
-{
+bool ParserM3u::writeM3UFile(const QString &file_str, const QList<QString> &items, bool useRelativePath, bool useUtf8) {
+    return writeM3UFile(file_str, forEachLocationOf(items), useRelativePath, useUtf8);
+}
+
+bool ParserM3u::writeM3UFile(const QString& file_str,
+        const ForEachLocation& forEachLocation,
+        bool useRelativePath,
+        bool useUtf8) {
     // Important note:
     // On Windows \n will produce a <CR><CL> (=\r\n)
     // On Linux and OS X \n is <CR> (which remains \n)
     bool urlEncodingUsed = false;
     QDir baseDirectory(QFileInfo(file_str).canonicalPath());
+    // FIXME: replace deprecated QTextCodec with direct usage of libicu
     QTextCodec* codec = QTextCodec::codecForName(kStandardM3uTextEncoding);
-    QString fileContents(QStringLiteral("#EXTM3U\n"));
-    for (const QString& item : items) {
-        fileContents += QStringLiteral("#EXTINF\n");
+
+    QFile file(file_str);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        ErrorDialogHandler* pDialogHandler = ErrorDialogHandler::instance();
+        ErrorDialogProperties* props = pDialogHandler->newDialogProperties();
+        props->setType(DLG_WARNING);
+        props->setTitle(QObject::tr("Playlist Export Failed"));
+        props->setText(QObject::tr("Could not create file") + " " + file_str);
+        props->setDetails(file.errorString());
+        pDialogHandler->requestErrorDialog(props);
+        return false;
+    }
+    const auto writeLine = [&file, codec, useUtf8](const QString& line) {
+        if (useUtf8) {
+            file.write(line.toUtf8());
+        } else {
+            file.write(codec->fromUnicode(line));
+        }
+        file.write("\n");
+    };
+
+    writeLine(QStringLiteral("#EXTM3U"));
+    forEachLocation([&](const QString& item) {
+        writeLine(QStringLiteral("#EXTINF"));
         if (useUtf8) {
             if (useRelativePath) {
-                fileContents += baseDirectory.relativeFilePath(item) + QStringLiteral("\n");
+                writeLine(baseDirectory.relativeFilePath(item));
             } else {
-                fileContents += item + QStringLiteral("\n");
+                writeLine(item);
             }
         } else {
             QByteArray trackByteArray = codec->fromUnicode(item);
             QString trackName = codec->toUnicode(trackByteArray);
             if (trackName == item) {
                 if (useRelativePath) { //Issue: URL Location is not working properly for Relative Paths
-                    fileContents += baseDirectory.relativeFilePath(item) + QStringLiteral("\n");
+                    writeLine(baseDirectory.relativeFilePath(item));
                 } else {
-                    fileContents += item + QStringLiteral("\n");
+                    writeLine(item);
                 }
             } else {
                 QUrl itemUrl = QUrl::fromLocalFile(item);
-                QString itemUrlEncoded = itemUrl.toEncoded();
-                fileContents += itemUrlEncoded + QStringLiteral("\n");
+                writeLine(QString(itemUrl.toEncoded()));
                 urlEncodingUsed = true;
             }
         }
-    }
-
-    QByteArray outputByteArray;
-    if (useUtf8) {
-        outputByteArray = fileContents.toUtf8();
-    } else {
-        // FIXME: replace deprecated QTextCodec with direct usage of libicu
-        outputByteArray = QTextCodec::codecForName(kStandardM3uTextEncoding)
-                                  ->fromUnicode(fileContents);
-    }
+    });
+    file.close();
 
-    QFile file(file_str);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        ErrorDialogHandler* pDialogHandler = ErrorDialogHandler::instance();
-        ErrorDialogProperties* props = pDialogHandler->newDialogProperties();
-        props->setType(DLG_WARNING);
-        props->setTitle(QObject::tr("Playlist Export Failed"));
-        props->setText(QObject::tr("Could not create file") + " " + file_str);
-        props->setDetails(file.errorString());
-        pDialogHandler->requestErrorDialog(props);
-        return false;
-    }
     if (urlEncodingUsed) {
         QMessageBox::information(nullptr,
                 QObject::tr("Playlist Export Has Special Characters"),
@@ -160,8 +168,6 @@ bool ParserM3u::writeM3UFile(const QString &file_str, const QList<QString> &item
                             "These file paths will be encoded as absolute path URLs. "
                             "Please select the m3u8 format for better and lossless exporting."));
     }
-    file.write(outputByteArray);
-    file.close();
 
     return true;
 }
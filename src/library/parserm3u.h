@@ -25,4 +25,9 @@ class ParserM3u : public Parser {
     static bool writeM3UFile(const QString &file_str, const QList<QString> &items, bool useRelativePath, bool useUtf8);
     static bool writeM3UFile(const QString &file, const QList<QString> &items, bool useRelativePath);
     static bool writeM3U8File(const QString &file_str, const QList<QString> &items, bool useRelativePath);
+    /// Writes each location as soon as it is provided
+    static bool writeM3UFile(const QString& file_str,
+            const ForEachLocation& forEachLocation,
+            bool useRelativePath,
+            bool useUtf8);
 };
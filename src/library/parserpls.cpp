@@ -78,6 +78,12 @@ QList<QString> ParserPls::parseAllLocations(const QString& playlistFile) {
 
 bool ParserPls::writePLSFile(const QString &file_str, const QList<QString> &items, bool useRelativePath)
 {
+    return writePLSFile(file_str, forEachLocationOf(items), useRelativePath);
+}
+
+bool ParserPls::writePLSFile(const QString& file_str,
+        const ForEachLocation& forEachLocation,
+        bool useRelativePath) {
     QFile file(file_str);
     if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
         ErrorDialogHandler* pDialogHandler = ErrorDialogHandler::instance();
@@ -95,17 +101,21 @@ bool ParserPls::writePLSFile(const QString &file_str, const QList<QString> &item
 
     QTextStream out(&file);
     out << "[playlist]\n";
-    out << "NumberOfEntries=" << items.size() << "\n";
-    for (int i = 0; i < items.size(); ++i) {
+    int numberOfEntries = 0;
+    forEachLocation([&](const QString& item) {
         //Write relative path if possible
         if (useRelativePath) {
             //QDir::relativePath() will return the absolutePath if it cannot compute the
             //relative Path
-            out << "File" << i << "=" << base_dir.relativeFilePath(items.at(i)) << "\n";
+            out << "File" << numberOfEntries << "=" << base_dir.relativeFilePath(item) << "\n";
         } else {
-            out << "File" << i << "=" << items.at(i) << "\n";
+            out << "File" << numberOfEntries << "=" << item << "\n";
         }
-    }
+        ++numberOfEntries;
+    });
+    // The number of entries is only known after all entries have been
+    // written. The order of the keys doesn't matter.
+    out << "NumberOfEntries=" << numberOfEntries << "\n";
 
     return true;
 }
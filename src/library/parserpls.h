@@ -23,4 +23,8 @@ class ParserPls : public Parser {
     static QList<QString> parseAllLocations(const QString& playlistFile);
     /// Playlist Export
     static bool writePLSFile(const QString &file, const QList<QString> &items, bool useRelativePath);
+    /// Writes each location as soon as it is provided
+    static bool writePLSFile(const QString& file_str,
+            const ForEachLocation& forEachLocation,
+            bool useRelativePath);
 };
@@ -23,6 +23,11 @@ namespace {
 // TODO(rryan) make configurable
 constexpr int kScannerThreadPoolSize = 1;
 
+// Limits the additional file I/O for hashing the files of tracks that
+// have been added by a previous version. Large libraries are hashed
+// gradually over multiple scans.
+constexpr int kMaxContentHashesPerScan = 5000;
+
 mixxx::Logger kLogger("LibraryScanner");
 
 QAtomicInt s_instanceCounter(0);
@@ -379,6 +384,11 @@ void LibraryScanner::cleanUpScan() {
         }
     }
 
+    kLogger.debug() << "Hashing the content of existing files";
+    m_trackDao.updateMissingContentHashes(
+            kMaxContentHashesPerScan,
+            m_scannerGlobal->shouldCancelPointer());
+
     // Remove the hashes for any directories that have been marked as
     // deleted to clean up. We need to do this otherwise we can skip over
     // songs if you move a set of songs from directory A to B, then back to
@@ -6,7 +6,7 @@
 #include "library/dao/trackschema.h"
 #include "library/queryutil.h"
 #include "library/trackset/crate/crateschema.h"
-#include "library/trackset/crate/cratestorage.h" // for CrateTrackSelectResult
+#include "library/trackset/crate/cratestorage.h"
 #include "track/keyutils.h"
 #include "track/track.h"
 #include "util/db/dbconnection.h"
@@ -105,6 +105,22 @@ QString concatSqlClauses(
     }
 }
 
+// Up to this number of track ids are inlined into the SQL statement
+// instead of selecting them from the crate tables for every row.
+constexpr quint64 kMaxInlinedTrackIds = 10000;
+
+QString formatTrackIdsInSql(const mixxx::RoaringBitmap& trackIds) {
+    if (trackIds.isEmpty()) {
+        return QStringLiteral("FALSE");
+    }
+    QStringList ids;
+    ids.reserve(static_cast<int>(trackIds.cardinality()));
+    trackIds.forEach([&ids](quint32 id) {
+        ids.append(QString::number(id));
+    });
+    return QStringLiteral("id IN (%1)").arg(ids.join(QChar(',')));
+}
+
 } // namespace
 
 bool AndNode::match(const TrackPointer& pTrack) const {
@@ -119,9 +135,35 @@ bool AndNode::match(const TrackPointer& pTrack) const {
 }
 
 QString AndNode::toSql() const {
+    // Intersect the children with known track ids in memory instead of
+    // letting the database evaluate each of them separately, e.g. for
+    // multiple crate filters.
+    std::optional<mixxx::RoaringBitmap> matchingTrackIds;
+    int matchingTrackIdsNodes = 0;
+    for (const auto& pNode : m_nodes) {
+        const mixxx::RoaringBitmap* pTrackIds = pNode->matchingTrackIds();
+        if (!pTrackIds) {
+            continue;
+        }
+        if (matchingTrackIds) {
+            *matchingTrackIds &= *pTrackIds;
+        } else {
+            matchingTrackIds = *pTrackIds;
+        }
+        ++matchingTrackIdsNodes;
+    }
+    const bool intersectTrackIds = matchingTrackIdsNodes > 1 &&
+            matchingTrackIds->cardinality() <= kMaxInlinedTrackIds;
+
     QStringList queryFragments;
     queryFragments.reserve(static_cast<int>(m_nodes.size()));
+    if (intersectTrackIds) {
+        queryFragments << formatTrackIdsInSql(*matchingTrackIds);
+    }
     for (const auto& pNode : m_nodes) {
+        if (intersectTrackIds && pNode->matchingTrackIds()) {
+            continue;
+        }
         QString sql = pNode->toSql();
         if (!sql.isEmpty()) {
             queryFragments << sql;
@@ -254,52 +296,55 @@ QString NullOrEmptyTextFilterNode::toSql() const {
 CrateFilterNode::CrateFilterNode(const CrateStorage* pCrateStorage,
         const QString& crateNameLike)
         : m_pCrateStorage(pCrateStorage),
-          m_crateNameLike(crateNameLike),
-          m_matchInitialized(false) {
+          m_crateNameLike(crateNameLike) {
 }
 
-bool CrateFilterNode::match(const TrackPointer& pTrack) const {
-    if (!m_matchInitialized) {
-        CrateTrackSelectResult crateTracks(
-                m_pCrateStorage->selectTracksSortedByCrateNameLike(m_crateNameLike));
-
-        while (crateTracks.next()) {
-            m_matchingTrackIds.push_back(crateTracks.trackId());
-        }
-
-        m_matchInitialized = true;
+const mixxx::RoaringBitmap* CrateFilterNode::matchingTrackIds() const {
+    if (!m_matchingTrackIds) {
+        m_matchingTrackIds = m_pCrateStorage->collectTrackIdsByCrateNameLike(
+                m_crateNameLike);
     }
+    return &*m_matchingTrackIds;
+}
 
-    return std::binary_search(m_matchingTrackIds.begin(), m_matchingTrackIds.end(), pTrack->getId());
+bool CrateFilterNode::match(const TrackPointer& pTrack) const {
+    const TrackId trackId = pTrack->getId();
+    return trackId.isValid() &&
+            matchingTrackIds()->contains(CrateStorage::trackIdIndexValue(trackId));
 }
 
 QString CrateFilterNode::toSql() const {
+    const mixxx::RoaringBitmap& trackIds = *matchingTrackIds();
+    if (trackIds.cardinality() <= kMaxInlinedTrackIds) {
+        return formatTrackIdsInSql(trackIds);
+    }
     return QString("id IN (%1)")
             .arg(m_pCrateStorage->formatQueryForTrackIdsByCrateNameLike(
                     m_crateNameLike));
 }
 
 NoCrateFilterNode::NoCrateFilterNode(const CrateStorage* pCrateStorage)
-        : m_pCrateStorage(pCrateStorage),
-          m_matchInitialized(false) {
+        : m_pCrateStorage(pCrateStorage) {
 }
 
-bool NoCrateFilterNode::match(const TrackPointer& pTrack) const {
-    if (!m_matchInitialized) {
-        TrackSelectResult tracks(
-                m_pCrateStorage->selectAllTracksSorted());
-
-        while (tracks.next()) {
-            m_matchingTrackIds.push_back(tracks.trackId());
-        }
-
-        m_matchInitialized = true;
+const mixxx::RoaringBitmap& NoCrateFilterNode::trackIdsWithCrate() const {
+    if (!m_trackIdsWithCrate) {
+        m_trackIdsWithCrate = m_pCrateStorage->collectTrackIdsWithCrate();
     }
+    return *m_trackIdsWithCrate;
+}
 
-    return !std::binary_search(m_matchingTrackIds.begin(), m_matchingTrackIds.end(), pTrack->getId());
+bool NoCrateFilterNode::match(const TrackPointer& pTrack) const {
+    const TrackId trackId = pTrack->getId();
+    return !trackId.isValid() ||
+            !trackIdsWithCrate().contains(CrateStorage::trackIdIndexValue(trackId));
 }
 
 QString NoCrateFilterNode::toSql() const {
+    const mixxx::RoaringBitmap& trackIds = trackIdsWithCrate();
+    if (trackIds.cardinality() <= kMaxInlinedTrackIds) {
+        return QStringLiteral("NOT (%1)").arg(formatTrackIdsInSql(trackIds));
+    }
     return QString("%1 NOT IN (%2)")
             .arg(CRATETABLE_ID,
                     CrateStorage::formatQueryForTrackIdsWithCrate());
@@ -7,12 +7,14 @@
 #include <QString>
 #include <QStringList>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
 #include "proto/keys.pb.h"
 #include "track/track_decl.h"
 #include "util/assert.h"
+#include "util/roaringbitmap.h"
 
 class CrateStorage;
 class TrackId;
@@ -32,6 +34,13 @@ class QueryNode {
     virtual bool match(const TrackPointer& pTrack) const = 0;
     virtual QString toSql() const = 0;
 
+    /// Returns the ids of all matching tracks if they are known without
+    /// querying the database, e.g. from the in-memory crate index. Group
+    /// nodes use them to combine their children before generating SQL.
+    virtual const mixxx::RoaringBitmap* matchingTrackIds() const {
+        return nullptr;
+    }
+
   protected:
     QueryNode() = default;
 };
@@ -117,11 +126,12 @@ class CrateFilterNode : public QueryNode {
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
 
+    const mixxx::RoaringBitmap* matchingTrackIds() const override;
+
   private:
     const CrateStorage* m_pCrateStorage;
     QString m_crateNameLike;
-    mutable bool m_matchInitialized;
-    mutable std::vector<TrackId> m_matchingTrackIds;
+    mutable std::optional<mixxx::RoaringBitmap> m_matchingTrackIds;
 };
 
 class NoCrateFilterNode : public QueryNode {
@@ -132,10 +142,10 @@ class NoCrateFilterNode : public QueryNode {
     QString toSql() const override;
 
   private:
+    const mixxx::RoaringBitmap& trackIdsWithCrate() const;
+
     const CrateStorage* m_pCrateStorage;
-    QString m_crateNameLike;
-    mutable bool m_matchInitialized;
-    mutable std::vector<TrackId> m_matchingTrackIds;
+    mutable std::optional<mixxx::RoaringBitmap> m_trackIdsWithCrate;
 };
 
 class NumericFilterNode : public QueryNode {
@@ -193,6 +203,9 @@ class BpmFilterNode : public QueryNode {
   public:
     static constexpr double kRelativeRangeDefault = 0.06;
     static void setBpmRelativeRange(double range);
+    static double bpmRelativeRange() {
+        return s_relativeRange;
+    }
 
     BpmFilterNode(
             QString& argument,
@@ -403,6 +403,7 @@ bool TrackCollection::purgeTracks(
     // Post-processing
     // TODO(XXX): Move signals from TrackDAO to TrackCollection
     m_trackDao.afterPurgingTracks(trackIds);
+    m_crates.afterPurgingTracks(trackIds);
 
     // Emit signal(s)
     // TODO(XXX): Emit signals here instead of from DAOs
@@ -490,6 +491,7 @@ bool TrackCollection::deleteCrate(
     VERIFY_OR_DEBUG_ASSERT(transaction.commit()) {
         return false;
     }
+    m_crates.afterDeletingCrate(crateId);
 
     // Emit signals
     emit crateDeleted(crateId);
@@ -513,6 +515,7 @@ bool TrackCollection::addCrateTracks(
     VERIFY_OR_DEBUG_ASSERT(transaction.commit()) {
         return false;
     }
+    m_crates.afterAddingCrateTracks(crateId, trackIds);
 
     // Emit signals
     emit crateTracksChanged(crateId, trackIds, QList<TrackId>());
@@ -536,6 +539,7 @@ bool TrackCollection::removeCrateTracks(
     VERIFY_OR_DEBUG_ASSERT(transaction.commit()) {
         return false;
     }
+    m_crates.afterRemovingCrateTracks(crateId, trackIds);
 
     // Emit signals
     emit crateTracksChanged(crateId, QList<TrackId>(), trackIds);
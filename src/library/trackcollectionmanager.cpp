@@ -33,6 +33,19 @@ parented_ptr<TrackCollection> createInternalTrackCollection(
     return make_parented<TrackCollection>(parent, pConfig);
 }
 
+void logTrackMetadataExportFailure(const Track& track) {
+    const auto fileInfo = track.getFileInfo();
+    if (fileInfo.checkFileExists()) {
+        kLogger.warning()
+                << "Failed to export track metadata"
+                << fileInfo.location();
+    } else {
+        kLogger.warning()
+                << "Failed to export track metadata into missing file"
+                << fileInfo.location();
+    }
+}
+
 } // anonymous namespace
 
 TrackCollectionManager::TrackCollectionManager(
@@ -208,6 +221,28 @@ void TrackCollectionManager::saveEvictedTrack(Track* pTrack) noexcept {
     saveTrack(pTrack, TrackMetadataExportMode::Immediate);
 }
 
+bool TrackCollectionManager::needsMetadataExport(Track* pTrack) noexcept {
+    return isMetadataExportRequested(pTrack);
+}
+
+// Invoked from the writer thread of GlobalTrackCache
+ExportTrackMetadataResult TrackCollectionManager::exportEvictedTrackMetadata(
+        Track* pTrack) noexcept {
+    const auto result = SoundSourceProxy::exportTrackMetadataBeforeSaving(
+            pTrack,
+            SyncTrackMetadataParams::readFromUserSettings(*m_pConfig));
+    if (result == ExportTrackMetadataResult::Failed) {
+        logTrackMetadataExportFailure(*pTrack);
+    }
+    return result;
+}
+
+void TrackCollectionManager::saveExportedTrack(
+        Track* pTrack,
+        ExportTrackMetadataResult exportResult) noexcept {
+    saveTrackAfterMetadataExport(pTrack, exportResult);
+}
+
 TrackCollectionManager::SaveTrackResult TrackCollectionManager::saveTrack(
         Track* pTrack,
         TrackMetadataExportMode mode) const {
@@ -221,8 +256,14 @@ TrackCollectionManager::SaveTrackResult TrackCollectionManager::saveTrack(
     // status. An unmodified track might have been marked for metadata
     // export by the user or export of metadata was deferred during a
     // previous invocation.
-    const auto exportTrackMetadataResult =
-            exportTrackMetadataBeforeSaving(pTrack, mode);
+    return saveTrackAfterMetadataExport(pTrack,
+            exportTrackMetadataBeforeSaving(pTrack, mode));
+}
+
+TrackCollectionManager::SaveTrackResult TrackCollectionManager::saveTrackAfterMetadataExport(
+        Track* pTrack,
+        ExportTrackMetadataResult exportTrackMetadataResult) const {
+    DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
     DEBUG_ASSERT(
             exportTrackMetadataResult != ExportTrackMetadataResult::Succeeded ||
             pTrack->getSourceSynchronizedAt().isValid());
@@ -261,9 +302,10 @@ TrackCollectionManager::SaveTrackResult TrackCollectionManager::saveTrack(
         return SaveTrackResult::Skipped;
     }
 
-    // This operation must be executed synchronously while the cache is
-    // locked to prevent that a new track is created from outdated
-    // metadata in the database before saving has finished.
+    // This operation must be executed synchronously while lookups of
+    // this track in the cache are suspended to prevent that a new track
+    // is created from outdated metadata in the database before saving
+    // has finished.
     kLogger.debug()
             << "Saving track"
             << pTrack->getLocation()
@@ -294,6 +336,18 @@ TrackCollectionManager::SaveTrackResult TrackCollectionManager::saveTrack(
     return SaveTrackResult::Saved;
 }
 
+bool TrackCollectionManager::isMetadataExportRequested(Track* pTrack) const {
+    // Write audio meta data, if explicitly requested by the user
+    // for individual tracks or enabled in the preferences for all
+    // tracks.
+    return pTrack->isMarkedForMetadataExport() ||
+            (pTrack->isDirty() &&
+                    m_pConfig &&
+                    m_pConfig->getValueString(
+                                     mixxx::library::prefs::kSyncTrackMetadataConfigKey)
+                                    .toInt() == 1);
+}
+
 ExportTrackMetadataResult TrackCollectionManager::exportTrackMetadataBeforeSaving(
         Track* pTrack,
         TrackMetadataExportMode mode) const {
@@ -301,20 +355,11 @@ ExportTrackMetadataResult TrackCollectionManager::exportTrackMetadataBeforeSavin
         return ExportTrackMetadataResult::Skipped;
     }
 
-    // Write audio meta data, if explicitly requested by the user
-    // for individual tracks or enabled in the preferences for all
-    // tracks.
-    //
     // This must be done before updating the database, because
     // a timestamp is used to keep track of when metadata has been
     // last synchronized. Exporting metadata will update this time
     // stamp on the track object!
-    if (pTrack->isMarkedForMetadataExport() ||
-            (pTrack->isDirty() &&
-                    m_pConfig &&
-                    m_pConfig->getValueString(
-                                     mixxx::library::prefs::kSyncTrackMetadataConfigKey)
-                                    .toInt() == 1)) {
+    if (isMetadataExportRequested(pTrack)) {
         switch (mode) {
         case TrackMetadataExportMode::Immediate: {
             // Export track metadata now by saving as file tags.
@@ -322,16 +367,7 @@ ExportTrackMetadataResult TrackCollectionManager::exportTrackMetadataBeforeSavin
                     pTrack,
                     SyncTrackMetadataParams::readFromUserSettings(*m_pConfig));
             if (result == ExportTrackMetadataResult::Failed) {
-                const auto fileInfo = pTrack->getFileInfo();
-                if (fileInfo.checkFileExists()) {
-                    kLogger.warning()
-                            << "Failed to export track metadata"
-                            << fileInfo.location();
-                } else {
-                    kLogger.warning()
-                            << "Failed to export track metadata into missing file"
-                            << fileInfo.location();
-                }
+                logTrackMetadataExportFailure(*pTrack);
             }
             return result;
         }
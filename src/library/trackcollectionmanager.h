@@ -112,8 +112,13 @@ class TrackCollectionManager: public QObject,
     void afterTracksUpdated(const QSet<TrackId>& updatedTrackIds) const;
     void afterTracksRelocated(const QList<RelocatedTrack>& relocatedTracks) const;
 
-    // Callback for GlobalTrackCache
+    // Callbacks for GlobalTrackCache
     void saveEvictedTrack(Track* pTrack) noexcept override;
+    bool needsMetadataExport(Track* pTrack) noexcept override;
+    ExportTrackMetadataResult exportEvictedTrackMetadata(Track* pTrack) noexcept override;
+    void saveExportedTrack(
+            Track* pTrack,
+            ExportTrackMetadataResult exportResult) noexcept override;
 
     // Might be called from any thread
     enum class TrackMetadataExportMode {
@@ -123,6 +128,10 @@ class TrackCollectionManager: public QObject,
     SaveTrackResult saveTrack(
             Track* pTrack,
             TrackMetadataExportMode mode) const;
+    SaveTrackResult saveTrackAfterMetadataExport(
+            Track* pTrack,
+            ExportTrackMetadataResult exportTrackMetadataResult) const;
+    bool isMetadataExportRequested(Track* pTrack) const;
     ExportTrackMetadataResult exportTrackMetadataBeforeSaving(
             Track* pTrack,
             TrackMetadataExportMode mode) const;
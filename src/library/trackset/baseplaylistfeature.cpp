@@ -4,7 +4,7 @@
 #include <QFileInfo>
 #include <QInputDialog>
 #include <QList>
-#include <QSqlTableModel>
+#include <QSqlQuery>
 #include <QStandardPaths>
 
 #include "library/export/trackexportwizard.h"
@@ -13,6 +13,7 @@
 #include "library/parser.h"
 #include "library/parsercsv.h"
 #include "library/playlisttablemodel.h"
+#include "library/queryutil.h"
 #include "library/trackcollection.h"
 #include "library/trackcollectionmanager.h"
 #include "library/treeitem.h"
@@ -42,14 +43,12 @@ BasePlaylistFeature::BasePlaylistFeature(
         PlaylistTableModel* pModel,
         const QString& rootViewName,
         const QString& iconName,
-        const QString& countsDurationTableName,
         bool keepHiddenTracks)
         : BaseTrackSetFeature(pLibrary, pConfig, rootViewName, iconName),
           m_playlistDao(pLibrary->trackCollectionManager()
                                 ->internalCollection()
                                 ->getPlaylistDAO()),
           m_pPlaylistTableModel(pModel),
-          m_countsDurationTableName(countsDurationTableName),
           m_keepHiddenTracks(keepHiddenTracks) {
     pModel->setParent(this);
 
@@ -166,6 +165,37 @@ void BasePlaylistFeature::initActions() {
 }
 
 void BasePlaylistFeature::connectPlaylistDAO() {
+    // Connected first to drop outdated summaries before the sidebar
+    // items are updated by the slots below
+    connect(&m_playlistDao,
+            &PlaylistDAO::deleted,
+            this,
+            &BasePlaylistFeature::slotInvalidatePlaylistSummary);
+    connect(&m_playlistDao,
+            &PlaylistDAO::playlistContentChanged,
+            this,
+            &BasePlaylistFeature::slotInvalidatePlaylistSummaries);
+    // The duration of a track or its visibility might have changed
+    const TrackCollection* pTrackCollection =
+            m_pLibrary->trackCollectionManager()->internalCollection();
+    connect(pTrackCollection,
+            &TrackCollection::tracksAdded,
+            this,
+            &BasePlaylistFeature::slotInvalidatePlaylistSummariesOfTracks);
+    connect(pTrackCollection,
+            &TrackCollection::tracksChanged,
+            this,
+            &BasePlaylistFeature::slotInvalidatePlaylistSummariesOfTracks);
+    connect(pTrackCollection,
+            &TrackCollection::tracksRemoved,
+            this,
+            &BasePlaylistFeature::slotInvalidatePlaylistSummariesOfTracks);
+    connect(pTrackCollection,
+            &TrackCollection::multipleTracksChanged,
+            this,
+            [this] {
+                m_playlistSummaries.clear();
+            });
     connect(&m_playlistDao,
             &PlaylistDAO::added,
             this,
@@ -595,46 +625,48 @@ void BasePlaylistFeature::slotExportPlaylist() {
     // folder. We don't need access to this file on a regular basis so we do not
     // register a security bookmark.
 
-    // Create a new table model since the main one might have an active search.
-    // This will only export songs that we think exist on default
-    std::unique_ptr<PlaylistTableModel> pPlaylistTableModel =
-            std::make_unique<PlaylistTableModel>(this,
-                    m_pLibrary->trackCollectionManager(),
-                    "mixxx.db.model.playlist_export",
-                    m_keepHiddenTracks);
-
-    emit saveModelState();
-    pPlaylistTableModel->selectPlaylist(playlistId);
-    pPlaylistTableModel->setSort(
-            pPlaylistTableModel->fieldIndex(
-                    ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION),
-            Qt::AscendingOrder);
-    pPlaylistTableModel->select();
-
     // check config if relative paths are desired
     bool useRelativePath = m_pConfig->getValue<bool>(
             kUseRelativePathOnExportConfigKey);
 
-    if (fileLocation.endsWith(".csv", Qt::CaseInsensitive)) {
-        ParserCsv::writeCSVFile(fileLocation, pPlaylistTableModel.get(), useRelativePath);
-    } else if (fileLocation.endsWith(".txt", Qt::CaseInsensitive)) {
-        if (m_playlistDao.getHiddenType(pPlaylistTableModel->getPlaylist()) ==
+    if (fileLocation.endsWith(".csv", Qt::CaseInsensitive) ||
+            fileLocation.endsWith(".txt", Qt::CaseInsensitive)) {
+        // Create a new table model since the main one might have an active search.
+        // This will only export songs that we think exist on default
+        std::unique_ptr<PlaylistTableModel> pPlaylistTableModel =
+                std::make_unique<PlaylistTableModel>(this,
+                        m_pLibrary->trackCollectionManager(),
+                        "mixxx.db.model.playlist_export",
+                        m_keepHiddenTracks);
+
+        emit saveModelState();
+        pPlaylistTableModel->selectPlaylist(playlistId);
+        pPlaylistTableModel->setSort(
+                pPlaylistTableModel->fieldIndex(
+                        ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION),
+                Qt::AscendingOrder);
+        pPlaylistTableModel->select();
+
+        if (fileLocation.endsWith(".csv", Qt::CaseInsensitive)) {
+            ParserCsv::writeCSVFile(fileLocation, pPlaylistTableModel.get(), useRelativePath);
+        } else if (m_playlistDao.getHiddenType(pPlaylistTableModel->getPlaylist()) ==
                 PlaylistDAO::PLHT_SET_LOG) {
             ParserCsv::writeReadableTextFile(fileLocation, pPlaylistTableModel.get(), true);
         } else {
             ParserCsv::writeReadableTextFile(fileLocation, pPlaylistTableModel.get(), false);
         }
     } else {
-        // Create and populate a list of files of the playlist
-        QList<QString> playlistItems;
-        int rows = pPlaylistTableModel->rowCount();
-        for (int i = 0; i < rows; ++i) {
-            QModelIndex index = pPlaylistTableModel->index(i, 0);
-            playlistItems << pPlaylistTableModel->getTrackLocation(index);
+        // Only the locations are needed, so they are written while they are
+        // read from the database instead of loading all tracks into a model
+        if (!m_keepHiddenTracks) {
+            // Like PlaylistTableModel::selectPlaylist()
+            m_playlistDao.removeHiddenTracks(playlistId);
         }
         exportPlaylistItemsIntoFile(
                 fileLocation,
-                playlistItems,
+                [this, playlistId](const std::function<void(const QString&)>& function) {
+                    m_playlistDao.forEachTrackLocation(playlistId, function);
+                },
                 useRelativePath);
     }
 }
@@ -747,44 +779,89 @@ void BasePlaylistFeature::htmlLinkClicked(const QUrl& link) {
     }
 }
 
-QString BasePlaylistFeature::fetchPlaylistLabel(int playlistId) {
-    // This queries the temporary id/count/duration table that was has been created
-    // by the features' createPlaylistLabels() (updated each time playlists are added/removed)
+void BasePlaylistFeature::slotInvalidatePlaylistSummaries(const QSet<int>& playlistIds) {
+    for (const auto playlistId : playlistIds) {
+        m_playlistSummaries.remove(playlistId);
+    }
+}
+
+void BasePlaylistFeature::slotInvalidatePlaylistSummary(int playlistId) {
+    if (playlistId == kInvalidPlaylistId) {
+        // Multiple playlists have been deleted
+        m_playlistSummaries.clear();
+    } else {
+        m_playlistSummaries.remove(playlistId);
+    }
+}
+
+void BasePlaylistFeature::slotInvalidatePlaylistSummariesOfTracks(
+        const QSet<TrackId>& trackIds) {
+    if (m_playlistSummaries.isEmpty()) {
+        return;
+    }
+    QSet<int> playlistIds;
+    for (const auto& trackId : trackIds) {
+        // Looked up in memory, PlaylistDAO caches the playlists of all tracks
+        m_playlistDao.getPlaylistsTrackIsIn(trackId, &playlistIds);
+        for (const auto playlistId : std::as_const(playlistIds)) {
+            m_playlistSummaries.remove(playlistId);
+        }
+    }
+}
+
+void BasePlaylistFeature::fetchPlaylistSummaries(const QList<int>& playlistIds) {
+    QStringList idStringList;
+    for (const int playlistId : playlistIds) {
+        if (m_playlistSummaries.contains(playlistId)) {
+            continue;
+        }
+        idStringList.append(QString::number(playlistId));
+        // Playlists without any tracks do not appear in the result
+        m_playlistSummaries.insert(playlistId, PlaylistSummary{0, 0});
+    }
+    if (idStringList.isEmpty()) {
+        return;
+    }
+
     QSqlDatabase database =
             m_pLibrary->trackCollectionManager()->internalCollection()->database();
-    VERIFY_OR_DEBUG_ASSERT(database.tables(QSql::Views).contains(m_countsDurationTableName)) {
-        qWarning() << "BasePlaylistFeature: view" << m_countsDurationTableName
-                   << "does not exist! Can't fetch label for playlist" << playlistId;
+    QSqlQuery query(database);
+    query.prepare(QStringLiteral(
+            "SELECT PlaylistTracks.playlist_id, %1 "
+            "FROM PlaylistTracks "
+            "LEFT JOIN library "
+            "  ON PlaylistTracks.track_id = library.id "
+            "WHERE PlaylistTracks.playlist_id IN (%2) "
+            "GROUP BY PlaylistTracks.playlist_id")
+                          .arg(playlistSummaryColumns(), idStringList.join(",")));
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        // Retry next time instead of caching empty summaries
+        for (const auto& idString : std::as_const(idStringList)) {
+            m_playlistSummaries.remove(idString.toInt());
+        }
+        return;
+    }
+    while (query.next()) {
+        m_playlistSummaries.insert(query.value(0).toInt(),
+                PlaylistSummary{
+                        query.value(1).toInt(),
+                        query.value(2).toInt()});
+    }
+}
+
+BasePlaylistFeature::PlaylistSummary BasePlaylistFeature::playlistSummary(int playlistId) {
+    fetchPlaylistSummaries(QList<int>{playlistId});
+    return m_playlistSummaries.value(playlistId, PlaylistSummary{0, 0});
+}
+
+QString BasePlaylistFeature::fetchPlaylistLabel(int playlistId) {
+    const QString name = m_playlistDao.getPlaylistName(playlistId);
+    if (name.isEmpty()) {
         return QString();
     }
-    QSqlTableModel playlistTableModel(this, database);
-    playlistTableModel.setTable(m_countsDurationTableName);
-    const QString filter = "id=" + QString::number(playlistId);
-    playlistTableModel.setFilter(filter);
-    playlistTableModel.select();
-    while (playlistTableModel.canFetchMore()) {
-        playlistTableModel.fetchMore();
-    }
-    QSqlRecord record = playlistTableModel.record();
-    int nameColumn = record.indexOf("name");
-    int countColumn = record.indexOf("count");
-    int durationColumn = record.indexOf("durationSeconds");
-
-    DEBUG_ASSERT(playlistTableModel.rowCount() <= 1);
-    if (playlistTableModel.rowCount() > 0) {
-        QString name =
-                playlistTableModel.data(playlistTableModel.index(0, nameColumn))
-                        .toString();
-        int count = playlistTableModel
-                            .data(playlistTableModel.index(0, countColumn))
-                            .toInt();
-        int duration =
-                playlistTableModel
-                        .data(playlistTableModel.index(0, durationColumn))
-                        .toInt();
-        return createPlaylistLabel(name, count, duration);
-    }
-    return QString();
+    const PlaylistSummary summary = playlistSummary(playlistId);
+    return createPlaylistLabel(name, summary.count, summary.durationSeconds);
 }
 
 void BasePlaylistFeature::updateChildModel(const QSet<int>& playlistIds) {
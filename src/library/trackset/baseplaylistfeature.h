@@ -1,5 +1,7 @@
 #pragma once
 
+#include <QHash>
+#include <QList>
 #include <QModelIndex>
 #include <QPointer>
 #include <QSet>
@@ -27,7 +29,6 @@ class BasePlaylistFeature : public BaseTrackSetFeature {
             PlaylistTableModel* pModel,
             const QString& rootViewName,
             const QString& iconName,
-            const QString& countsDurationTableName,
             bool keepHiddenTracks = false);
     ~BasePlaylistFeature() override = default;
 
@@ -102,6 +103,20 @@ class BasePlaylistFeature : public BaseTrackSetFeature {
 
     QString createPlaylistLabel(const QString& name, int count, int duration) const;
 
+    /// Track count and duration of a playlist, as shown in the sidebar
+    struct PlaylistSummary {
+        int count;
+        int durationSeconds;
+    };
+
+    /// The SQL result columns for the track count and the duration of a
+    /// playlist, aggregated over PlaylistTracks LEFT JOIN library.
+    virtual QString playlistSummaryColumns() const = 0;
+    /// Aggregates the summaries of the given playlists in a single query.
+    /// Only the playlists that are not yet cached are queried.
+    void fetchPlaylistSummaries(const QList<int>& playlistIds);
+    PlaylistSummary playlistSummary(int playlistId);
+
     PlaylistDAO& m_playlistDao;
     QModelIndex m_lastClickedIndex;
     QModelIndex m_lastRightClickedIndex;
@@ -128,12 +143,14 @@ class BasePlaylistFeature : public BaseTrackSetFeature {
 
     PlaylistTableModel* m_pPlaylistTableModel;
     QSet<int> m_playlistIdsOfSelectedTrack;
-    const QString m_countsDurationTableName;
     TrackId m_selectedTrackId;
 
   private slots:
     void slotTrackSelected(TrackId trackId);
     void slotResetSelectedTrack();
+    void slotInvalidatePlaylistSummaries(const QSet<int>& playlistIds);
+    void slotInvalidatePlaylistSummary(int playlistId);
+    void slotInvalidatePlaylistSummariesOfTracks(const QSet<TrackId>& trackIds);
 
   private:
     void initActions();
@@ -142,6 +159,11 @@ class BasePlaylistFeature : public BaseTrackSetFeature {
     void markTreeItem(TreeItem* pTreeItem);
     QString fetchPlaylistLabel(int playlistId);
 
+    // The summaries are cached instead of being aggregated each time the
+    // sidebar is rebuilt, e.g. when a playlist is added or renamed. Entries
+    // are dropped when PlaylistDAO reports a change of the playlist content
+    // and when tracks of the playlist are changed, hidden, unhidden or purged.
+    QHash<int, PlaylistSummary> m_playlistSummaries;
 
     const bool m_keepHiddenTracks;
 };
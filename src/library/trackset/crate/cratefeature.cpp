@@ -169,11 +169,11 @@ void CrateFeature::connectTrackCollection() {
     connect(m_pTrackCollection, // renamed, un/locked, toggled AutoDJ source
             &TrackCollection::crateUpdated,
             this,
-            &CrateFeature::slotCrateTableChanged);
+            &CrateFeature::slotCrateUpdated);
     connect(m_pTrackCollection,
             &TrackCollection::crateDeleted,
             this,
-            &CrateFeature::slotCrateTableChanged);
+            &CrateFeature::slotCrateDeleted);
     connect(m_pTrackCollection, // crate tracks hidden, unhidden or purged
             &TrackCollection::crateTracksChanged,
             this,
@@ -561,13 +561,22 @@ QModelIndex CrateFeature::rebuildChildModel(CrateId selectedCrateId) {
     std::vector<std::unique_ptr<TreeItem>> modelRows;
     modelRows.reserve(m_pTrackCollection->crates().countCrates());
 
+    if (m_crateSummaries.isEmpty()) {
+        // Aggregate the summaries of all crates at once
+        CrateSummarySelectResult crateSummaries(
+                m_pTrackCollection->crates().selectCrateSummaries());
+        CrateSummary crateSummary;
+        while (crateSummaries.populateNext(&crateSummary)) {
+            m_crateSummaries.insert(crateSummary.getId(), crateSummary);
+        }
+    }
+
     int selectedRow = -1;
-    CrateSummarySelectResult crateSummaries(
-            m_pTrackCollection->crates().selectCrateSummaries());
-    CrateSummary crateSummary;
-    while (crateSummaries.populateNext(&crateSummary)) {
-        modelRows.push_back(newTreeItemForCrateSummary(crateSummary));
-        if (selectedCrateId == crateSummary.getId()) {
+    CrateSelectResult crates(m_pTrackCollection->crates().selectCrates());
+    Crate crate;
+    while (crates.populateNext(&crate)) {
+        modelRows.push_back(newTreeItemForCrateSummary(cachedCrateSummary(crate)));
+        if (selectedCrateId == crate.getId()) {
             // save index for selection
             selectedRow = static_cast<int>(modelRows.size()) - 1;
         }
@@ -586,9 +595,27 @@ QModelIndex CrateFeature::rebuildChildModel(CrateId selectedCrateId) {
     }
 }
 
+CrateSummary CrateFeature::cachedCrateSummary(const Crate& crate) {
+    auto i = m_crateSummaries.constFind(crate.getId());
+    if (i != m_crateSummaries.constEnd()) {
+        // Only the track count and duration are cached, the other
+        // properties of the crate might have been modified.
+        return CrateSummary(crate, i->getTrackCount(), i->getTrackDuration());
+    }
+    CrateSummary crateSummary(crate.getId());
+    if (!m_pTrackCollection->crates().readCrateSummaryById(
+                crate.getId(), &crateSummary)) {
+        return CrateSummary(crate, 0, 0.0);
+    }
+    m_crateSummaries.insert(crate.getId(), crateSummary);
+    return crateSummary;
+}
+
 void CrateFeature::updateChildModel(const QSet<CrateId>& updatedCrateIds) {
     const CrateStorage& crateStorage = m_pTrackCollection->crates();
     for (const CrateId& crateId : updatedCrateIds) {
+        // The cached summary is outdated
+        m_crateSummaries.remove(crateId);
         QModelIndex index = indexFromCrateId(crateId);
         VERIFY_OR_DEBUG_ASSERT(index.isValid()) {
             continue;
@@ -598,6 +625,7 @@ void CrateFeature::updateChildModel(const QSet<CrateId>& updatedCrateIds) {
                 crateStorage.readCrateSummaryById(crateId, &crateSummary)) {
             continue;
         }
+        m_crateSummaries.insert(crateId, crateSummary);
         updateTreeItemForCrateSummary(
                 m_pSidebarModel->getItem(index), crateSummary);
         m_pSidebarModel->triggerRepaint(index);
@@ -902,6 +930,49 @@ void CrateFeature::slotCrateTableChanged(CrateId crateId) {
     }
 }
 
+void CrateFeature::slotCrateUpdated(CrateId crateId) {
+    // The crate has been renamed, (un)locked or (un)marked as AutoDJ source,
+    // which doesn't affect its tracks. The sidebar model only needs to be
+    // rebuilt if the crates have to be re-sorted by name, otherwise the item
+    // is updated in place to preserve the selection of the sidebar.
+    const TreeItem* pRootItem = m_pSidebarModel->getRootItem();
+    VERIFY_OR_DEBUG_ASSERT(pRootItem != nullptr) {
+        return;
+    }
+    bool orderUnchanged = true;
+    int row = 0;
+    CrateSelectResult crates(m_pTrackCollection->crates().selectCrates());
+    Crate crate;
+    Crate updatedCrate;
+    while (crates.populateNext(&crate)) {
+        if (row >= pRootItem->childRows() ||
+                CrateId(pRootItem->child(row)->getData()) != crate.getId()) {
+            orderUnchanged = false;
+            break;
+        }
+        if (crate.getId() == crateId) {
+            updatedCrate = crate;
+        }
+        ++row;
+    }
+    if (!orderUnchanged || row != pRootItem->childRows() || !updatedCrate.getId().isValid()) {
+        slotCrateTableChanged(crateId);
+        return;
+    }
+    QModelIndex index = indexFromCrateId(crateId);
+    VERIFY_OR_DEBUG_ASSERT(index.isValid()) {
+        return;
+    }
+    updateTreeItemForCrateSummary(
+            m_pSidebarModel->getItem(index), cachedCrateSummary(updatedCrate));
+    m_pSidebarModel->triggerRepaint(index);
+}
+
+void CrateFeature::slotCrateDeleted(CrateId crateId) {
+    m_crateSummaries.remove(crateId);
+    slotCrateTableChanged(crateId);
+}
+
 void CrateFeature::slotCrateContentChanged(CrateId crateId) {
     QSet<CrateId> updatedCrateIds;
     updatedCrateIds.insert(crateId);
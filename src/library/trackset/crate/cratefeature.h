@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QHash>
 #include <QList>
 #include <QModelIndex>
 #include <QPointer>
@@ -8,6 +9,7 @@
 
 #include "library/trackset/basetracksetfeature.h"
 #include "library/trackset/crate/crate.h"
+#include "library/trackset/crate/cratesummary.h"
 #include "library/trackset/crate/cratetablemodel.h"
 #include "preferences/usersettings.h"
 #include "track/trackid.h"
@@ -70,6 +72,8 @@ class CrateFeature : public BaseTrackSetFeature {
     void slotExportTrackFiles();
     void slotAnalyzeCrate();
     void slotCrateTableChanged(CrateId crateId);
+    void slotCrateUpdated(CrateId crateId);
+    void slotCrateDeleted(CrateId crateId);
     void slotCrateContentChanged(CrateId crateId);
     void htmlLinkClicked(const QUrl& link);
     void slotTrackSelected(TrackId trackId);
@@ -91,6 +95,9 @@ class CrateFeature : public BaseTrackSetFeature {
 
     QModelIndex rebuildChildModel(CrateId selectedCrateId = CrateId());
     void updateChildModel(const QSet<CrateId>& updatedCrateIds);
+    /// Returns the summary of the crate with the cached track count and
+    /// duration, aggregating them only if the crate is not cached yet.
+    CrateSummary cachedCrateSummary(const Crate& crate);
 
     CrateId crateIdFromIndex(const QModelIndex& index) const;
     QModelIndex indexFromCrateId(CrateId crateId) const;
@@ -111,6 +118,11 @@ class CrateFeature : public BaseTrackSetFeature {
     // Can be used to restore a similar selection after the sidebar model was rebuilt.
     CrateId m_prevSiblingCrate;
 
+    // Track counts and durations of all crates. Aggregating them is
+    // expensive, so they are only re-read for crates whose content has
+    // changed and not when crates are added, renamed or (un)locked.
+    QHash<CrateId, CrateSummary> m_crateSummaries;
+
     QModelIndex m_lastClickedIndex;
     QModelIndex m_lastRightClickedIndex;
     TrackId m_selectedTrackId;
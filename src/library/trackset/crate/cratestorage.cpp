@@ -222,6 +222,7 @@ void CrateStorage::repairDatabase(const QSqlDatabase& database) {
 
 void CrateStorage::connectDatabase(const QSqlDatabase& database) {
     m_database = database;
+    invalidateCrateTrackIndex();
     createViews();
 }
 
@@ -229,6 +230,7 @@ void CrateStorage::disconnectDatabase() {
     // Ensure that we don't use the current database connection
     // any longer.
     m_database = QSqlDatabase();
+    invalidateCrateTrackIndex();
 }
 
 void CrateStorage::createViews() {
@@ -560,6 +562,83 @@ QSet<CrateId> CrateStorage::collectCrateIdsOfTracks(const QList<TrackId>& trackI
     return trackCrates;
 }
 
+void CrateStorage::loadCrateTrackIndex() const {
+    DEBUG_ASSERT(!m_crateTrackIndexLoaded);
+    m_crateTrackIndex.clear();
+    FwdSqlQuery query(m_database,
+            QStringLiteral("SELECT %1,%2 FROM %3")
+                    .arg(CRATETRACKSTABLE_CRATEID,
+                            CRATETRACKSTABLE_TRACKID,
+                            CRATE_TRACKS_TABLE));
+    VERIFY_OR_DEBUG_ASSERT(query.execPrepared()) {
+        // Retry on next access
+        return;
+    }
+    quint64 count = 0;
+    while (query.next()) {
+        const CrateId crateId(query.fieldValue(0));
+        const TrackId trackId(query.fieldValue(1));
+        if (crateId.isValid() && trackId.isValid()) {
+            m_crateTrackIndex[crateId].add(trackIdIndexValue(trackId));
+            ++count;
+        }
+    }
+    m_crateTrackIndexLoaded = true;
+    if (kLogger.debugEnabled()) {
+        kLogger.debug()
+                << "Loaded index of"
+                << count
+                << "tracks in"
+                << m_crateTrackIndex.size()
+                << "crates";
+    }
+}
+
+void CrateStorage::invalidateCrateTrackIndex() {
+    m_crateTrackIndexLoaded = false;
+    m_crateTrackIndex.clear();
+}
+
+const mixxx::RoaringBitmap& CrateStorage::crateTrackIds(
+        CrateId crateId) const {
+    static const mixxx::RoaringBitmap kEmptyBitmap;
+    if (!m_crateTrackIndexLoaded) {
+        loadCrateTrackIndex();
+    }
+    const auto it = m_crateTrackIndex.constFind(crateId);
+    if (it == m_crateTrackIndex.constEnd()) {
+        return kEmptyBitmap;
+    }
+    return it.value();
+}
+
+mixxx::RoaringBitmap CrateStorage::collectTrackIdsByCrateNameLike(
+        const QString& crateNameLike) const {
+    FwdSqlQuery query(m_database,
+            QStringLiteral("SELECT %1 FROM %2 WHERE %3 LIKE :crateNameLike")
+                    .arg(CRATETABLE_ID, CRATE_TABLE, CRATETABLE_NAME));
+    query.bindValue(":crateNameLike",
+            QVariant(kSqlLikeMatchAll + crateNameLike + kSqlLikeMatchAll));
+    mixxx::RoaringBitmap trackIds;
+    if (query.execPrepared()) {
+        while (query.next()) {
+            trackIds |= crateTrackIds(CrateId(query.fieldValue(0)));
+        }
+    }
+    return trackIds;
+}
+
+mixxx::RoaringBitmap CrateStorage::collectTrackIdsWithCrate() const {
+    if (!m_crateTrackIndexLoaded) {
+        loadCrateTrackIndex();
+    }
+    mixxx::RoaringBitmap trackIds;
+    for (const auto& crateTrackIds : std::as_const(m_crateTrackIndex)) {
+        trackIds |= crateTrackIds;
+    }
+    return trackIds;
+}
+
 bool CrateStorage::onInsertingCrate(
         const Crate& crate,
         CrateId* pCrateId) {
@@ -781,3 +860,55 @@ bool CrateStorage::onPurgingTracks(
     }
     return true;
 }
+
+void CrateStorage::afterDeletingCrate(
+        CrateId crateId) {
+    m_crateTrackIndex.remove(crateId);
+}
+
+void CrateStorage::afterAddingCrateTracks(
+        CrateId crateId,
+        const QList<TrackId>& trackIds) {
+    if (!m_crateTrackIndexLoaded) {
+        return;
+    }
+    auto& crateTrackIds = m_crateTrackIndex[crateId];
+    for (const auto& trackId : trackIds) {
+        crateTrackIds.add(trackIdIndexValue(trackId));
+    }
+}
+
+void CrateStorage::afterRemovingCrateTracks(
+        CrateId crateId,
+        const QList<TrackId>& trackIds) {
+    const auto it = m_crateTrackIndex.find(crateId);
+    if (it == m_crateTrackIndex.end()) {
+        return;
+    }
+    for (const auto& trackId : trackIds) {
+        it.value().remove(trackIdIndexValue(trackId));
+    }
+    if (it.value().isEmpty()) {
+        m_crateTrackIndex.erase(it);
+    }
+}
+
+void CrateStorage::afterPurgingTracks(
+        const QList<TrackId>& trackIds) {
+    if (m_crateTrackIndex.isEmpty()) {
+        return;
+    }
+    mixxx::RoaringBitmap purgedTrackIds;
+    for (const auto& trackId : trackIds) {
+        purgedTrackIds.add(trackIdIndexValue(trackId));
+    }
+    auto it = m_crateTrackIndex.begin();
+    while (it != m_crateTrackIndex.end()) {
+        it.value() -= purgedTrackIds;
+        if (it.value().isEmpty()) {
+            it = m_crateTrackIndex.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QHash>
 #include <QList>
 #include <QSet>
 
@@ -8,6 +9,7 @@
 #include "util/db/fwdsqlqueryselectresult.h"
 #include "util/db/sqlstorage.h"
 #include "util/db/sqlsubselectmode.h"
+#include "util/roaringbitmap.h"
 
 class Crate;
 class CrateSummary;
@@ -262,6 +264,20 @@ class CrateStorage : public virtual /*implements*/ SqlStorage {
     bool onPurgingTracks(
             const QList<TrackId>& trackIds);
 
+    void afterDeletingCrate(
+            CrateId crateId);
+
+    void afterAddingCrateTracks(
+            CrateId crateId,
+            const QList<TrackId>& trackIds);
+
+    void afterRemovingCrateTracks(
+            CrateId crateId,
+            const QList<TrackId>& trackIds);
+
+    void afterPurgingTracks(
+            const QList<TrackId>& trackIds);
+
     /////////////////////////////////////////////////////////////////////////
     // Crate read operations (read-only, const)
     /////////////////////////////////////////////////////////////////////////
@@ -323,6 +339,30 @@ class CrateStorage : public virtual /*implements*/ SqlStorage {
     QSet<CrateId> collectCrateIdsOfTracks(
             const QList<TrackId>& trackIds) const;
 
+    /////////////////////////////////////////////////////////////////////////
+    // Crate membership index (in-memory, const)
+    //
+    // The track ids of all crates are also kept in memory as compressed
+    // bitmaps. The index is loaded from the database on first access and
+    // afterwards maintained by the after...() write operations. It is
+    // not synchronized and must only be accessed from the thread that
+    // owns the storage.
+    /////////////////////////////////////////////////////////////////////////
+
+    static quint32 trackIdIndexValue(TrackId trackId) {
+        return trackId.toVariant().toUInt();
+    }
+
+    // Returns an empty bitmap for unknown crates.
+    const mixxx::RoaringBitmap& crateTrackIds(
+            CrateId crateId) const;
+    // The union of all crates whose names match like
+    // formatQueryForTrackIdsByCrateNameLike().
+    mixxx::RoaringBitmap collectTrackIdsByCrateNameLike(
+            const QString& crateNameLike) const;
+    // The union of all crates
+    mixxx::RoaringBitmap collectTrackIdsWithCrate() const;
+
     /////////////////////////////////////////////////////////////////////////
     // CrateSummary view operations (read-only, const)
     /////////////////////////////////////////////////////////////////////////
@@ -340,5 +380,11 @@ class CrateStorage : public virtual /*implements*/ SqlStorage {
   private:
     void createViews();
 
+    void loadCrateTrackIndex() const;
+    void invalidateCrateTrackIndex();
+
     QSqlDatabase m_database;
+
+    mutable bool m_crateTrackIndexLoaded = false;
+    mutable QHash<CrateId, mixxx::RoaringBitmap> m_crateTrackIndex;
 };
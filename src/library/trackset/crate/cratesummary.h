@@ -11,6 +11,11 @@ class CrateSummary : public Crate {
               m_trackCount(0),
               m_trackDuration(0.0) {
     }
+    CrateSummary(const Crate& crate, uint trackCount, double trackDuration)
+            : Crate(crate),
+              m_trackCount(trackCount),
+              m_trackDuration(trackDuration) {
+    }
     ~CrateSummary() override = default;
 
     // The number of all tracks in this crate
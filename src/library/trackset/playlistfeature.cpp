@@ -1,7 +1,7 @@
 #include "library/trackset/playlistfeature.h"
 
 #include <QMenu>
-#include <QSqlTableModel>
+#include <QSqlQuery>
 #include <QtDebug>
 
 #include "library/library.h"
@@ -27,8 +27,7 @@ PlaylistFeature::PlaylistFeature(Library* pLibrary, UserSettingsPointer pConfig)
                           pLibrary->trackCollectionManager(),
                           "mixxx.db.model.playlist"),
                   QStringLiteral("PLAYLISTHOME"),
-                  QStringLiteral("playlist"),
-                  QStringLiteral("PlaylistsCountsDurations")) {
+                  QStringLiteral("playlist")) {
     // construct child model
     std::unique_ptr<TreeItem> pRootItem = TreeItem::newRoot(this);
     m_pSidebarModel->setRootItem(std::move(pRootItem));
@@ -164,72 +163,47 @@ bool PlaylistFeature::dragMoveAcceptChild(const QModelIndex& index, const QList<
     return DragAndDropHelper::urlsContainSupportedTrackFiles(urls, true);
 }
 
+QString PlaylistFeature::playlistSummaryColumns() const {
+    return QStringLiteral(
+            "COUNT(case library.mixxx_deleted when 0 then 1 else null end), "
+            "SUM(case library.mixxx_deleted "
+            "  when 0 then library.duration else 0 end)");
+}
+
 QList<BasePlaylistFeature::IdAndLabel> PlaylistFeature::createPlaylistLabels() {
     QSqlDatabase database =
             m_pLibrary->trackCollectionManager()->internalCollection()->database();
 
-    QList<BasePlaylistFeature::IdAndLabel> playlistLabels;
-    QString queryString = QStringLiteral(
-            "CREATE TEMPORARY VIEW IF NOT EXISTS %1 "
-            "AS SELECT "
-            "  Playlists.id AS id, "
-            "  Playlists.name AS name, "
-            "  LOWER(Playlists.name) AS sort_name, "
-            "  COUNT(case library.mixxx_deleted when 0 then 1 else null end) "
-            "    AS count, "
-            "  SUM(case library.mixxx_deleted "
-            "    when 0 then library.duration else 0 end) AS durationSeconds "
-            "FROM Playlists "
-            "LEFT JOIN PlaylistTracks "
-            "  ON PlaylistTracks.playlist_id = Playlists.id "
-            "LEFT JOIN library "
-            "  ON PlaylistTracks.track_id = library.id "
-            "  WHERE Playlists.hidden = %2 "
-            "  GROUP BY Playlists.id")
-                                  .arg(m_countsDurationTableName,
-                                          QString::number(
-                                                  PlaylistDAO::PLHT_NOT_HIDDEN));
-    queryString.append(
-            mixxx::DbConnection::collateLexicographically(
-                    " ORDER BY sort_name"));
+    // The track counts and durations are not aggregated here for all
+    // playlists but cached, see fetchPlaylistSummaries()
     QSqlQuery query(database);
-    if (!query.exec(queryString)) {
+    query.prepare(QStringLiteral(
+                          "SELECT id, name FROM Playlists "
+                          "WHERE hidden = :hidden") +
+            mixxx::DbConnection::collateLexicographically(
+                    QStringLiteral(" ORDER BY LOWER(name)")));
+    query.bindValue(":hidden", PlaylistDAO::PLHT_NOT_HIDDEN);
+    if (!query.exec()) {
         LOG_FAILED_QUERY(query);
+        return {};
     }
 
-    // Setup the sidebar playlist model
-    QSqlTableModel playlistTableModel(this, database);
-    playlistTableModel.setTable("PlaylistsCountsDurations");
-    playlistTableModel.select();
-    while (playlistTableModel.canFetchMore()) {
-        playlistTableModel.fetchMore();
+    QList<std::pair<int, QString>> playlists;
+    QList<int> playlistIds;
+    while (query.next()) {
+        const int id = query.value(0).toInt();
+        playlists.append(std::make_pair(id, query.value(1).toString()));
+        playlistIds.append(id);
     }
-    QSqlRecord record = playlistTableModel.record();
-    int nameColumn = record.indexOf("name");
-    int idColumn = record.indexOf("id");
-    int countColumn = record.indexOf("count");
-    int durationColumn = record.indexOf("durationSeconds");
-
-    for (int row = 0; row < playlistTableModel.rowCount(); ++row) {
-        int id =
-                playlistTableModel
-                        .data(playlistTableModel.index(row, idColumn))
-                        .toInt();
-        QString name =
-                playlistTableModel
-                        .data(playlistTableModel.index(row, nameColumn))
-                        .toString();
-        int count =
-                playlistTableModel
-                        .data(playlistTableModel.index(row, countColumn))
-                        .toInt();
-        int duration =
-                playlistTableModel
-                        .data(playlistTableModel.index(row, durationColumn))
-                        .toInt();
+    fetchPlaylistSummaries(playlistIds);
+
+    QList<BasePlaylistFeature::IdAndLabel> playlistLabels;
+    playlistLabels.reserve(playlists.size());
+    for (const auto& [id, name] : std::as_const(playlists)) {
+        const PlaylistSummary summary = playlistSummary(id);
         BasePlaylistFeature::IdAndLabel idAndLabel;
         idAndLabel.id = id;
-        idAndLabel.label = createPlaylistLabel(name, count, duration);
+        idAndLabel.label = createPlaylistLabel(name, summary.count, summary.durationSeconds);
         playlistLabels.append(idAndLabel);
     }
     return playlistLabels;
@@ -433,9 +407,22 @@ void PlaylistFeature::slotPlaylistContentOrLockChanged(const QSet<int>& playlist
 void PlaylistFeature::slotPlaylistTableRenamed(int playlistId, const QString& newName) {
     Q_UNUSED(newName);
     // qDebug() << "PlaylistFeature::slotPlaylistTableRenamed() playlistId:" << playlistId;
-    if (m_playlistDao.getHiddenType(playlistId) == PlaylistDAO::PLHT_NOT_HIDDEN) {
-        // Maybe we need to re-sort the sidebar items, so call slotPlaylistTableChanged()
-        // in order to rebuild the model, not just updateChildModel()
+    if (m_playlistDao.getHiddenType(playlistId) != PlaylistDAO::PLHT_NOT_HIDDEN) {
+        return;
+    }
+    // Only rebuild the model if the items need to be re-sorted by name.
+    // Otherwise just update the label of the renamed item in place, which
+    // preserves the selection and the scroll position of the sidebar.
+    const QList<IdAndLabel> playlistLabels = createPlaylistLabels();
+    const TreeItem* pRootItem = m_pSidebarModel->getRootItem();
+    bool orderUnchanged = pRootItem &&
+            pRootItem->childRows() == playlistLabels.size();
+    for (int row = 0; orderUnchanged && row < playlistLabels.size(); ++row) {
+        orderUnchanged = pRootItem->child(row)->getData().toInt() == playlistLabels[row].id;
+    }
+    if (orderUnchanged) {
+        updateChildModel(QSet<int>{playlistId});
+    } else {
         slotPlaylistTableChanged(playlistId);
     }
 }
@@ -43,6 +43,7 @@ class PlaylistFeature : public BasePlaylistFeature {
 
   protected:
     void decorateChild(TreeItem* pChild, int playlistId) override;
+    QString playlistSummaryColumns() const override;
     QList<IdAndLabel> createPlaylistLabels();
     QModelIndex constructChildModel(int selectedId);
 
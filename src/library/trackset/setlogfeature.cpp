@@ -2,7 +2,7 @@
 
 #include <QDateTime>
 #include <QMenu>
-#include <QSqlTableModel>
+#include <QSqlQuery>
 
 #include "library/library.h"
 #include "library/library_prefs.h"
@@ -38,7 +38,6 @@ SetlogFeature::SetlogFeature(
                           /*keep hidden tracks*/ true),
                   QStringLiteral("SETLOGHOME"),
                   QStringLiteral("history"),
-                  QStringLiteral("SetlogCountsDurations"),
                   /*keep hidden tracks*/ true),
           m_currentPlaylistId(kInvalidPlaylistId),
           m_yearNodeId(kInvalidPlaylistId),
@@ -234,47 +233,37 @@ QModelIndex SetlogFeature::constructChildModel(int selectedId) {
     QSqlDatabase database =
             m_pLibrary->trackCollectionManager()->internalCollection()->database();
 
-    QString queryString = QStringLiteral(
-            "CREATE TEMPORARY VIEW IF NOT EXISTS %1 "
-            "AS SELECT "
-            "  Playlists.id AS id, "
-            "  Playlists.name AS name, "
-            "  Playlists.date_created AS date_created, "
-            "  LOWER(Playlists.name) AS sort_name, "
-            "  max(PlaylistTracks.position) AS count,"
-            "  SUM(library.duration) AS durationSeconds "
-            "FROM Playlists "
-            "LEFT JOIN PlaylistTracks "
-            "  ON PlaylistTracks.playlist_id = Playlists.id "
-            "LEFT JOIN library "
-            "  ON PlaylistTracks.track_id = library.id "
-            "  WHERE Playlists.hidden = %2 "
-            "  GROUP BY Playlists.id")
-                                  .arg(m_countsDurationTableName,
-                                          QString::number(PlaylistDAO::PLHT_SET_LOG));
-    ;
-    queryString.append(
-            mixxx::DbConnection::collateLexicographically(
-                    " ORDER BY sort_name"));
+    // History playlists are stored like all other playlists, there is no
+    // separate append-only play log or summary table. Only the plain
+    // playlist rows are read here. The track counts and durations are
+    // cached in memory and only aggregated for playlists that have been
+    // added or modified since the last rebuild, see fetchPlaylistSummaries().
     QSqlQuery query(database);
-    if (!query.exec(queryString)) {
+    query.prepare(QStringLiteral(
+            "SELECT id, name, date_created FROM Playlists "
+            "WHERE hidden = :hidden "
+            "ORDER BY id DESC"));
+    query.bindValue(":hidden", PlaylistDAO::PLHT_SET_LOG);
+    if (!query.exec()) {
         LOG_FAILED_QUERY(query);
     }
 
-    // Setup the sidebar playlist model
-    QSqlTableModel playlistTableModel(this, database);
-    playlistTableModel.setTable(m_countsDurationTableName);
-    playlistTableModel.setSort(playlistTableModel.fieldIndex("id"), Qt::DescendingOrder);
-    playlistTableModel.select();
-    while (playlistTableModel.canFetchMore()) {
-        playlistTableModel.fetchMore();
-    }
-    QSqlRecord record = playlistTableModel.record();
-    int nameColumn = record.indexOf("name");
-    int idColumn = record.indexOf("id");
-    int createdColumn = record.indexOf("date_created");
-    int countColumn = record.indexOf("count");
-    int durationColumn = record.indexOf("durationSeconds");
+    struct PlaylistRow {
+        int id;
+        QString name;
+        QDateTime dateCreated;
+    };
+    std::vector<PlaylistRow> playlistRows;
+    QList<int> playlistIds;
+    while (query.next()) {
+        PlaylistRow row{
+                query.value(0).toInt(),
+                query.value(1).toString(),
+                query.value(2).toDateTime()};
+        playlistIds.append(row.id);
+        playlistRows.push_back(std::move(row));
+    }
+    fetchPlaylistSummaries(playlistIds);
 
     // Nice to have: restore previous expanded/collapsed state of YEAR items
     clearChildModel();
@@ -283,26 +272,13 @@ QModelIndex SetlogFeature::constructChildModel(int selectedId) {
     // Generous estimate (number of years the db is used ;))
     itemList.reserve(kNumToplevelHistoryEntries + 15);
 
-    for (int row = 0; row < playlistTableModel.rowCount(); ++row) {
-        int id =
-                playlistTableModel
-                        .data(playlistTableModel.index(row, idColumn))
-                        .toInt();
-        QString name =
-                playlistTableModel
-                        .data(playlistTableModel.index(row, nameColumn))
-                        .toString();
-        QDateTime dateCreated =
-                playlistTableModel
-                        .data(playlistTableModel.index(row, createdColumn))
-                        .toDateTime();
-        int count = playlistTableModel
-                            .data(playlistTableModel.index(row, countColumn))
-                            .toInt();
-        int duration =
-                playlistTableModel
-                        .data(playlistTableModel.index(row, durationColumn))
-                        .toInt();
+    for (int row = 0; row < static_cast<int>(playlistRows.size()); ++row) {
+        const int id = playlistRows[row].id;
+        const QString& name = playlistRows[row].name;
+        const QDateTime& dateCreated = playlistRows[row].dateCreated;
+        const PlaylistSummary summary = playlistSummary(id);
+        const int count = summary.count;
+        const int duration = summary.durationSeconds;
         QString label = createPlaylistLabel(name, count, duration);
 
         // Create the TreeItem whose parent is the invisible root item.
@@ -346,6 +322,13 @@ QModelIndex SetlogFeature::constructChildModel(int selectedId) {
     return indexFromPlaylistId(selectedId);
 }
 
+QString SetlogFeature::playlistSummaryColumns() const {
+    // History playlists keep hidden tracks
+    return QStringLiteral(
+            "max(PlaylistTracks.position), "
+            "SUM(library.duration)");
+}
+
 void SetlogFeature::decorateChild(TreeItem* item, int playlistId) {
     if (playlistId == m_currentPlaylistId) {
         item->setIcon(QIcon(":/images/library/ic_library_history_current.svg"));
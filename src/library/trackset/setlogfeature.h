@@ -37,6 +37,7 @@ class SetlogFeature : public BasePlaylistFeature {
   protected:
     QModelIndex constructChildModel(int selectedId);
     void decorateChild(TreeItem* pChild, int playlistId) override;
+    QString playlistSummaryColumns() const override;
 
   private slots:
     void slotPlayingTrackChanged(TrackPointer currentPlayingTrack);
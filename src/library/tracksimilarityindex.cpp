@@ -0,0 +1,282 @@
+#include "library/tracksimilarityindex.h"
+
+#include <QStringList>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <queue>
+
+#include "library/dao/trackschema.h"
+#include "library/searchquery.h"
+#include "track/keyutils.h"
+#include "track/replaygain.h"
+#include "util/assert.h"
+#include "util/db/fwdsqlquery.h"
+#include "util/logger.h"
+#include "util/math.h"
+
+namespace {
+
+const mixxx::Logger kLogger("TrackSimilarityIndex");
+
+// The minimum tempo tolerance, even if the fuzzy BPM range is set to 0
+constexpr double kMinRelativeBpmRange = 0.01;
+
+// Keys that are unknown are considered to clash moderately
+constexpr double kUnknownKeyDistance = 2.0;
+constexpr double kUnknownLoudnessDistance = 0.5;
+
+constexpr double kLoudnessDistanceDb = 3.0;
+// A track with twice the duration adds this distance
+constexpr double kDurationWeight = 0.5;
+
+double logBpm(double bpm) {
+    DEBUG_ASSERT(bpm > 0);
+    return std::log2(bpm);
+}
+
+double tempoDistance(double logBpm, double otherLogBpm) {
+    const double relativeRange = std::max(
+            BpmFilterNode::bpmRelativeRange(), kMinRelativeBpmRange);
+    return std::abs(logBpm - otherLogBpm) / std::log2(1 + relativeRange);
+}
+
+} // anonymous namespace
+
+TrackSimilarityIndex::TrackSimilarityIndex(const QSqlDatabase& database)
+        : m_database(database),
+          m_reloadRequired(database.isValid()) {
+}
+
+// static
+double TrackSimilarityIndex::distance(const Features& lhs, const Features& rhs) {
+    DEBUG_ASSERT(lhs.bpm > 0 && rhs.bpm > 0);
+    double result = tempoDistance(logBpm(lhs.bpm), logBpm(rhs.bpm));
+    const int keySteps = KeyUtils::camelotDistance(lhs.key, rhs.key);
+    result += keySteps < 0 ? kUnknownKeyDistance : keySteps;
+    if (ReplayGain::isValidRatio(lhs.replayGainRatio) &&
+            ReplayGain::isValidRatio(rhs.replayGainRatio)) {
+        result += std::abs(ratio2db(lhs.replayGainRatio) - ratio2db(rhs.replayGainRatio)) /
+                kLoudnessDistanceDb;
+    } else {
+        result += kUnknownLoudnessDistance;
+    }
+    if (lhs.durationSeconds > 0 && rhs.durationSeconds > 0) {
+        result += kDurationWeight *
+                std::abs(std::log2(lhs.durationSeconds / rhs.durationSeconds));
+    }
+    return result;
+}
+
+void TrackSimilarityIndex::invalidate() {
+    m_reloadRequired = m_database.isValid();
+    m_staleTrackIds.clear();
+}
+
+void TrackSimilarityIndex::invalidateTracks(const QSet<TrackId>& trackIds) {
+    if (!m_reloadRequired) {
+        m_staleTrackIds.unite(trackIds);
+    }
+}
+
+void TrackSimilarityIndex::insertTrack(TrackId trackId, const Features& features) {
+    DEBUG_ASSERT(trackId.isValid());
+    const auto it = m_trackFeatures.constFind(trackId);
+    if (it != m_trackFeatures.constEnd()) {
+        removeEntry(trackId, it.value());
+    }
+    if (features.bpm <= 0) {
+        m_trackFeatures.remove(trackId);
+        return;
+    }
+    m_trackFeatures.insert(trackId, features);
+    const Entry entry{logBpm(features.bpm), trackId};
+    m_entries.insert(
+            std::upper_bound(m_entries.begin(), m_entries.end(), entry),
+            entry);
+}
+
+void TrackSimilarityIndex::removeTracks(const QSet<TrackId>& trackIds) {
+    for (const auto& trackId : trackIds) {
+        const auto it = m_trackFeatures.constFind(trackId);
+        if (it == m_trackFeatures.constEnd()) {
+            continue;
+        }
+        removeEntry(trackId, it.value());
+        m_trackFeatures.erase(it);
+    }
+}
+
+void TrackSimilarityIndex::removeEntry(TrackId trackId, const Features& features) {
+    const Entry entry{logBpm(features.bpm), trackId};
+    auto it = std::lower_bound(m_entries.begin(), m_entries.end(), entry);
+    while (it != m_entries.end() && it->logBpm == entry.logBpm) {
+        if (it->trackId == trackId) {
+            m_entries.erase(it);
+            return;
+        }
+        ++it;
+    }
+    DEBUG_ASSERT(!"missing entry");
+}
+
+void TrackSimilarityIndex::refresh() {
+    if (m_reloadRequired) {
+        m_trackFeatures.clear();
+        m_entries.clear();
+        loadTracks(nullptr);
+        m_reloadRequired = false;
+        m_staleTrackIds.clear();
+        return;
+    }
+    if (!m_staleTrackIds.isEmpty()) {
+        // Tracks that have been deleted or hidden in the meantime
+        // are not reinserted
+        removeTracks(m_staleTrackIds);
+        loadTracks(&m_staleTrackIds);
+        m_staleTrackIds.clear();
+    }
+}
+
+void TrackSimilarityIndex::loadTracks(const QSet<TrackId>* pTrackIds) {
+    QString queryString =
+            QStringLiteral("SELECT %1,%2,%3,%4,%5 FROM %6 WHERE %7=0")
+                    .arg(LIBRARYTABLE_ID,
+                            LIBRARYTABLE_BPM,
+                            LIBRARYTABLE_KEY_ID,
+                            LIBRARYTABLE_REPLAYGAIN,
+                            LIBRARYTABLE_DURATION,
+                            LIBRARY_TABLE,
+                            LIBRARYTABLE_MIXXXDELETED);
+    if (pTrackIds) {
+        QStringList trackIds;
+        trackIds.reserve(pTrackIds->size());
+        for (const auto& trackId : *pTrackIds) {
+            trackIds.append(trackId.toString());
+        }
+        queryString += QStringLiteral(" AND %1 IN (%2)")
+                               .arg(LIBRARYTABLE_ID, trackIds.join(QChar(',')));
+    }
+    FwdSqlQuery query(m_database, queryString);
+    VERIFY_OR_DEBUG_ASSERT(query.execPrepared()) {
+        return;
+    }
+    // Collect and sort all entries at once instead of inserting
+    // them one by one
+    std::vector<Entry> entries;
+    while (query.next()) {
+        const TrackId trackId(query.fieldValue(0));
+        Features features;
+        features.bpm = query.fieldValue(1).toDouble();
+        if (!trackId.isValid() || features.bpm <= 0) {
+            continue;
+        }
+        const int key = query.fieldValue(2).toInt();
+        if (mixxx::track::io::key::ChromaticKey_IsValid(key)) {
+            features.key = static_cast<mixxx::track::io::key::ChromaticKey>(key);
+        }
+        features.replayGainRatio = query.fieldValue(3).toDouble();
+        features.durationSeconds = query.fieldValue(4).toDouble();
+        m_trackFeatures.insert(trackId, features);
+        entries.push_back(Entry{logBpm(features.bpm), trackId});
+    }
+    std::sort(entries.begin(), entries.end());
+    const auto middle = static_cast<std::ptrdiff_t>(m_entries.size());
+    m_entries.insert(m_entries.end(), entries.begin(), entries.end());
+    std::inplace_merge(m_entries.begin(), m_entries.begin() + middle, m_entries.end());
+    if (kLogger.debugEnabled()) {
+        kLogger.debug()
+                << "Loaded"
+                << entries.size()
+                << "tracks";
+    }
+}
+
+std::optional<TrackSimilarityIndex::Features> TrackSimilarityIndex::trackFeatures(
+        TrackId trackId) {
+    refresh();
+    const auto it = m_trackFeatures.constFind(trackId);
+    if (it == m_trackFeatures.constEnd()) {
+        return std::nullopt;
+    }
+    return it.value();
+}
+
+QList<TrackId> TrackSimilarityIndex::findNearest(
+        TrackId trackId,
+        int count,
+        const Filter& filter) {
+    const auto features = trackFeatures(trackId);
+    if (!features) {
+        return {};
+    }
+    return findNearest(*features,
+            count,
+            [trackId, &filter](TrackId candidateId) {
+                return candidateId != trackId && (!filter || filter(candidateId));
+            });
+}
+
+QList<TrackId> TrackSimilarityIndex::findNearest(
+        const Features& features,
+        int count,
+        const Filter& filter) {
+    if (features.bpm <= 0 || count <= 0) {
+        return {};
+    }
+    refresh();
+
+    struct Match {
+        double distance;
+        TrackId trackId;
+
+        bool operator<(const Match& other) const {
+            return distance < other.distance;
+        }
+    };
+    // The worst match is on top
+    std::priority_queue<Match> matches;
+
+    const double referenceLogBpm = logBpm(features.bpm);
+    auto upper = std::lower_bound(m_entries.cbegin(),
+            m_entries.cend(),
+            Entry{referenceLogBpm, TrackId()});
+    auto lower = std::make_reverse_iterator(upper);
+    while (upper != m_entries.cend() || lower != m_entries.crend()) {
+        // Continue with the entry that is closer in tempo
+        const double upperTempoDistance = upper != m_entries.cend()
+                ? tempoDistance(upper->logBpm, referenceLogBpm)
+                : std::numeric_limits<double>::infinity();
+        const double lowerTempoDistance = lower != m_entries.crend()
+                ? tempoDistance(lower->logBpm, referenceLogBpm)
+                : std::numeric_limits<double>::infinity();
+        const bool takeUpper = upperTempoDistance <= lowerTempoDistance;
+        const double tempoDistanceLowerBound =
+                takeUpper ? upperTempoDistance : lowerTempoDistance;
+        if (static_cast<int>(matches.size()) == count &&
+                tempoDistanceLowerBound >= matches.top().distance) {
+            // None of the remaining tracks could be closer
+            break;
+        }
+        const TrackId candidateId = takeUpper ? (upper++)->trackId : (lower++)->trackId;
+        if (filter && !filter(candidateId)) {
+            continue;
+        }
+        const double candidateDistance = distance(features, m_trackFeatures.value(candidateId));
+        if (static_cast<int>(matches.size()) < count) {
+            matches.push(Match{candidateDistance, candidateId});
+        } else if (candidateDistance < matches.top().distance) {
+            matches.pop();
+            matches.push(Match{candidateDistance, candidateId});
+        }
+    }
+
+    QList<TrackId> trackIds;
+    trackIds.reserve(static_cast<int>(matches.size()));
+    while (!matches.empty()) {
+        trackIds.prepend(matches.top().trackId);
+        matches.pop();
+    }
+    return trackIds;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QSqlDatabase>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "proto/keys.pb.h"
+#include "track/trackid.h"
+
+/// An in-memory index of the properties of all tracks in the internal
+/// collection that decide whether two tracks mix well: tempo, key,
+/// loudness and duration. It answers k-nearest neighbor queries like
+/// "what mixes well after this track" without querying the database.
+///
+/// The tracks are ordered by tempo, which dominates the distance. A query
+/// starts at the tempo of the reference track and expands outwards until
+/// the tempo difference alone exceeds the distance of the k-th best match
+/// found so far. Tracks without a BPM are not indexed.
+///
+/// The index is loaded on first use. Modified tracks are only marked as
+/// stale and reloaded from the database with the next query. It is not
+/// synchronized and must only be used from the thread that owns the
+/// database connection.
+class TrackSimilarityIndex final {
+  public:
+    struct Features {
+        double bpm = 0.0;
+        mixxx::track::io::key::ChromaticKey key = mixxx::track::io::key::INVALID;
+        /// The ReplayGain ratio as measured by the R128 analyzer,
+        /// 0 if unknown.
+        double replayGainRatio = 0.0;
+        double durationSeconds = 0.0;
+    };
+
+    using Filter = std::function<bool(TrackId)>;
+
+    explicit TrackSimilarityIndex(
+            const QSqlDatabase& database = QSqlDatabase());
+
+    /// Reloads all tracks with the next query.
+    void invalidate();
+    /// Reloads the given tracks with the next query.
+    void invalidateTracks(const QSet<TrackId>& trackIds);
+
+    void insertTrack(TrackId trackId, const Features& features);
+    void removeTracks(const QSet<TrackId>& trackIds);
+
+    std::optional<Features> trackFeatures(TrackId trackId);
+
+    /// Returns up to count tracks ordered by increasing distance to the
+    /// reference track, excluding the reference track itself. Only tracks
+    /// that are accepted by the optional filter are considered.
+    QList<TrackId> findNearest(
+            TrackId trackId,
+            int count,
+            const Filter& filter = Filter());
+    QList<TrackId> findNearest(
+            const Features& features,
+            int count,
+            const Filter& filter = Filter());
+
+    /// The dimensionless distance between two tracks that is minimized by
+    /// findNearest(). A distance of 1 corresponds to a tempo difference
+    /// of the fuzzy BPM range, a single step on the Camelot wheel or a
+    /// loudness difference of 3 dB.
+    static double distance(const Features& lhs, const Features& rhs);
+
+    int size() const {
+        return m_trackFeatures.size();
+    }
+
+  private:
+    struct Entry {
+        double logBpm;
+        TrackId trackId;
+
+        friend bool operator<(const Entry& lhs, const Entry& rhs) {
+            return lhs.logBpm < rhs.logBpm;
+        }
+    };
+
+    void refresh();
+    void loadTracks(const QSet<TrackId>* pTrackIds);
+    void removeEntry(TrackId trackId, const Features& features);
+
+    QSqlDatabase m_database;
+    bool m_reloadRequired;
+    QSet<TrackId> m_staleTrackIds;
+
+    QHash<TrackId, Features> m_trackFeatures;
+    /// Sorted by logBpm
+    std::vector<Entry> m_entries;
+};
@@ -16,6 +16,7 @@
 #include "controllers/controllermanager.h"
 #include "coreservices.h"
 #include "errordialoghandler.h"
+#include "headlessapplication.h"
 #include "mixxxapplication.h"
 #ifdef MIXXX_USE_QML
 #include "mixer/playermanager.h"
@@ -60,6 +61,15 @@ int runMixxx(MixxxApplication* pApp, const CmdlineArgs& args) {
     CmdlineArgs::Instance().parseForUserFeedback();
 
     int exitCode;
+    if (args.isHeadless()) {
+        mixxx::HeadlessApplication headlessApplication(pApp, args);
+        if (!headlessApplication.isInitialized() || ErrorDialogHandler::instance()->checkError()) {
+            exitCode = kFatalErrorOnStartupExitCode;
+        } else {
+            exitCode = pApp->exec();
+        }
+        return exitCode;
+    }
 #ifdef MIXXX_USE_QML
     if (args.isQml()) {
         // This is a workaround to support Qt 6.4.2, currently shipped on
@@ -243,6 +253,13 @@ int main(int argc, char * argv[]) {
 
     adjustScaleFactor(&args);
 
+    if (args.isHeadless() && !qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        // Neither a display server nor a GPU is needed. The offscreen
+        // platform still allows to create the (never shown) widgets
+        // that some subsystems depend on.
+        qputenv("QT_QPA_PLATFORM", QByteArrayLiteral("offscreen"));
+    }
+
     MixxxApplication app(argc, argv);
 
 #if defined(Q_OS_WIN)
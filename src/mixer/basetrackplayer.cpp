@@ -17,6 +17,7 @@
 #include "moc_basetrackplayer.cpp"
 #include "track/track.h"
 #include "util/sandbox.h"
+#include "util/tracerecorder.h"
 #include "vinylcontrol/defs_vinylcontrol.h"
 #include "waveform/renderers/waveformwidgetrenderer.h"
 
@@ -568,6 +569,7 @@ void BaseTrackPlayerImpl::slotLoadTrack(TrackPointer pNewTrack,
         bool bPlay) {
 #endif
     //qDebug() << "BaseTrackPlayerImpl::slotLoadTrack" << getGroup() << pNewTrack.get();
+    mixxx::ScopedTraceEvent trace("player", "BaseTrackPlayerImpl::slotLoadTrack");
     // Before loading the track, ensure we have access. This uses lazy
     // evaluation to make sure track isn't NULL before we dereference it.
     if (pNewTrack) {
@@ -46,6 +46,7 @@
 #include "recording/recordingmanager.h"
 #include "skin/legacy/launchimage.h"
 #include "skin/skinloader.h"
+#include "soundio/qualitygovernor.h"
 #include "soundio/soundmanager.h"
 #include "sources/soundsourceproxy.h"
 #include "track/track.h"
@@ -291,6 +292,14 @@ void MixxxMainWindow::initialize() {
     WaveformWidgetFactory::createInstance(); // takes a long time
     WaveformWidgetFactory::instance()->setConfig(m_pCoreServices->getSettings());
     WaveformWidgetFactory::instance()->startVSync(m_pGuiTick, m_pVisualsManager, false);
+    connect(m_pCoreServices->getQualityGovernor().get(),
+            &mixxx::QualityGovernor::levelChanged,
+            WaveformWidgetFactory::instance(),
+            [](mixxx::QualityGovernor::Level level) {
+                // Halve the frame rate per step
+                WaveformWidgetFactory::instance()->setFrameRateDivisor(
+                        1 << static_cast<int>(level));
+            });
 
     connect(this,
             &MixxxMainWindow::skinLoaded,
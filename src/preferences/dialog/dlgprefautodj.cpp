@@ -66,6 +66,8 @@ void DlgPrefAutoDJ::slotUpdate() {
     RandomQueueMinimumSpinBox->setValue(
             m_pConfig->getValue(
                     ConfigKey("[Auto DJ]", "RandomQueueMinimumAllowed"), 5));
+    RandomQueueSimilarCheckBox->setChecked(m_pConfig->getValue(
+            ConfigKey("[Auto DJ]", "RandomQueueSimilarTracks"), false));
     // "[Auto DJ], Requeue" is set by 'Repeat Playlist' toggle in DlgAutoDj GUI.
     // If it's checked un-check 'Random Queue'
     // TODO Add 'Repeat' checkbox here, or add a hint why the checkbox may be disabled
@@ -97,6 +99,8 @@ void DlgPrefAutoDJ::slotApply() {
     m_pConfig->setValue(
             ConfigKey("[Auto DJ]", "RandomQueueMinimumAllowed"),
             RandomQueueMinimumSpinBox->value());
+    m_pConfig->setValue(ConfigKey("[Auto DJ]", "RandomQueueSimilarTracks"),
+            RandomQueueSimilarCheckBox->isChecked());
 
     m_pConfig->setValue(ConfigKey("[Auto DJ]", "center_xfader_when_disabling"),
             CenterXfaderCheckBox->isChecked());
@@ -113,6 +117,7 @@ void DlgPrefAutoDJ::slotResetToDefaults() {
     RandomQueueCheckBox->setEnabled(true);
     RandomQueueMinimumSpinBox->setEnabled(false);
     RandomQueueMinimumSpinBox->setValue(5);
+    RandomQueueSimilarCheckBox->setChecked(false);
 
     CenterXfaderCheckBox->setChecked(false);
 }
@@ -31,6 +31,9 @@ const QHash<int, QByteArray> kRoleNames = {
         {QmlLibraryTrackListModel::CoverArt, "cover_art"},
 };
 
+// Enough rows for a few screens of a scrolled list view
+constexpr int kRowCacheSize = 1024;
+
 QColor colorFromRgbCode(double colorValue) {
     if (colorValue < 0 || colorValue > 0xFFFFFF) {
         return {};
@@ -46,7 +49,8 @@ QmlLibraryTrackListModel::QmlLibraryTrackListModel(
         QAbstractItemModel* pModel,
         QObject* pParent)
         : QIdentityProxyModel(pParent),
-          m_columns() {
+          m_columns(),
+          m_rowCache(kRowCacheSize) {
     m_columns.reserve(librarySource.size());
     for (const auto* pColumn : std::as_const(librarySource)) {
         m_columns.emplace_back(make_parented<QmlLibraryTrackListColumn>(this,
@@ -58,6 +62,34 @@ QmlLibraryTrackListModel::QmlLibraryTrackListModel(
                 pColumn->role()));
     }
 
+    // The signals of the proxy are forwarded from the source model. The
+    // cache is invalidated before any view receives them, because these
+    // connections are established first.
+    connect(this,
+            &QAbstractItemModel::modelReset,
+            this,
+            &QmlLibraryTrackListModel::slotInvalidateRowCache);
+    connect(this,
+            &QAbstractItemModel::layoutChanged,
+            this,
+            &QmlLibraryTrackListModel::slotInvalidateRowCache);
+    connect(this,
+            &QAbstractItemModel::rowsInserted,
+            this,
+            &QmlLibraryTrackListModel::slotInvalidateRowCache);
+    connect(this,
+            &QAbstractItemModel::rowsRemoved,
+            this,
+            &QmlLibraryTrackListModel::slotInvalidateRowCache);
+    connect(this,
+            &QAbstractItemModel::rowsMoved,
+            this,
+            &QmlLibraryTrackListModel::slotInvalidateRowCache);
+    connect(this,
+            &QAbstractItemModel::dataChanged,
+            this,
+            &QmlLibraryTrackListModel::slotRowsDataChanged);
+
     auto* pTrackModel = dynamic_cast<TrackModel*>(pModel);
     VERIFY_OR_DEBUG_ASSERT(pTrackModel) {
         return;
@@ -66,6 +98,90 @@ QmlLibraryTrackListModel::QmlLibraryTrackListModel(
     setSourceModel(pModel);
 }
 
+void QmlLibraryTrackListModel::slotInvalidateRowCache() {
+    m_rowCache.clear();
+}
+
+void QmlLibraryTrackListModel::slotRowsDataChanged(
+        const QModelIndex& topLeft, const QModelIndex& bottomRight) {
+    for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+        m_rowCache.remove(row);
+    }
+}
+
+QmlLibraryTrackListModel::RowSnapshot& QmlLibraryTrackListModel::rowSnapshot(
+        const QModelIndex& proxyIndex) const {
+    const int row = proxyIndex.row();
+    const auto columnCount = static_cast<int>(m_columns.size());
+    RowSnapshot* pSnapshot = m_rowCache.object(row);
+    // Columns may have been appended from QML after the row has been cached
+    if (pSnapshot && pSnapshot->display.size() == columnCount) {
+        return *pSnapshot;
+    }
+    pSnapshot = new RowSnapshot;
+    pSnapshot->display.reserve(columnCount);
+    for (int columnIdx = 0; columnIdx < columnCount; ++columnIdx) {
+        pSnapshot->display.append(columnData(proxyIndex, columnIdx, Qt::DisplayRole));
+    }
+    pSnapshot->decoration = decorationData(proxyIndex);
+    m_rowCache.insert(row, pSnapshot);
+    return *pSnapshot;
+}
+
+QVariant QmlLibraryTrackListModel::columnData(
+        const QModelIndex& proxyIndex, int columnIdx, int role) const {
+    const auto& pColumn = m_columns[columnIdx];
+    if (pColumn->columnIdx() < 0) {
+        // Use the column of the list
+        return QIdentityProxyModel::data(proxyIndex.siblingAtColumn(columnIdx), role);
+    }
+    auto* const pTrackTableModel = qobject_cast<BaseTrackTableModel*>(sourceModel());
+    return QIdentityProxyModel::data(
+            proxyIndex.siblingAtColumn(pTrackTableModel != nullptr
+                            ? pTrackTableModel->fieldIndex(
+                                      static_cast<ColumnCache::Column>(
+                                              pColumn->columnIdx()))
+                            : pColumn->columnIdx()),
+            role);
+}
+
+QVariant QmlLibraryTrackListModel::decorationData(const QModelIndex& proxyIndex) const {
+    auto* const pTrackTableModel = qobject_cast<BaseTrackTableModel*>(sourceModel());
+    if (pTrackTableModel == nullptr) {
+        return {};
+    };
+    return colorFromRgbCode(QIdentityProxyModel::data(
+            proxyIndex.siblingAtColumn(pTrackTableModel->fieldIndex(
+                    ColumnCache::COLUMN_LIBRARYTABLE_COLOR)),
+            Qt::DisplayRole)
+                    .toDouble());
+}
+
+QVariant QmlLibraryTrackListModel::coverArtData(const QModelIndex& proxyIndex) const {
+    auto* const pTrackTableModel = qobject_cast<BaseTrackTableModel*>(sourceModel());
+    auto* const pTrackModel = dynamic_cast<TrackModel*>(sourceModel());
+    QString location;
+    if (pTrackTableModel != nullptr) {
+        location = QIdentityProxyModel::data(
+                proxyIndex.siblingAtColumn(pTrackTableModel->fieldIndex(
+                        ColumnCache::COLUMN_TRACKLOCATIONSTABLE_LOCATION)),
+                Qt::DisplayRole)
+                           .toString();
+    } else if (pTrackModel != nullptr) {
+        const auto pTrack = pTrackModel->getTrack(
+                QIdentityProxyModel::mapToSource(proxyIndex));
+        if (!pTrack) {
+            return {};
+        }
+        location = pTrack->getCoverInfo().coverLocation;
+    }
+    if (location.isEmpty()) {
+        return {};
+    }
+
+    return AsyncImageProvider::trackLocationToCoverArtUrl(location);
+}
+
 QVariant QmlLibraryTrackListModel::data(const QModelIndex& proxyIndex, int role) const {
     if (!proxyIndex.isValid()) {
         return {};
@@ -79,11 +195,8 @@ QVariant QmlLibraryTrackListModel::data(const QModelIndex& proxyIndex, int role)
         return {};
     }
 
-    auto* const pTrackTableModel = qobject_cast<BaseTrackTableModel*>(sourceModel());
     auto* const pTrackModel = dynamic_cast<TrackModel*>(sourceModel());
 
-    const auto& pColumn = m_columns[columnIdx];
-
     switch (role) {
     case Track: {
         if (pTrackModel == nullptr) {
@@ -93,34 +206,16 @@ QVariant QmlLibraryTrackListModel::data(const QModelIndex& proxyIndex, int role)
                 QIdentityProxyModel::mapToSource(proxyIndex)));
         return QVariant::fromValue(pTrack.get());
     }
-    case Qt::DecorationRole: {
-        if (pTrackTableModel == nullptr) {
-            return {};
-        };
-        return colorFromRgbCode(QIdentityProxyModel::data(
-                proxyIndex.siblingAtColumn(pTrackTableModel->fieldIndex(
-                        ColumnCache::COLUMN_LIBRARYTABLE_COLOR)),
-                Qt::DisplayRole)
-                        .toDouble());
-    }
+    case Qt::DisplayRole:
+        return rowSnapshot(proxyIndex).display[columnIdx];
+    case Qt::DecorationRole:
+        return rowSnapshot(proxyIndex).decoration;
     case CoverArt: {
-        QString location;
-        if (pTrackTableModel != nullptr) {
-            location = QIdentityProxyModel::data(
-                    proxyIndex.siblingAtColumn(pTrackTableModel->fieldIndex(
-                            ColumnCache::COLUMN_TRACKLOCATIONSTABLE_LOCATION)),
-                    Qt::DisplayRole)
-                               .toString();
-        } else if (pTrackModel != nullptr) {
-            auto pTrack = pTrackModel->getTrack(
-                    QIdentityProxyModel::mapToSource(proxyIndex));
-            location = pTrack->getCoverInfo().coverLocation;
-        }
-        if (location.isEmpty()) {
-            return {};
+        RowSnapshot& snapshot = rowSnapshot(proxyIndex);
+        if (!snapshot.coverArt) {
+            snapshot.coverArt = coverArtData(proxyIndex);
         }
-
-        return AsyncImageProvider::trackLocationToCoverArtUrl(location);
+        return *snapshot.coverArt;
     }
     case FileURL: {
         if (pTrackModel == nullptr) {
@@ -129,20 +224,9 @@ QVariant QmlLibraryTrackListModel::data(const QModelIndex& proxyIndex, int role)
         return pTrackModel->getTrackUrl(QIdentityProxyModel::mapToSource(proxyIndex));
     }
     case Delegate:
-        return QVariant::fromValue(pColumn->delegate());
-        break;
-    }
-    if (pColumn->columnIdx() < 0) {
-        // Use proxyIndex.column()
-        return QIdentityProxyModel::data(proxyIndex, role);
+        return QVariant::fromValue(m_columns[columnIdx]->delegate());
     }
-    return QIdentityProxyModel::data(
-            proxyIndex.siblingAtColumn(pTrackTableModel != nullptr
-                            ? pTrackTableModel->fieldIndex(
-                                      static_cast<ColumnCache::Column>(
-                                              pColumn->columnIdx()))
-                            : pColumn->columnIdx()),
-            role);
+    return columnData(proxyIndex, columnIdx, role);
 }
 
 int QmlLibraryTrackListModel::columnCount(const QModelIndex& parent) const {
@@ -204,6 +288,7 @@ void QmlLibraryTrackListModel::sort(int column, Qt::SortOrder order) {
     const auto& pColumn = m_columns[column];
     emit layoutAboutToBeChanged(QList<QPersistentModelIndex>(),
             QAbstractItemModel::VerticalSortHint);
+    m_rowCache.clear();
     if (pColumn->columnIdx() < 0) {
         // Use proxyIndex.column()
         return sourceModel()->sort(column, order);
@@ -1,6 +1,9 @@
 #pragma once
+#include <QCache>
 #include <QIdentityProxyModel>
 #include <QQmlEngine>
+#include <QVector>
+#include <optional>
 
 #include "library/trackmodel.h"
 #include "qml/qmllibrarytracklistcolumn.h"
@@ -76,8 +79,30 @@ class QmlLibraryTrackListModel : public QIdentityProxyModel {
             int role = Qt::DisplayRole) const override;
     Q_INVOKABLE void sort(int column, Qt::SortOrder order) override;
 
+  private slots:
+    void slotInvalidateRowCache();
+    void slotRowsDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight);
+
   private:
+    // The values of a row that are read by every delegate while scrolling.
+    // They are read once from the source model and kept until the row
+    // changes, which saves the round trip through BaseSqlTableModel::data()
+    // for each delegate and each frame.
+    struct RowSnapshot {
+        QVector<QVariant> display;
+        QVariant decoration;
+        // Only computed when the cover art role is requested, because it
+        // might need to load the track
+        std::optional<QVariant> coverArt;
+    };
+
+    RowSnapshot& rowSnapshot(const QModelIndex& proxyIndex) const;
+    QVariant columnData(const QModelIndex& proxyIndex, int columnIdx, int role) const;
+    QVariant decorationData(const QModelIndex& proxyIndex) const;
+    QVariant coverArtData(const QModelIndex& proxyIndex) const;
+
     std::vector<parented_ptr<QmlLibraryTrackListColumn>> m_columns;
+    mutable QCache<int, RowSnapshot> m_rowCache;
 
     static void parent_qlist_append(
             QQmlListProperty<QmlLibraryTrackListColumn>* p,
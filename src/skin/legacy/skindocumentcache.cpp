@@ -0,0 +1,261 @@
+#include "skin/legacy/skindocumentcache.h"
+
+#include <QDateTime>
+#include <QDomDocument>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtDebug>
+#include <utility>
+
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+#include "util/timer.h"
+
+using mixxx::skin::CompiledSkinCache;
+using mixxx::skin::CompiledSkinDocument;
+using mixxx::skin::SkinDomNode;
+
+namespace {
+
+// Increment whenever the serialized representation changes in a way
+// that is not backward compatible.
+constexpr quint32 kCacheVersion = 2;
+
+} // anonymous namespace
+
+QMutex SkinDocumentCache::s_mutex;
+QHash<QString, SkinDocumentCache::Entry> SkinDocumentCache::s_documents;
+QHash<QString, CompiledSkinDocument> SkinDocumentCache::s_compiledDocuments;
+QString SkinDocumentCache::s_cacheFilePath;
+bool SkinDocumentCache::s_dirty = false;
+
+// static
+QDomElement SkinDocumentCache::loadDocument(
+        const QString& filePath,
+        const QString& docType) {
+    const QFileInfo fileInfo(filePath);
+    const QString absolutePath = fileInfo.absoluteFilePath();
+    if (!fileInfo.isFile()) {
+        qWarning() << "SkinDocumentCache: Could not open file:" << absolutePath;
+        return QDomElement();
+    }
+    // Only the metadata of the file is read for validating a cached entry
+    const FileStamp stamp{fileInfo.size(), fileInfo.lastModified().toMSecsSinceEpoch()};
+
+    const auto locker = lockMutex(&s_mutex);
+    auto it = s_documents.constFind(absolutePath);
+    if (it != s_documents.constEnd() && it->stamp == stamp) {
+        return it->root;
+    }
+
+    QDomElement root = restoreDocument(absolutePath, stamp);
+    if (root.isNull()) {
+        root = parseDocument(absolutePath, docType);
+        if (root.isNull()) {
+            return root;
+        }
+        s_dirty = true;
+    }
+    s_documents.insert(absolutePath, Entry{stamp, docType, root});
+    return root;
+}
+
+// static
+QDomElement SkinDocumentCache::restoreDocument(
+        const QString& filePath,
+        const FileStamp& stamp) {
+    auto it = s_compiledDocuments.find(filePath);
+    if (it == s_compiledDocuments.end()) {
+        return QDomElement();
+    }
+    const CompiledSkinDocument compiled = std::move(it.value());
+    s_compiledDocuments.erase(it);
+    if (FileStamp{compiled.file_size(), compiled.file_last_modified_ms()} != stamp ||
+            !compiled.has_root()) {
+        // Outdated, the file has been modified
+        s_dirty = true;
+        return QDomElement();
+    }
+    QDomDocument document(QString::fromStdString(compiled.doc_type()));
+    document.appendChild(deserializeNode(&document, compiled.root()));
+    return document.documentElement();
+}
+
+// static
+QDomElement SkinDocumentCache::parseDocument(
+        const QString& filePath,
+        const QString& docType) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "SkinDocumentCache: Could not open file:" << filePath;
+        return QDomElement();
+    }
+    const QByteArray content = file.readAll();
+    file.close();
+
+    QDomDocument document(docType);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+    const auto parseResult = document.setContent(content);
+    if (!parseResult) {
+        qWarning() << "SkinDocumentCache: setContent failed see"
+                   << filePath << "line:" << parseResult.errorLine
+                   << "column:" << parseResult.errorColumn;
+        qWarning() << "SkinDocumentCache: message:" << parseResult.errorMessage;
+#else
+    QString errorMessage;
+    int errorLine;
+    int errorColumn;
+
+    if (!document.setContent(content, &errorMessage, &errorLine, &errorColumn)) {
+        qWarning() << "SkinDocumentCache: setContent failed see"
+                   << filePath << "line:" << errorLine << "column:" << errorColumn;
+        qWarning() << "SkinDocumentCache: message:" << errorMessage;
+#endif
+        return QDomElement();
+    }
+    return document.documentElement();
+}
+
+// static
+void SkinDocumentCache::setCacheFile(const QString& cacheFilePath) {
+    const auto locker = lockMutex(&s_mutex);
+    if (s_cacheFilePath == cacheFilePath) {
+        return;
+    }
+    s_cacheFilePath = cacheFilePath;
+    s_compiledDocuments.clear();
+    if (s_cacheFilePath.isEmpty()) {
+        return;
+    }
+
+    QFile file(s_cacheFilePath);
+    if (!file.exists()) {
+        return;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "SkinDocumentCache: Could not open cache file:" << s_cacheFilePath;
+        return;
+    }
+    ScopedTimer timer(QStringLiteral("SkinDocumentCache::setCacheFile"));
+    const QByteArray data = file.readAll();
+    CompiledSkinCache cache;
+    if (!cache.ParseFromArray(data.constData(), static_cast<int>(data.size()))) {
+        qWarning() << "SkinDocumentCache: Failed to parse cache file:" << s_cacheFilePath;
+        return;
+    }
+    if (cache.version() != kCacheVersion) {
+        qInfo() << "SkinDocumentCache: Discarding cache file with version"
+                << cache.version() << s_cacheFilePath;
+        s_dirty = true;
+        return;
+    }
+    for (int i = 0; i < cache.document_size(); ++i) {
+        const CompiledSkinDocument& document = cache.document(i);
+        const QString path = QString::fromStdString(document.path());
+        if (!s_documents.contains(path)) {
+            s_compiledDocuments.insert(path, document);
+        }
+    }
+}
+
+// static
+bool SkinDocumentCache::save() {
+    const auto locker = lockMutex(&s_mutex);
+    if (s_cacheFilePath.isEmpty() || !s_dirty) {
+        return true;
+    }
+    ScopedTimer timer(QStringLiteral("SkinDocumentCache::save"));
+
+    CompiledSkinCache cache;
+    cache.set_version(kCacheVersion);
+    for (auto it = s_documents.constBegin(); it != s_documents.constEnd(); ++it) {
+        CompiledSkinDocument* pDocument = cache.add_document();
+        pDocument->set_path(it.key().toStdString());
+        pDocument->set_file_size(it->stamp.size);
+        pDocument->set_file_last_modified_ms(it->stamp.lastModifiedMs);
+        pDocument->set_doc_type(it->docType.toStdString());
+        serializeNode(it->root, pDocument->mutable_root());
+    }
+    // Keep documents of other skins that have not been loaded this time
+    for (const auto& document : std::as_const(s_compiledDocuments)) {
+        *cache.add_document() = document;
+    }
+
+    const std::string data = cache.SerializeAsString();
+    QSaveFile file(s_cacheFilePath);
+    if (!file.open(QIODevice::WriteOnly) ||
+            file.write(data.data(), static_cast<qint64>(data.size())) !=
+                    static_cast<qint64>(data.size()) ||
+            !file.commit()) {
+        qWarning() << "SkinDocumentCache: Failed to write cache file:"
+                   << s_cacheFilePath << file.errorString();
+        return false;
+    }
+    s_dirty = false;
+    return true;
+}
+
+// static
+void SkinDocumentCache::clear() {
+    const auto locker = lockMutex(&s_mutex);
+    s_documents.clear();
+    s_compiledDocuments.clear();
+    s_cacheFilePath.clear();
+    s_dirty = false;
+}
+
+// static
+void SkinDocumentCache::serializeNode(
+        const QDomNode& node,
+        SkinDomNode* pNode) {
+    if (node.isCDATASection()) {
+        pNode->set_type(SkinDomNode::CDATA);
+        pNode->set_value(node.nodeValue().toStdString());
+        return;
+    }
+    if (node.isText()) {
+        pNode->set_type(SkinDomNode::TEXT);
+        pNode->set_value(node.nodeValue().toStdString());
+        return;
+    }
+    DEBUG_ASSERT(node.isElement());
+    pNode->set_type(SkinDomNode::ELEMENT);
+    pNode->set_value(node.nodeName().toStdString());
+    const QDomNamedNodeMap attributes = node.attributes();
+    for (int i = 0; i < attributes.count(); ++i) {
+        const QDomAttr attribute = attributes.item(i).toAttr();
+        SkinDomNode::Attribute* pAttribute = pNode->add_attribute();
+        pAttribute->set_name(attribute.name().toStdString());
+        pAttribute->set_value(attribute.value().toStdString());
+    }
+    for (QDomNode child = node.firstChild(); !child.isNull(); child = child.nextSibling()) {
+        if (child.isElement() || child.isText()) {
+            serializeNode(child, pNode->add_child());
+        }
+    }
+}
+
+// static
+QDomNode SkinDocumentCache::deserializeNode(
+        QDomDocument* pDocument,
+        const SkinDomNode& node) {
+    switch (node.type()) {
+    case SkinDomNode::TEXT:
+        return pDocument->createTextNode(QString::fromStdString(node.value()));
+    case SkinDomNode::CDATA:
+        return pDocument->createCDATASection(QString::fromStdString(node.value()));
+    case SkinDomNode::ELEMENT:
+        break;
+    }
+    QDomElement element = pDocument->createElement(QString::fromStdString(node.value()));
+    for (int i = 0; i < node.attribute_size(); ++i) {
+        const SkinDomNode::Attribute& attribute = node.attribute(i);
+        element.setAttribute(QString::fromStdString(attribute.name()),
+                QString::fromStdString(attribute.value()));
+    }
+    for (int i = 0; i < node.child_size(); ++i) {
+        element.appendChild(deserializeNode(pDocument, node.child(i)));
+    }
+    return element;
+}
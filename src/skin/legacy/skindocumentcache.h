@@ -0,0 +1,85 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDomElement>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include "proto/skin.pb.h"
+
+// Caches the parsed DOM of skin.xml and template files, so that repeated
+// skin (re)loads don't need to parse the same XML files over and over again.
+//
+// Documents are kept in memory for the lifetime of the process. If a cache
+// file has been configured, the documents are also persisted as a compact
+// protobuf serialization and restored on the next startup. Each entry is
+// keyed by the absolute file path and validated against the size and the
+// modification time of the file, so edited skins are reparsed
+// transparently without reading unmodified files.
+//
+// Only the document structure is cached. Template expansion, variables and
+// script expressions are still evaluated by LegacySkinParser on every load,
+// because their results depend on the configuration and controls at load
+// time.
+//
+// The cache is guarded by a mutex. The returned elements share their nodes
+// with the cache and must not be modified.
+class SkinDocumentCache {
+  public:
+    // Returns the document element of the given XML file or a null element
+    // if the file could not be read or parsed.
+    static QDomElement loadDocument(
+            const QString& filePath,
+            const QString& docType);
+
+    // Restores the cached documents from cacheFilePath and remembers the
+    // path for subsequent calls to save(). Pass an empty string to disable
+    // the persistent cache.
+    static void setCacheFile(const QString& cacheFilePath);
+
+    // Writes all documents that have been loaded so far to the cache file
+    // if the cache contents have changed.
+    static bool save();
+
+    static void clear();
+
+    // Conversion between the DOM and its protobuf representation.
+    static void serializeNode(
+            const QDomNode& node,
+            mixxx::skin::SkinDomNode* pNode);
+    static QDomNode deserializeNode(
+            QDomDocument* pDocument,
+            const mixxx::skin::SkinDomNode& node);
+
+  private:
+    // Identifies the version of a file without reading it
+    struct FileStamp {
+        qint64 size = -1;
+        qint64 lastModifiedMs = -1;
+
+        bool operator==(const FileStamp& other) const {
+            return size == other.size && lastModifiedMs == other.lastModifiedMs;
+        }
+    };
+
+    struct Entry {
+        FileStamp stamp;
+        QString docType;
+        QDomElement root;
+    };
+
+    static QDomElement restoreDocument(
+            const QString& filePath,
+            const FileStamp& stamp);
+    static QDomElement parseDocument(
+            const QString& filePath,
+            const QString& docType);
+
+    static QMutex s_mutex;
+    static QHash<QString, Entry> s_documents;
+    // Documents restored from the cache file that have not been requested yet.
+    static QHash<QString, mixxx::skin::CompiledSkinDocument> s_compiledDocuments;
+    static QString s_cacheFilePath;
+    static bool s_dirty;
+};
@@ -11,10 +11,12 @@
 #include "skin/legacy/launchimage.h"
 #include "skin/legacy/legacyskin.h"
 #include "skin/legacy/legacyskinparser.h"
+#include "skin/legacy/skindocumentcache.h"
 #include "util/debug.h"
 #include "util/timer.h"
 
 const QString kSkinsDirName = QStringLiteral("skins");
+const QString kSkinCacheFileName = QStringLiteral("skincache.bin");
 
 namespace mixxx {
 namespace skin {
@@ -26,10 +28,13 @@ SkinLoader::SkinLoader(UserSettingsPointer pConfig)
           m_spinnyCoverControlsCreated(false),
           m_micDuckingControlsCreated(false),
           m_numMicsEnabled(1) {
+    SkinDocumentCache::setCacheFile(
+            QDir(m_pConfig->getSettingsPath()).filePath(kSkinCacheFileName));
 }
 
 SkinLoader::~SkinLoader() {
     LegacySkinParser::clearSharedGroupStrings();
+    SkinDocumentCache::clear();
 }
 
 QList<SkinPointer> SkinLoader::getUserSkins() const {
@@ -200,6 +205,8 @@ QWidget* SkinLoader::loadConfiguredSkin(QWidget* pParent,
     VERIFY_OR_DEBUG_ASSERT(pLoadedSkin != nullptr) {
         qCritical() << "No skin can be loaded, please check your installation.";
     }
+    // Persist the parsed skin documents for speeding up the next start
+    SkinDocumentCache::save();
     qInfo() << "Loaded skin" << pSkin->name() << "from" << pSkin->path().filePath();
     return pLoadedSkin;
 }
@@ -0,0 +1,128 @@
+#include "soundio/qualitygovernor.h"
+
+#include "control/controlobject.h"
+#include "control/controlproxy.h"
+#include "moc_qualitygovernor.cpp"
+#include "util/assert.h"
+#include "util/logger.h"
+#include "util/time.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("QualityGovernor");
+
+const QString kAppGroup = QStringLiteral("[App]");
+
+const ConfigKey kEnabledConfigKey =
+        ConfigKey(kAppGroup, QStringLiteral("quality_governor_enabled"));
+const ConfigKey kHighWatermarkConfigKey =
+        ConfigKey(kAppGroup, QStringLiteral("quality_governor_high_watermark"));
+const ConfigKey kLowWatermarkConfigKey =
+        ConfigKey(kAppGroup, QStringLiteral("quality_governor_low_watermark"));
+
+// Fractions of the audio callback period spent in the callback
+constexpr double kDefaultHighWatermark = 0.8;
+constexpr double kDefaultLowWatermark = 0.5;
+
+// A single long callback, e.g. caused by loading a track, should
+// not reduce the quality. A sustained overload has to be detected
+// early enough to prevent the next dropout.
+constexpr Duration kOverloadDuration = Duration::fromMillis(200);
+// Restoring the quality is done step by step and much more
+// conservatively to avoid oscillation.
+constexpr Duration kRecoveryDuration = Duration::fromSeconds(10);
+
+} // anonymous namespace
+
+QualityGovernor::QualityGovernor(UserSettingsPointer pConfig, QObject* pParent)
+        : QObject(pParent),
+          m_enabled(pConfig->getValue(kEnabledConfigKey, true)),
+          m_highWatermark(pConfig->getValue(kHighWatermarkConfigKey, kDefaultHighWatermark)),
+          m_lowWatermark(pConfig->getValue(kLowWatermarkConfigKey, kDefaultLowWatermark)),
+          m_pAudioLatencyUsage(new ControlProxy(
+                  kAppGroup, QStringLiteral("audio_latency_usage"), this)),
+          m_pQualityReduction(std::make_unique<ControlObject>(
+                  ConfigKey(kAppGroup, QStringLiteral("quality_reduction")))),
+          m_level(Level::Full) {
+    m_pQualityReduction->setReadOnly();
+    if (!m_enabled) {
+        kLogger.info() << "Disabled";
+        return;
+    }
+    VERIFY_OR_DEBUG_ASSERT(m_lowWatermark < m_highWatermark) {
+        kLogger.warning() << "Invalid watermarks"
+                          << m_lowWatermark << m_highWatermark;
+        return;
+    }
+    m_pAudioLatencyUsage->connectValueChanged(
+            this, &QualityGovernor::slotAudioLatencyUsageChanged);
+}
+
+QualityGovernor::~QualityGovernor() = default;
+
+// static
+QString QualityGovernor::levelName(Level level) {
+    switch (level) {
+    case Level::Full:
+        return QStringLiteral("full");
+    case Level::Reduced:
+        return QStringLiteral("reduced");
+    case Level::Minimal:
+        return QStringLiteral("minimal");
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return QString();
+}
+
+void QualityGovernor::slotAudioLatencyUsageChanged(double usage) {
+    const Duration now = Time::elapsed();
+    if (usage > m_highWatermark) {
+        m_relaxedSince = Duration::empty();
+        if (m_overloadedSince == Duration::empty()) {
+            m_overloadedSince = now;
+        } else if (now - m_overloadedSince >= kOverloadDuration &&
+                m_level != Level::Minimal) {
+            // Reduce one step at a time and give the engine
+            // the chance to settle before reducing further.
+            m_overloadedSince = now;
+            setLevel(static_cast<Level>(static_cast<int>(m_level) + 1), usage);
+        }
+    } else if (usage < m_lowWatermark) {
+        m_overloadedSince = Duration::empty();
+        if (m_relaxedSince == Duration::empty()) {
+            m_relaxedSince = now;
+        } else if (now - m_relaxedSince >= kRecoveryDuration &&
+                m_level != Level::Full) {
+            m_relaxedSince = now;
+            setLevel(static_cast<Level>(static_cast<int>(m_level) - 1), usage);
+        }
+    } else {
+        // Within the hysteresis band
+        m_overloadedSince = Duration::empty();
+        m_relaxedSince = Duration::empty();
+    }
+}
+
+void QualityGovernor::setLevel(Level level, double usage) {
+    if (level == m_level) {
+        return;
+    }
+    if (level > m_level) {
+        kLogger.warning() << "Reducing quality from" << levelName(m_level)
+                          << "to" << levelName(level)
+                          << "at an audio latency usage of"
+                          << qRound(usage * 100) << "%";
+    } else {
+        kLogger.info() << "Restoring quality from" << levelName(m_level)
+                       << "to" << levelName(level)
+                       << "at an audio latency usage of"
+                       << qRound(usage * 100) << "%";
+    }
+    m_level = level;
+    m_pQualityReduction->forceSet(static_cast<double>(level));
+    emit levelChanged(level);
+}
+
+} // namespace mixxx
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QObject>
+#include <memory>
+
+#include "preferences/usersettings.h"
+#include "util/duration.h"
+
+class ControlObject;
+class ControlProxy;
+
+namespace mixxx {
+
+/// Watches the share of the audio callback period that is spent processing
+/// (see [App],audio_latency_usage) and temporarily reduces the quality of
+/// costly features before the engine misses its deadline and drops out.
+///
+/// The current level is published as the read-only control
+/// [App],quality_reduction and emitted as levelChanged(). Each consumer
+/// decides on its own what to degrade at which level:
+///  - EngineBuffer steps down the keylock engine of non-audible decks
+///    from RubberBand R3 to R2 (Reduced) and to SoundTouch (Minimal).
+///  - WaveformWidgetFactory lowers the waveform frame rate.
+///  - Library suspends the batch analysis (Minimal).
+///
+/// The level is raised quickly when the load exceeds the high watermark
+/// and only lowered again after the load has stayed below the low
+/// watermark for a while, to avoid toggling back and forth.
+class QualityGovernor : public QObject {
+    Q_OBJECT
+  public:
+    enum class Level {
+        Full = 0,
+        Reduced = 1,
+        Minimal = 2,
+    };
+    Q_ENUM(Level)
+
+    explicit QualityGovernor(UserSettingsPointer pConfig, QObject* pParent = nullptr);
+    ~QualityGovernor() override;
+
+    Level level() const {
+        return m_level;
+    }
+
+    static QString levelName(Level level);
+
+  signals:
+    void levelChanged(mixxx::QualityGovernor::Level level);
+
+  private slots:
+    void slotAudioLatencyUsageChanged(double usage);
+
+  private:
+    void setLevel(Level level, double usage);
+
+    const bool m_enabled;
+    const double m_highWatermark;
+    const double m_lowWatermark;
+
+    ControlProxy* m_pAudioLatencyUsage;
+    std::unique_ptr<ControlObject> m_pQualityReduction;
+
+    Level m_level;
+    /// Start of the period in which the load has continuously been above
+    /// the high or below the low watermark, respectively. Empty if the
+    /// load is currently not in that range.
+    Duration m_overloadedSince;
+    Duration m_relaxedSince;
+};
+
+} // namespace mixxx
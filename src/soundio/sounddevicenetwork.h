@@ -15,6 +15,7 @@
 #include "soundio/sounddevice.h"
 #include "util/fifo.h"
 #include "util/performancetimer.h"
+#include "util/realtimethreads.h"
 
 #define CPU_USAGE_UPDATE_RATE 30 // in 1/s, fits to display frame rate
 #define CPU_OVERLOAD_DURATION 500 // in ms
@@ -95,6 +96,9 @@ class SoundDeviceNetworkThread : public QThread {
             qWarning() << "SoundDeviceNetworkThread: Failed bumping priority";
         }
 #endif
+        // Overrides the default priority if configured
+        mixxx::RealtimeThreads::applyToCurrentThread(
+                mixxx::RealtimeThreads::ThreadClass::AudioCallback);
 
         while(!m_stop) {
             m_pParent->callbackProcessClkRef();
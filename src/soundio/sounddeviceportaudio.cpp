@@ -16,6 +16,7 @@
 #include "util/denormalsarezero.h"
 #include "util/fifo.h"
 #include "util/math.h"
+#include "util/realtimethreads.h"
 #include "util/sample.h"
 #include "util/timer.h"
 #include "util/trace.h"
@@ -966,6 +967,8 @@ int SoundDevicePortAudio::callbackProcessClkRef(
     //qDebug() << "SoundDevicePortAudio::callbackProcess:" << m_deviceId;
 
     if (!m_bSetThreadPriority) {
+        mixxx::RealtimeThreads::applyToCurrentThread(
+                mixxx::RealtimeThreads::ThreadClass::AudioCallback);
 #ifdef __LINUX__
         // Verify if we are a thread with "real-time" policy.
         // The audio thread on Linux should be set to SCHED_FIFO with a priority
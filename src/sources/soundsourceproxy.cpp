@@ -713,6 +713,14 @@ SoundSourceProxy::UpdateTrackFromSourceResult SoundSourceProxy::updateTrackFromS
         }
     }
 
+    // Serato tags that would be discarded after a full import are not
+    // even parsed
+    const bool importSeratoTags = !updateMetadataFromSource ||
+            shouldImportSeratoTagsFromSource(sourceSyncStatus, syncParams);
+    if (!importSeratoTags) {
+        trackMetadata.refTrackInfo().refSeratoTags().disableImport();
+    }
+
     // Parse the tags stored in the audio file and the date and time when the
     // file has been last modified to detect future changes of the tags.
     auto [metadataImportResult, sourceSynchronizedAt] =
@@ -766,7 +774,7 @@ SoundSourceProxy::UpdateTrackFromSourceResult SoundSourceProxy::updateTrackFromS
 
     // Full import
     DEBUG_ASSERT(updateMetadataFromSource);
-    if (!shouldImportSeratoTagsFromSource(sourceSyncStatus, syncParams)) {
+    if (!importSeratoTags) {
         // Reset Serato tags to disable the (re-)import
         trackMetadata.refTrackInfo().refSeratoTags() = {};
     }
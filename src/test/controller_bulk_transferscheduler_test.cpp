@@ -0,0 +1,243 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "controllers/bulk/bulktransferscheduler.h"
+#include "controllers/bulk/bulktransport.h"
+
+namespace {
+
+const RuntimeLoggingCategory kLogger(QStringLiteral("test"));
+
+/// Records the submitted transfers, which are completed by the test.
+class MockBulkTransport : public BulkTransport {
+  public:
+    struct Transfer {
+        bool isInput;
+        QByteArray data;
+        Callback callback;
+    };
+
+    bool submitInput(int length, Callback callback) override {
+        m_transfers.push_back(Transfer{true, QByteArray(length, '\0'), std::move(callback)});
+        return true;
+    }
+
+    bool submitOutput(const QByteArray& data, Callback callback) override {
+        m_transfers.push_back(Transfer{false, data, std::move(callback)});
+        return true;
+    }
+
+    void cancelAll() override {
+        ++m_cancelCount;
+    }
+
+    int countTransfers(bool isInput) const {
+        return static_cast<int>(std::count_if(m_transfers.begin(),
+                m_transfers.end(),
+                [isInput](const Transfer& transfer) {
+                    return transfer.isInput == isInput;
+                }));
+    }
+
+    /// Completes the oldest transfer of the given direction.
+    QByteArray complete(bool isInput, Status status, const QByteArray& data = {}) {
+        const auto it = std::find_if(m_transfers.begin(),
+                m_transfers.end(),
+                [isInput](const Transfer& transfer) {
+                    return transfer.isInput == isInput;
+                });
+        EXPECT_NE(it, m_transfers.end());
+        if (it == m_transfers.end()) {
+            return {};
+        }
+        Transfer transfer = std::move(*it);
+        m_transfers.erase(it);
+        transfer.callback(status, data);
+        return transfer.data;
+    }
+
+    int cancelCount() const {
+        return m_cancelCount;
+    }
+
+  private:
+    std::vector<Transfer> m_transfers;
+    int m_cancelCount = 0;
+};
+
+class BulkTransferSchedulerTest : public ::testing::Test {
+  protected:
+    BulkTransferSchedulerTest()
+            : m_scheduler(&m_transport, kLogger) {
+    }
+
+    ~BulkTransferSchedulerTest() override {
+        // Complete the cancelled transfers, so the scheduler can be destroyed
+        m_scheduler.requestShutdown();
+        while (m_transport.countTransfers(true) > 0) {
+            m_transport.complete(true, BulkTransport::Status::Cancelled);
+        }
+        while (m_transport.countTransfers(false) > 0) {
+            m_transport.complete(false, BulkTransport::Status::Cancelled);
+        }
+    }
+
+    MockBulkTransport m_transport;
+    BulkTransferScheduler m_scheduler;
+};
+
+TEST_F(BulkTransferSchedulerTest, inputIsResubmitted) {
+    std::vector<QByteArray> received;
+    ASSERT_TRUE(m_scheduler.startInput(64, [&received](const QByteArray& data) {
+        received.push_back(data);
+    }));
+    EXPECT_EQ(BulkTransferScheduler::kInputTransfersInFlight,
+            m_transport.countTransfers(true));
+
+    m_transport.complete(true, BulkTransport::Status::Completed, QByteArray("\x01\x02", 2));
+    m_transport.complete(true, BulkTransport::Status::TimedOut);
+    m_transport.complete(true, BulkTransport::Status::Completed, QByteArray("\x03", 1));
+    ASSERT_EQ(2u, received.size());
+    EXPECT_EQ(QByteArray("\x01\x02", 2), received[0]);
+    EXPECT_EQ(QByteArray("\x03", 1), received[1]);
+    EXPECT_EQ(BulkTransferScheduler::kInputTransfersInFlight,
+            m_transport.countTransfers(true));
+    EXPECT_EQ(BulkTransferScheduler::kInputTransfersInFlight,
+            m_scheduler.inputTransfersInFlight());
+
+    // Transient failures are resubmitted
+    m_transport.complete(true, BulkTransport::Status::Error);
+    m_transport.complete(true, BulkTransport::Status::Stall);
+    m_transport.complete(true, BulkTransport::Status::Error);
+    EXPECT_EQ(2u, received.size());
+    EXPECT_EQ(BulkTransferScheduler::kInputTransfersInFlight,
+            m_transport.countTransfers(true));
+    EXPECT_EQ(BulkTransferScheduler::kInputTransfersInFlight,
+            m_scheduler.inputTransfersInFlight());
+
+    m_scheduler.stopInput();
+    m_transport.complete(true, BulkTransport::Status::Completed, QByteArray("\x04", 1));
+    m_transport.complete(true, BulkTransport::Status::Error);
+    EXPECT_EQ(2u, received.size());
+    EXPECT_EQ(BulkTransferScheduler::kInputTransfersInFlight - 2,
+            m_transport.countTransfers(true));
+}
+
+TEST_F(BulkTransferSchedulerTest, outputIsQueuedInOrder) {
+    EXPECT_TRUE(m_scheduler.send("a"));
+    EXPECT_TRUE(m_scheduler.send("b"));
+    EXPECT_TRUE(m_scheduler.send("c"));
+    EXPECT_TRUE(m_scheduler.send("d"));
+    EXPECT_EQ(BulkTransferScheduler::kMaxOutputTransfersInFlight,
+            m_transport.countTransfers(false));
+    EXPECT_EQ(2, m_scheduler.queuedOutputs());
+
+    EXPECT_EQ("a", m_transport.complete(false, BulkTransport::Status::Completed));
+    EXPECT_EQ("b", m_transport.complete(false, BulkTransport::Status::Completed));
+    EXPECT_EQ("c", m_transport.complete(false, BulkTransport::Status::Completed));
+    EXPECT_EQ("d", m_transport.complete(false, BulkTransport::Status::Completed));
+    EXPECT_EQ(0, m_transport.countTransfers(false));
+    EXPECT_EQ(0, m_scheduler.queuedOutputs());
+}
+
+TEST_F(BulkTransferSchedulerTest, identicalQueuedOutputIsCoalesced) {
+    EXPECT_TRUE(m_scheduler.send("a"));
+    EXPECT_TRUE(m_scheduler.send("b"));
+    EXPECT_TRUE(m_scheduler.send("c"));
+    EXPECT_TRUE(m_scheduler.send("d"));
+    // Coalesced with the last queued copy
+    EXPECT_TRUE(m_scheduler.send("d"));
+    EXPECT_EQ(2, m_scheduler.queuedOutputs());
+    // Not coalesced with an earlier copy, which would change the order
+    EXPECT_TRUE(m_scheduler.send("c"));
+    // Not coalesced with a submitted copy
+    EXPECT_TRUE(m_scheduler.send("a"));
+    EXPECT_EQ(4, m_scheduler.queuedOutputs());
+
+    EXPECT_EQ("a", m_transport.complete(false, BulkTransport::Status::Completed));
+    EXPECT_EQ("b", m_transport.complete(false, BulkTransport::Status::Completed));
+    EXPECT_EQ("c", m_transport.complete(false, BulkTransport::Status::Completed));
+    EXPECT_EQ("d", m_transport.complete(false, BulkTransport::Status::Completed));
+    EXPECT_EQ("c", m_transport.complete(false, BulkTransport::Status::Completed));
+    EXPECT_EQ("a", m_transport.complete(false, BulkTransport::Status::Completed));
+    EXPECT_EQ(0, m_transport.countTransfers(false));
+}
+
+TEST_F(BulkTransferSchedulerTest, fullQueueRejectsOutput) {
+    const int count = BulkTransferScheduler::kMaxOutputTransfersInFlight +
+            BulkTransferScheduler::kMaxQueuedOutputs;
+    for (int i = 0; i < count; ++i) {
+        EXPECT_TRUE(m_scheduler.send(QByteArray::number(i)));
+    }
+    EXPECT_EQ(BulkTransferScheduler::kMaxQueuedOutputs, m_scheduler.queuedOutputs());
+
+    // Nothing is dropped, because the data might depend on the previous one
+    EXPECT_FALSE(m_scheduler.send(QByteArray::number(count)));
+    EXPECT_EQ(BulkTransferScheduler::kMaxQueuedOutputs, m_scheduler.queuedOutputs());
+    // Coalescing with the last queued copy doesn't need more space
+    EXPECT_TRUE(m_scheduler.send(QByteArray::number(count - 1)));
+    EXPECT_EQ(BulkTransferScheduler::kMaxQueuedOutputs, m_scheduler.queuedOutputs());
+
+    EXPECT_EQ("0", m_transport.complete(false, BulkTransport::Status::Completed));
+    EXPECT_TRUE(m_scheduler.send(QByteArray::number(count)));
+    EXPECT_EQ("1", m_transport.complete(false, BulkTransport::Status::Completed));
+    EXPECT_EQ("2", m_transport.complete(false, BulkTransport::Status::Completed));
+}
+
+TEST_F(BulkTransferSchedulerTest, shutdownSendsQueuedOutputBeforeCancelling) {
+    ASSERT_TRUE(m_scheduler.startInput(64, [](const QByteArray&) {}));
+    EXPECT_TRUE(m_scheduler.send("a"));
+    EXPECT_TRUE(m_scheduler.send("b"));
+    EXPECT_TRUE(m_scheduler.send("c"));
+
+    m_scheduler.requestShutdown();
+    EXPECT_FALSE(m_scheduler.send("d"));
+    EXPECT_EQ(0, m_transport.cancelCount());
+
+    m_transport.complete(false, BulkTransport::Status::Completed);
+    m_transport.complete(false, BulkTransport::Status::Completed);
+    EXPECT_EQ(0, m_transport.cancelCount());
+    EXPECT_EQ("c", m_transport.complete(false, BulkTransport::Status::Completed));
+    EXPECT_EQ(1, m_transport.cancelCount());
+    EXPECT_FALSE(m_scheduler.waitForShutdown(0));
+
+    // Cancelled input transfers are not resubmitted
+    while (m_transport.countTransfers(true) > 0) {
+        m_transport.complete(true, BulkTransport::Status::Cancelled);
+    }
+    EXPECT_EQ(0, m_scheduler.inputTransfersInFlight());
+    EXPECT_TRUE(m_scheduler.waitForShutdown(0));
+}
+
+TEST_F(BulkTransferSchedulerTest, shutdownTimeoutCancelsQueuedOutput) {
+    EXPECT_TRUE(m_scheduler.send("a"));
+    EXPECT_TRUE(m_scheduler.send("b"));
+    EXPECT_TRUE(m_scheduler.send("c"));
+
+    m_scheduler.requestShutdown();
+    EXPECT_FALSE(m_scheduler.waitForShutdown(0));
+    EXPECT_EQ(1, m_transport.cancelCount());
+    EXPECT_EQ(0, m_scheduler.queuedOutputs());
+
+    m_transport.complete(false, BulkTransport::Status::Cancelled);
+    m_transport.complete(false, BulkTransport::Status::Cancelled);
+    EXPECT_EQ(0, m_transport.countTransfers(false));
+    EXPECT_TRUE(m_scheduler.waitForShutdown(0));
+}
+
+TEST_F(BulkTransferSchedulerTest, disconnectedDevice) {
+    ASSERT_TRUE(m_scheduler.startInput(64, [](const QByteArray&) {}));
+    EXPECT_TRUE(m_scheduler.send("a"));
+    EXPECT_TRUE(m_scheduler.send("b"));
+    EXPECT_TRUE(m_scheduler.send("c"));
+
+    m_transport.complete(true, BulkTransport::Status::NoDevice);
+    EXPECT_EQ(0, m_scheduler.queuedOutputs());
+    EXPECT_FALSE(m_scheduler.send("d"));
+    EXPECT_EQ(BulkTransferScheduler::kInputTransfersInFlight - 1,
+            m_transport.countTransfers(true));
+}
+
+} // anonymous namespace
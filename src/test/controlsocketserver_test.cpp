@@ -0,0 +1,63 @@
+#include "control/controlsocketserver.h"
+
+#include <gtest/gtest.h>
+
+#include <QCoreApplication>
+#include <QSignalSpy>
+#include <memory>
+
+#include "control/controlobject.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+const ConfigKey kPlayKey = ConfigKey(QStringLiteral("[Channel1]"), QStringLiteral("play"));
+
+class ControlSocketServerTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        m_pPlay = std::make_unique<ControlObject>(kPlayKey);
+    }
+
+    std::unique_ptr<ControlObject> m_pPlay;
+    mixxx::ControlSocketServer m_server;
+};
+
+TEST_F(ControlSocketServerTest, GetAndSet) {
+    EXPECT_EQ(QStringLiteral("0"), m_server.handleRequest(QStringLiteral("get [Channel1],play")));
+    EXPECT_EQ(QStringLiteral("ok"),
+            m_server.handleRequest(QStringLiteral("set [Channel1],play 1")));
+    EXPECT_EQ(1.0, m_pPlay->get());
+    EXPECT_EQ(QStringLiteral("1"), m_server.handleRequest(QStringLiteral("get [Channel1],play")));
+}
+
+TEST_F(ControlSocketServerTest, InvalidRequests) {
+    EXPECT_TRUE(m_server.handleRequest(QStringLiteral("get [Channel1],nonexistent"))
+                        .startsWith(QStringLiteral("error ")));
+    EXPECT_TRUE(m_server.handleRequest(QStringLiteral("set [Channel1],play on"))
+                        .startsWith(QStringLiteral("error ")));
+    EXPECT_TRUE(m_server.handleRequest(QStringLiteral("set [Channel1],play"))
+                        .startsWith(QStringLiteral("error ")));
+    EXPECT_TRUE(m_server.handleRequest(QStringLiteral("play"))
+                        .startsWith(QStringLiteral("error ")));
+    EXPECT_EQ(0.0, m_pPlay->get());
+}
+
+TEST_F(ControlSocketServerTest, Quit) {
+    QSignalSpy spy(&m_server, &mixxx::ControlSocketServer::quitRequested);
+    EXPECT_EQ(QStringLiteral("ok"), m_server.handleRequest(QStringLiteral("quit")));
+    EXPECT_EQ(1, spy.count());
+}
+
+#ifndef Q_OS_WIN
+// Named pipes on Windows can have multiple server instances
+TEST_F(ControlSocketServerTest, SocketInUseIsNotTakenOver) {
+    const QString name = QStringLiteral("mixxx-control-test-%1")
+                                 .arg(QCoreApplication::applicationPid());
+    ASSERT_TRUE(m_server.listen(name));
+    mixxx::ControlSocketServer otherServer;
+    EXPECT_FALSE(otherServer.listen(name));
+}
+#endif
+
+} // namespace
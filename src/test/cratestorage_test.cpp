@@ -2,6 +2,7 @@
 
 #include "library/trackset/crate/crate.h"
 #include "test/librarytest.h"
+#include "track/track.h"
 
 class CrateStorageTest : public LibraryTest {
   protected:
@@ -65,3 +66,39 @@ TEST_F(CrateStorageTest, persistentLifecycle) {
     EXPECT_FALSE(m_crateStorage.readCrateByName(kNewCrateName));
     EXPECT_EQ(kNumCrates - 1, m_crateStorage.countCrates());
 }
+
+TEST_F(CrateStorageTest, crateTrackIndex) {
+    const CrateStorage& crates = internalCollection()->crates();
+
+    Crate crate;
+    crate.setName(QStringLiteral("Index"));
+    CrateId crateId;
+    ASSERT_TRUE(internalCollection()->insertCrate(crate, &crateId));
+
+    const TrackPointer pTrackA = getOrAddTrackByLocation(getTestDir().filePath(
+            QStringLiteral("id3-test-data/cover-test-jpg.mp3")));
+    const TrackPointer pTrackB = getOrAddTrackByLocation(getTestDir().filePath(
+            QStringLiteral("id3-test-data/cover-test-png.mp3")));
+    ASSERT_TRUE(pTrackA && pTrackB);
+    const quint32 trackA = CrateStorage::trackIdIndexValue(pTrackA->getId());
+    const quint32 trackB = CrateStorage::trackIdIndexValue(pTrackB->getId());
+
+    // Load the index before modifying the crate
+    EXPECT_TRUE(crates.crateTrackIds(crateId).isEmpty());
+
+    ASSERT_TRUE(internalCollection()->addCrateTracks(
+            crateId, QList<TrackId>{pTrackA->getId(), pTrackB->getId()}));
+    EXPECT_EQ((std::vector<quint32>{trackA, trackB}),
+            crates.crateTrackIds(crateId).toVector());
+    EXPECT_EQ(crates.crateTrackIds(crateId),
+            crates.collectTrackIdsByCrateNameLike(QStringLiteral("nde")));
+    EXPECT_TRUE(crates.collectTrackIdsByCrateNameLike(QStringLiteral("other")).isEmpty());
+
+    ASSERT_TRUE(internalCollection()->removeCrateTracks(
+            crateId, QList<TrackId>{pTrackA->getId()}));
+    EXPECT_EQ(std::vector<quint32>{trackB}, crates.crateTrackIds(crateId).toVector());
+
+    ASSERT_TRUE(internalCollection()->purgeTracks(QList<TrackId>{pTrackB->getId()}));
+    EXPECT_TRUE(crates.crateTrackIds(crateId).isEmpty());
+    EXPECT_TRUE(crates.collectTrackIdsWithCrate().isEmpty());
+}
@@ -14,6 +14,8 @@
 #include "test/mixxxtest.h"
 #include "test/mockedenginebackendtest.h"
 #include "test/signalpathtest.h"
+#include "util/inputeventtime.h"
+#include "util/time.h"
 
 // In case any of the test in this file fail. You can use the audioplot.py tool
 // in the tools folder to visually compare the results of the enginebuffer
@@ -231,6 +233,47 @@ TEST_F(EngineBufferTest, ResetPitchAdjustUsesLinear) {
     EXPECT_EQ(m_pMockScaleVinyl1, m_pChannel1->getEngineBuffer()->m_pScale);
 }
 
+TEST_F(EngineBufferTest, SeekAtInputEventOffset) {
+    mixxx::Time::setTestMode(true);
+    mixxx::Time::addTestTime(std::chrono::seconds(1));
+    ControlObject::set(ConfigKey(m_sGroup1, "quantize"), 0.0);
+    ControlObject::set(ConfigKey(m_sGroup1, "play"), 1.0);
+    ProcessBuffer();
+    ProcessBuffer();
+
+    EngineBuffer* pEngineBuffer = m_pChannel1->getEngineBuffer();
+    {
+        const mixxx::ScopedInputEventTime eventTime(mixxx::Time::elapsed());
+        pEngineBuffer->queueNewPlaypos(mixxx::audio::FramePos(10000), EngineBuffer::SEEK_EXACT);
+    }
+    // An event that has just been received is rendered one buffer later,
+    // i.e. at the last frame of this buffer
+    pEngineBuffer->processSeek(false, kProcessBufferSize);
+    EXPECT_EQ(mixxx::audio::FramePos(10000), pEngineBuffer->m_playPos);
+    EXPECT_EQ(kProcessBufferSize / 2 - 1, pEngineBuffer->m_seekFrameOffset);
+    mixxx::Time::setTestMode(false);
+}
+
+TEST_F(EngineBufferTest, PhaseSeekAtBufferStart) {
+    mixxx::Time::setTestMode(true);
+    mixxx::Time::addTestTime(std::chrono::seconds(1));
+    ControlObject::set(ConfigKey(m_sGroup1, "play"), 1.0);
+    ProcessBuffer();
+    ProcessBuffer();
+
+    EngineBuffer* pEngineBuffer = m_pChannel1->getEngineBuffer();
+    {
+        const mixxx::ScopedInputEventTime eventTime(mixxx::Time::elapsed());
+        pEngineBuffer->queueNewPlaypos(
+                mixxx::audio::FramePos(10000), EngineBuffer::SEEK_EXACT_PHASE);
+    }
+    // The beat matched target is only valid for the start of the buffer
+    pEngineBuffer->processSeek(false, kProcessBufferSize);
+    EXPECT_TRUE(pEngineBuffer->m_playPos.isValid());
+    EXPECT_EQ(0, pEngineBuffer->m_seekFrameOffset);
+    mixxx::Time::setTestMode(false);
+}
+
 TEST_F(EngineBufferE2ETest, SoundTouchCrashTest) {
     // Soundtouch has a bug where a pitch value of zero causes an infinite loop
     // and crash.
@@ -1,5 +1,6 @@
 #include "track/globaltrackcache.h"
 
+#include <QCoreApplication>
 #include <QThread>
 #include <QtDebug>
 #include <atomic>
@@ -75,6 +76,41 @@ class GlobalTrackCacheTest: public MixxxTest, public virtual GlobalTrackCacheSav
   public:
     void saveEvictedTrack(Track* pTrack) noexcept override {
         ASSERT_FALSE(pTrack == nullptr);
+        if (m_accessCacheWhileSaving) {
+            // Other threads must be able to access the cache while
+            // an evicted track is saved
+            QThread* pThread = QThread::create([] {
+                GlobalTrackCacheLocker().isEmpty();
+            });
+            pThread->start();
+            m_cacheAccessedWhileSaving = pThread->wait(10000);
+            if (m_cacheAccessedWhileSaving) {
+                delete pThread;
+            } else {
+                // The thread is still blocked and must not be deleted
+                QObject::connect(pThread, &QThread::finished, pThread, &QObject::deleteLater);
+            }
+        }
+    }
+
+    bool needsMetadataExport(Track* pTrack) noexcept override {
+        Q_UNUSED(pTrack);
+        return m_exportMetadata;
+    }
+
+    ExportTrackMetadataResult exportEvictedTrackMetadata(Track* pTrack) noexcept override {
+        EXPECT_FALSE(pTrack == nullptr);
+        m_exportedOnWriterThread =
+                QThread::currentThread() != QCoreApplication::instance()->thread();
+        return ExportTrackMetadataResult::Succeeded;
+    }
+
+    void saveExportedTrack(
+            Track* pTrack,
+            ExportTrackMetadataResult exportResult) noexcept override {
+        EXPECT_FALSE(pTrack == nullptr);
+        EXPECT_EQ(ExportTrackMetadataResult::Succeeded, exportResult);
+        ++m_numSavedExportedTracks;
     }
 
   protected:
@@ -86,6 +122,11 @@ class GlobalTrackCacheTest: public MixxxTest, public virtual GlobalTrackCacheSav
     }
 
     TrackPointer m_recentTrackPtr;
+    bool m_accessCacheWhileSaving = false;
+    bool m_cacheAccessedWhileSaving = false;
+    bool m_exportMetadata = false;
+    std::atomic<bool> m_exportedOnWriterThread{false};
+    int m_numSavedExportedTracks = 0;
 };
 
 TEST_F(GlobalTrackCacheTest, resolveByFileInfo) {
@@ -235,3 +276,58 @@ TEST_F(GlobalTrackCacheTest, evictWhileMoving) {
 
     EXPECT_TRUE(GlobalTrackCacheLocker().isEmpty());
 }
+
+TEST_F(GlobalTrackCacheTest, accessCacheWhileSaving) {
+    ASSERT_TRUE(GlobalTrackCacheLocker().isEmpty());
+
+    TrackPointer track = GlobalTrackCacheResolver(
+            mixxx::FileAccess(mixxx::FileInfo(getTestDir().filePath(kTestFile))))
+                                 .getTrack();
+    EXPECT_TRUE(static_cast<bool>(track));
+
+    m_accessCacheWhileSaving = true;
+    track.reset();
+
+    EXPECT_TRUE(m_cacheAccessedWhileSaving);
+    EXPECT_TRUE(GlobalTrackCacheLocker().isEmpty());
+}
+
+TEST_F(GlobalTrackCacheTest, exportMetadataOnWriterThread) {
+    ASSERT_TRUE(GlobalTrackCacheLocker().isEmpty());
+
+    m_exportMetadata = true;
+    TrackPointer track = GlobalTrackCacheResolver(
+            mixxx::FileAccess(mixxx::FileInfo(getTestDir().filePath(kTestFile))))
+                                 .getTrack();
+    EXPECT_TRUE(static_cast<bool>(track));
+    track.reset();
+    EXPECT_TRUE(GlobalTrackCacheLocker().isEmpty());
+
+    // The track is saved on the main thread after exporting its metadata
+    for (int i = 0; i < 1000 && m_numSavedExportedTracks == 0; ++i) {
+        QThread::msleep(10);
+        QCoreApplication::processEvents();
+    }
+    EXPECT_EQ(1, m_numSavedExportedTracks);
+    EXPECT_TRUE(m_exportedOnWriterThread);
+}
+
+TEST_F(GlobalTrackCacheTest, resolveWhileExportingMetadata) {
+    ASSERT_TRUE(GlobalTrackCacheLocker().isEmpty());
+
+    m_exportMetadata = true;
+    const auto testFileAccess = mixxx::FileAccess(
+            mixxx::FileInfo(getTestDir().filePath(kTestFile)));
+    TrackPointer track = GlobalTrackCacheResolver(testFileAccess).getTrack();
+    EXPECT_TRUE(static_cast<bool>(track));
+    track.reset();
+
+    // Resolving the same file again must wait until the evicted
+    // track has been saved without processing events
+    track = GlobalTrackCacheResolver(testFileAccess).getTrack();
+    EXPECT_TRUE(static_cast<bool>(track));
+    EXPECT_EQ(1, m_numSavedExportedTracks);
+
+    m_exportMetadata = false;
+    track.reset();
+}
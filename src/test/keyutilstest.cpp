@@ -307,3 +307,18 @@ TEST_F(KeyUtilsTest, GetCompatibleKeys) {
                     mixxx::track::io::key::A_MINOR,
                     mixxx::track::io::key::G_MINOR));
 }
+
+TEST_F(KeyUtilsTest, CamelotDistance) {
+    using namespace mixxx::track::io::key;
+    EXPECT_EQ(0, KeyUtils::camelotDistance(C_MAJOR, C_MAJOR));
+    // Relative minor
+    EXPECT_EQ(1, KeyUtils::camelotDistance(C_MAJOR, A_MINOR));
+    // Dominant and sub-dominant
+    EXPECT_EQ(1, KeyUtils::camelotDistance(C_MAJOR, G_MAJOR));
+    EXPECT_EQ(1, KeyUtils::camelotDistance(C_MAJOR, F_MAJOR));
+    EXPECT_EQ(2, KeyUtils::camelotDistance(C_MAJOR, E_MINOR));
+    // Opposite side of the wheel
+    EXPECT_EQ(6, KeyUtils::camelotDistance(C_MAJOR, F_SHARP_MAJOR));
+    EXPECT_EQ(7, KeyUtils::camelotDistance(C_MAJOR, E_FLAT_MINOR));
+    EXPECT_EQ(-1, KeyUtils::camelotDistance(C_MAJOR, INVALID));
+}
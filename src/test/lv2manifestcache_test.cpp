@@ -0,0 +1,138 @@
+#include "effects/backends/lv2/lv2manifestcache.h"
+
+#include <gtest/gtest.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "effects/backends/effectmanifestparameter.h"
+
+namespace {
+
+const QString kPluginUri = QStringLiteral("urn:mixxx:test:plugin");
+const QString kBundlePath = QStringLiteral("/usr/lib/lv2/test.lv2");
+constexpr qint64 kBundleLastModified = 1700000000000;
+
+LV2EffectManifestPointer createManifest() {
+    auto pManifest = LV2EffectManifestPointer::create(nullptr,
+            LV2Manifest::AVAILABLE,
+            QList<int>{0, 1, 2, 3},
+            QList<int>{4, 5});
+    pManifest->setId(kPluginUri);
+    pManifest->setName(QStringLiteral("Test Plugin"));
+    pManifest->setAuthor(QStringLiteral("Mixxx"));
+
+    auto pKnob = pManifest->addParameter();
+    pKnob->setId(QStringLiteral("gain"));
+    pKnob->setName(QStringLiteral("Gain"));
+    pKnob->setUnitsHint(EffectManifestParameter::UnitsHint::Decibel);
+    pKnob->setValueScaler(EffectManifestParameter::ValueScaler::Linear);
+    pKnob->setRange(-12.0, 0.0, 12.0);
+
+    auto pButton = pManifest->addParameter();
+    pButton->setId(QStringLiteral("mode"));
+    pButton->setName(QStringLiteral("Mode"));
+    pButton->setValueScaler(EffectManifestParameter::ValueScaler::Toggle);
+    pButton->appendStep(qMakePair(QStringLiteral("Inactive"), 0.0));
+    pButton->appendStep(qMakePair(QStringLiteral("Active"), 1.0));
+    pButton->setRange(0.0, 0.0, 1.0);
+    return pManifest;
+}
+
+} // namespace
+
+class LV2ManifestCacheTest : public testing::Test {
+  protected:
+    QString cacheFilePath() const {
+        return m_tempDir.filePath(QStringLiteral("lv2manifests.cache"));
+    }
+
+    QTemporaryDir m_tempDir;
+};
+
+TEST_F(LV2ManifestCacheTest, SaveAndRestore) {
+    {
+        LV2ManifestCache cache(cacheFilePath());
+        ASSERT_TRUE(cache.load());
+        EXPECT_EQ(0, cache.size());
+        cache.insert(createManifest(), kBundlePath, kBundleLastModified);
+        ASSERT_TRUE(cache.save());
+    }
+
+    LV2ManifestCache cache(cacheFilePath());
+    ASSERT_TRUE(cache.load());
+    EXPECT_EQ(1, cache.size());
+    auto pManifest = cache.lookup(nullptr, kPluginUri, kBundlePath, kBundleLastModified);
+    ASSERT_TRUE(pManifest);
+
+    const auto pExpected = createManifest();
+    EXPECT_EQ(pExpected->id(), pManifest->id());
+    EXPECT_EQ(pExpected->name(), pManifest->name());
+    EXPECT_EQ(pExpected->author(), pManifest->author());
+    EXPECT_TRUE(pManifest->isValid());
+    EXPECT_EQ(pExpected->getAudioPortIndices(), pManifest->getAudioPortIndices());
+    EXPECT_EQ(pExpected->getControlPortIndices(), pManifest->getControlPortIndices());
+    ASSERT_EQ(pExpected->parameters().size(), pManifest->parameters().size());
+    for (int i = 0; i < pExpected->parameters().size(); ++i) {
+        const auto pExpectedParameter = pExpected->parameters().at(i);
+        const auto pParameter = pManifest->parameters().at(i);
+        EXPECT_EQ(pExpectedParameter->id(), pParameter->id());
+        EXPECT_EQ(pExpectedParameter->name(), pParameter->name());
+        EXPECT_EQ(pExpectedParameter->index(), pParameter->index());
+        EXPECT_EQ(pExpectedParameter->unitsHint(), pParameter->unitsHint());
+        EXPECT_EQ(pExpectedParameter->valueScaler(), pParameter->valueScaler());
+        EXPECT_EQ(pExpectedParameter->parameterType(), pParameter->parameterType());
+        EXPECT_EQ(pExpectedParameter->getMinimum(), pParameter->getMinimum());
+        EXPECT_EQ(pExpectedParameter->getDefault(), pParameter->getDefault());
+        EXPECT_EQ(pExpectedParameter->getMaximum(), pParameter->getMaximum());
+        EXPECT_EQ(pExpectedParameter->getSteps(), pParameter->getSteps());
+    }
+}
+
+TEST_F(LV2ManifestCacheTest, ModifiedBundleIsNotRestored) {
+    LV2ManifestCache cache(cacheFilePath());
+    cache.insert(createManifest(), kBundlePath, kBundleLastModified);
+
+    EXPECT_TRUE(cache.lookup(nullptr, kPluginUri, kBundlePath, kBundleLastModified));
+    EXPECT_FALSE(cache.lookup(nullptr, kPluginUri, kBundlePath, kBundleLastModified + 1));
+    EXPECT_FALSE(cache.lookup(nullptr,
+            kPluginUri,
+            QStringLiteral("/usr/local/lib/lv2/test.lv2"),
+            kBundleLastModified));
+    EXPECT_FALSE(cache.lookup(nullptr,
+            QStringLiteral("urn:mixxx:test:other"),
+            kBundlePath,
+            kBundleLastModified));
+}
+
+TEST_F(LV2ManifestCacheTest, RetainInstalledPlugins) {
+    LV2ManifestCache cache(cacheFilePath());
+    cache.insert(createManifest(), kBundlePath, kBundleLastModified);
+    cache.retain(QSet<QString>{kPluginUri});
+    EXPECT_EQ(1, cache.size());
+    cache.retain(QSet<QString>{});
+    EXPECT_EQ(0, cache.size());
+}
+
+TEST_F(LV2ManifestCacheTest, BundleLastModifiedIsMemoized) {
+    ASSERT_TRUE(QDir(m_tempDir.path()).mkdir(QStringLiteral("test.lv2")));
+    const QString bundlePath = m_tempDir.filePath(QStringLiteral("test.lv2"));
+    QFile file(QDir(bundlePath).filePath(QStringLiteral("manifest.ttl")));
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    const QDateTime modified = QDateTime::fromMSecsSinceEpoch(kBundleLastModified);
+    ASSERT_TRUE(file.setFileTime(modified, QFileDevice::FileModificationTime));
+
+    LV2ManifestCache cache(cacheFilePath());
+    const qint64 lastModified = cache.bundleLastModified(bundlePath);
+    EXPECT_GE(lastModified, kBundleLastModified);
+
+    // Modifications while enumerating the plugins are not noticed
+    ASSERT_TRUE(file.setFileTime(modified.addYears(10), QFileDevice::FileModificationTime));
+    EXPECT_EQ(lastModified, cache.bundleLastModified(bundlePath));
+
+    LV2ManifestCache otherCache(cacheFilePath());
+    EXPECT_EQ(modified.addYears(10).toMSecsSinceEpoch(),
+            otherCache.bundleLastModified(bundlePath));
+}
@@ -0,0 +1,91 @@
+#include "util/memoryusage.h"
+
+#include <gtest/gtest.h>
+
+#include <QStringList>
+#include <vector>
+
+#include "track/track.h"
+
+namespace {
+
+using mixxx::MemoryUsage;
+using mixxx::ScopedMemoryUsage;
+
+TEST(MemoryUsageTest, ScopedMemoryUsage) {
+    const qint64 bytesBefore = MemoryUsage::bytes(MemoryUsage::Subsystem::Waveform);
+    {
+        ScopedMemoryUsage usage(MemoryUsage::Subsystem::Waveform, 100);
+        EXPECT_EQ(bytesBefore + 100, MemoryUsage::bytes(MemoryUsage::Subsystem::Waveform));
+        usage.setBytes(40);
+        EXPECT_EQ(bytesBefore + 40, MemoryUsage::bytes(MemoryUsage::Subsystem::Waveform));
+    }
+    EXPECT_EQ(bytesBefore, MemoryUsage::bytes(MemoryUsage::Subsystem::Waveform));
+}
+
+TEST(MemoryUsageTest, CopyAndAssign) {
+    const qint64 trackBytesBefore = MemoryUsage::bytes(MemoryUsage::Subsystem::Track);
+    const qint64 readerBytesBefore = MemoryUsage::bytes(MemoryUsage::Subsystem::CachingReader);
+    {
+        std::vector<ScopedMemoryUsage> usages(
+                3, ScopedMemoryUsage(MemoryUsage::Subsystem::Track, 10));
+        EXPECT_EQ(trackBytesBefore + 30, MemoryUsage::bytes(MemoryUsage::Subsystem::Track));
+
+        usages[0] = ScopedMemoryUsage(MemoryUsage::Subsystem::CachingReader, 7);
+        EXPECT_EQ(trackBytesBefore + 20, MemoryUsage::bytes(MemoryUsage::Subsystem::Track));
+        EXPECT_EQ(readerBytesBefore + 7,
+                MemoryUsage::bytes(MemoryUsage::Subsystem::CachingReader));
+    }
+    EXPECT_EQ(trackBytesBefore, MemoryUsage::bytes(MemoryUsage::Subsystem::Track));
+    EXPECT_EQ(readerBytesBefore, MemoryUsage::bytes(MemoryUsage::Subsystem::CachingReader));
+}
+
+TEST(MemoryUsageTest, SubsystemNamesAreUnique) {
+    QStringList names;
+    for (int i = 0; i < MemoryUsage::kSubsystemCount; ++i) {
+        const QString name = MemoryUsage::subsystemName(static_cast<MemoryUsage::Subsystem>(i));
+        EXPECT_FALSE(name.isEmpty());
+        EXPECT_FALSE(names.contains(name));
+        names.append(name);
+    }
+}
+
+TEST(MemoryUsageTest, EvictOnlyInvokesEvictorsOfSubsystem) {
+    int trackEvictions = 0;
+    int readerEvictions = 0;
+    const int trackEvictorId = MemoryUsage::addEvictor(
+            MemoryUsage::Subsystem::Track, [&trackEvictions] {
+                ++trackEvictions;
+            });
+    const int readerEvictorId = MemoryUsage::addEvictor(
+            MemoryUsage::Subsystem::CachingReader, [&readerEvictions] {
+                ++readerEvictions;
+            });
+
+    MemoryUsage::evict(MemoryUsage::Subsystem::Track);
+    EXPECT_EQ(1, trackEvictions);
+    EXPECT_EQ(0, readerEvictions);
+
+    MemoryUsage::removeEvictor(trackEvictorId);
+    MemoryUsage::evict(MemoryUsage::Subsystem::Track);
+    EXPECT_EQ(1, trackEvictions);
+
+    MemoryUsage::removeEvictor(readerEvictorId);
+}
+
+TEST(MemoryUsageTest, TrackPayloadIsAccounted) {
+    const qint64 bytesBefore = MemoryUsage::bytes(MemoryUsage::Subsystem::Track);
+    {
+        const TrackPointer pTrack = Track::newTemporary();
+        const qint64 emptyTrackBytes =
+                MemoryUsage::bytes(MemoryUsage::Subsystem::Track) - bytesBefore;
+        EXPECT_GE(emptyTrackBytes, qint64{sizeof(Track)});
+
+        pTrack->setTitle(QString(1000, QChar('x')));
+        EXPECT_GE(MemoryUsage::bytes(MemoryUsage::Subsystem::Track) - bytesBefore,
+                emptyTrackBytes + 1000 * qint64{sizeof(QChar)});
+    }
+    EXPECT_EQ(bytesBefore, MemoryUsage::bytes(MemoryUsage::Subsystem::Track));
+}
+
+} // namespace
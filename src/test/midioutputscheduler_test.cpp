@@ -0,0 +1,208 @@
+#include "controllers/midi/midioutputscheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+#include "util/time.h"
+
+namespace {
+
+class MidiOutputSchedulerTest : public ::testing::Test {
+  protected:
+    struct Message {
+        unsigned char status;
+        unsigned char byte1;
+        unsigned char byte2;
+
+        bool operator==(const Message& other) const {
+            return status == other.status && byte1 == other.byte1 && byte2 == other.byte2;
+        }
+    };
+
+    MidiOutputScheduler::Sender sender() {
+        return [this](unsigned char status, unsigned char byte1, unsigned char byte2) {
+            m_sent.push_back(Message{status, byte1, byte2});
+        };
+    }
+
+    void SetUp() override {
+        mixxx::Time::setTestMode(true);
+    }
+
+    void TearDown() override {
+        mixxx::Time::setTestMode(false);
+    }
+
+    /// Advances the time by the given number of frames.
+    void advanceFrames(int frames) {
+        mixxx::Time::addTestTime(
+                std::chrono::milliseconds(frames * MidiOutputScheduler::kFrameMillis));
+    }
+
+    void flush() {
+        m_scheduler.flush(mixxx::Time::elapsed(), sender());
+    }
+
+    MidiOutputScheduler m_scheduler;
+    std::vector<Message> m_sent;
+};
+
+TEST_F(MidiOutputSchedulerTest, coalesceAndDropRedundant) {
+    EXPECT_TRUE(m_scheduler.queue(0xB0, 0x10, 1));
+    EXPECT_TRUE(m_scheduler.queue(0xB0, 0x10, 2));
+    EXPECT_TRUE(m_scheduler.queue(0x90, 0x20, 0x7F));
+    EXPECT_TRUE(m_scheduler.queue(0xB0, 0x10, 3));
+    EXPECT_EQ(2, m_scheduler.pendingMessageCount());
+    flush();
+    EXPECT_EQ(std::vector<Message>({{0xB0, 0x10, 3}, {0x90, 0x20, 0x7F}}), m_sent);
+    EXPECT_FALSE(m_scheduler.hasPendingMessages());
+
+    // Already sent
+    m_sent.clear();
+    EXPECT_FALSE(m_scheduler.queue(0xB0, 0x10, 3));
+    // Reverted before being sent
+    EXPECT_TRUE(m_scheduler.queue(0x90, 0x20, 0x00));
+    EXPECT_FALSE(m_scheduler.queue(0x90, 0x20, 0x7F));
+    // Note off replaces note on of the same note
+    EXPECT_TRUE(m_scheduler.queue(0x90, 0x20, 0x00));
+    EXPECT_TRUE(m_scheduler.queue(0x80, 0x20, 0x00));
+    // Different channel
+    EXPECT_TRUE(m_scheduler.queue(0xB1, 0x10, 3));
+    advanceFrames(1);
+    flush();
+    EXPECT_EQ(std::vector<Message>({{0x80, 0x20, 0x00}, {0xB1, 0x10, 3}}), m_sent);
+
+    // The device state is unknown
+    m_sent.clear();
+    m_scheduler.resetSentValues();
+    EXPECT_TRUE(m_scheduler.queue(0xB0, 0x10, 3));
+    advanceFrames(1);
+    flush();
+    EXPECT_EQ(std::vector<Message>({{0xB0, 0x10, 3}}), m_sent);
+}
+
+TEST_F(MidiOutputSchedulerTest, bandwidthBudget) {
+    // 10 messages per second, bursts of a single message
+    m_scheduler.setBytesPerSecond(10 * MidiOutputScheduler::kBytesPerMessage);
+
+    // A continuously updated meter
+    m_scheduler.queue(0xB0, 0x01, 1);
+    flush();
+    EXPECT_EQ(std::vector<Message>({{0xB0, 0x01, 1}}), m_sent);
+
+    m_sent.clear();
+    advanceFrames(1);
+    m_scheduler.queue(0xB0, 0x01, 2);
+    m_scheduler.queue(0x90, 0x02, 0x7F);
+    for (int i = 3; i <= 10; ++i) {
+        advanceFrames(1);
+        m_scheduler.queue(0xB0, 0x01, i);
+    }
+    // The budget is exhausted
+    flush();
+    EXPECT_TRUE(m_sent.empty());
+    // The button is preferred over the meter
+    for (int i = 11; i <= 15; ++i) {
+        advanceFrames(1);
+        m_scheduler.queue(0xB0, 0x01, i);
+    }
+    flush();
+    EXPECT_EQ(std::vector<Message>({{0x90, 0x02, 0x7F}}), m_sent);
+    EXPECT_EQ(1, m_scheduler.pendingMessageCount());
+
+    // Coalesced while waiting
+    m_sent.clear();
+    advanceFrames(10);
+    flush();
+    EXPECT_EQ(std::vector<Message>({{0xB0, 0x01, 15}}), m_sent);
+    EXPECT_FALSE(m_scheduler.hasPendingMessages());
+}
+
+TEST_F(MidiOutputSchedulerTest, continuityIsDerivedFromTime) {
+    // A single message per second
+    m_scheduler.setBytesPerSecond(MidiOutputScheduler::kBytesPerMessage);
+
+    // Both controls have been updated before, but only the first one in
+    // the previous frame. Flushes don't happen in every frame.
+    m_scheduler.queue(0xB0, 0x01, 1);
+    m_scheduler.queue(0xB0, 0x02, 1);
+    m_scheduler.flushAll(sender());
+    advanceFrames(10);
+    m_scheduler.queue(0xB0, 0x01, 2);
+    advanceFrames(1);
+    m_scheduler.queue(0xB0, 0x01, 3);
+    m_scheduler.queue(0xB0, 0x02, 2);
+
+    m_sent.clear();
+    advanceFrames(100);
+    flush();
+    EXPECT_EQ(std::vector<Message>({{0xB0, 0x02, 2}}), m_sent);
+    EXPECT_EQ(1, m_scheduler.pendingMessageCount());
+}
+
+TEST_F(MidiOutputSchedulerTest, passThroughInvalidStatus) {
+    m_scheduler.setBytesPerSecond(MidiOutputScheduler::kBytesPerMessage);
+    // Neither coalesced nor dropped, even without a budget
+    EXPECT_TRUE(m_scheduler.queue(0x10, 0x01, 0x02));
+    EXPECT_TRUE(m_scheduler.queue(0x10, 0x01, 0x02));
+    EXPECT_TRUE(m_scheduler.queue(0xB0, 0x01, 1));
+    EXPECT_TRUE(m_scheduler.queue(0xF8, 0x00, 0x00));
+    EXPECT_EQ(4, m_scheduler.pendingMessageCount());
+    flush();
+    EXPECT_EQ(std::vector<Message>({{0x10, 0x01, 0x02}, {0x10, 0x01, 0x02}, {0xF8, 0x00, 0x00}}),
+            m_sent);
+    EXPECT_EQ(1, m_scheduler.pendingMessageCount());
+}
+
+TEST_F(MidiOutputSchedulerTest, passThroughScriptMessages) {
+    // Repeated commands and NRPN sequences are neither dropped nor coalesced
+    m_scheduler.queuePassThrough(0xB0, 0x64, 0x7F);
+    m_scheduler.queuePassThrough(0xB0, 0x64, 0x7F);
+    m_scheduler.queuePassThrough(0xB0, 99, 0x01);
+    m_scheduler.queuePassThrough(0xB0, 98, 0x02);
+    m_scheduler.queuePassThrough(0xB0, 6, 0x03);
+    m_scheduler.queuePassThrough(0xB0, 99, 0x01);
+    m_scheduler.queuePassThrough(0xB0, 98, 0x04);
+    m_scheduler.queuePassThrough(0xB0, 6, 0x05);
+    EXPECT_EQ(8, m_scheduler.pendingMessageCount());
+    flush();
+    EXPECT_EQ(std::vector<Message>({{0xB0, 0x64, 0x7F},
+                      {0xB0, 0x64, 0x7F},
+                      {0xB0, 99, 0x01},
+                      {0xB0, 98, 0x02},
+                      {0xB0, 6, 0x03},
+                      {0xB0, 99, 0x01},
+                      {0xB0, 98, 0x04},
+                      {0xB0, 6, 0x05}}),
+            m_sent);
+
+    // A later script message replaces a pending message of a mapping
+    m_sent.clear();
+    EXPECT_TRUE(m_scheduler.queue(0x90, 0x20, 0x7F));
+    m_scheduler.queuePassThrough(0x90, 0x20, 0x00);
+    flush();
+    EXPECT_EQ(std::vector<Message>({{0x90, 0x20, 0x00}}), m_sent);
+
+    // The value of the mapping is sent again, because the script changed it
+    m_sent.clear();
+    EXPECT_TRUE(m_scheduler.queue(0x90, 0x20, 0x7F));
+    flush();
+    EXPECT_EQ(std::vector<Message>({{0x90, 0x20, 0x7F}}), m_sent);
+}
+
+TEST_F(MidiOutputSchedulerTest, flushAllIgnoresBudget) {
+    m_scheduler.setBytesPerSecond(MidiOutputScheduler::kBytesPerMessage);
+    m_scheduler.queue(0xB0, 0x01, 1);
+    m_scheduler.queue(0xB0, 0x02, 1);
+    m_scheduler.queue(0xB0, 0x03, 1);
+    advanceFrames(100);
+    flush();
+    EXPECT_EQ(1u, m_sent.size());
+    m_scheduler.flushAll(sender());
+    EXPECT_EQ(3u, m_sent.size());
+    EXPECT_FALSE(m_scheduler.hasPendingMessages());
+}
+
+} // namespace
@@ -0,0 +1,87 @@
+#include "util/partialcontenthash.h"
+
+#include <gtest/gtest.h>
+
+#include <QBuffer>
+#include <QtEndian>
+
+namespace {
+
+class PartialContentHashTest : public ::testing::Test {
+  protected:
+    static QByteArray payload(int size, char seed) {
+        QByteArray data(size, '\0');
+        quint32 state = static_cast<quint8>(seed) + 1;
+        for (int i = 0; i < size; ++i) {
+            state = state * 1664525u + 1013904223u;
+            data[i] = static_cast<char>(state >> 24);
+        }
+        return data;
+    }
+
+    static QByteArray id3v2Tag(int size) {
+        QByteArray tag("ID3\x04\x00\x00", 6);
+        for (int shift = 21; shift >= 0; shift -= 7) {
+            tag.append(static_cast<char>((size >> shift) & 0x7F));
+        }
+        tag.append(QByteArray(size, 'x'));
+        return tag;
+    }
+
+    static QByteArray id3v1Tag() {
+        return QByteArray("TAG") + QByteArray(125, 'y');
+    }
+
+    static QByteArray apeTag(int itemsSize) {
+        QByteArray tag(itemsSize, 'z');
+        QByteArray footer("APETAGEX");
+        char field[4];
+        qToLittleEndian<quint32>(2000, field);
+        footer.append(field, 4);
+        qToLittleEndian<quint32>(itemsSize + 32, field);
+        footer.append(field, 4);
+        qToLittleEndian<quint32>(1, field);
+        footer.append(field, 4);
+        qToLittleEndian<quint32>(0, field);
+        footer.append(field, 4);
+        footer.append(QByteArray(8, '\0'));
+        return tag + footer;
+    }
+
+    static mixxx::cache_key_t hash(QByteArray data) {
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::ReadOnly);
+        return mixxx::partialContentHash(&buffer);
+    }
+};
+
+TEST_F(PartialContentHashTest, ignoreTags) {
+    const QByteArray audio = payload(2 * 1024 * 1024, 1);
+    const auto audioHash = hash(audio);
+    EXPECT_TRUE(mixxx::isValidCacheKey(audioHash));
+
+    EXPECT_EQ(audioHash, hash(id3v2Tag(1000) + audio));
+    EXPECT_EQ(audioHash, hash(id3v2Tag(5000) + audio + id3v1Tag()));
+    EXPECT_EQ(audioHash, hash(audio + apeTag(100)));
+    EXPECT_EQ(audioHash, hash(id3v2Tag(10) + audio + apeTag(50) + id3v1Tag()));
+}
+
+TEST_F(PartialContentHashTest, differentContent) {
+    QByteArray audio = payload(2 * 1024 * 1024, 1);
+    const auto audioHash = hash(audio);
+    EXPECT_NE(audioHash, hash(payload(2 * 1024 * 1024, 2)));
+
+    // A modification within one of the hashed blocks
+    audio[audio.size() - 256 * 1024 - 1] = ~audio[audio.size() - 256 * 1024 - 1];
+    EXPECT_NE(audioHash, hash(audio));
+}
+
+TEST_F(PartialContentHashTest, shortContent) {
+    const QByteArray audio = payload(1000, 3);
+    EXPECT_TRUE(mixxx::isValidCacheKey(hash(audio)));
+    EXPECT_EQ(hash(audio), hash(id3v2Tag(100) + audio));
+    EXPECT_FALSE(mixxx::isValidCacheKey(hash(QByteArray())));
+    EXPECT_FALSE(mixxx::isValidCacheKey(hash(id3v2Tag(100))));
+}
+
+} // namespace
@@ -0,0 +1,49 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "library/dao/playlistdao.h"
+#include "test/librarytest.h"
+#include "track/track.h"
+
+using ::testing::UnorderedElementsAre;
+
+class PlaylistDAOTest : public LibraryTest {
+  protected:
+    TrackId addTrack(const QString& filename) {
+        mixxx::FileInfo fileInfo(QDir(QDir::tempPath()), filename);
+        TrackPointer pTrack = Track::newTemporary(mixxx::FileAccess(fileInfo));
+        return internalCollection()->addTrack(pTrack, false);
+    }
+};
+
+TEST_F(PlaylistDAOTest, getSetLogTrackIdsSince) {
+    PlaylistDAO& playlistDAO = internalCollection()->getPlaylistDAO();
+
+    const TrackId oldTrackId = addTrack(QStringLiteral("old.mp3"));
+    const TrackId recentTrackId = addTrack(QStringLiteral("recent.mp3"));
+    const TrackId currentTrackId = addTrack(QStringLiteral("current.mp3"));
+    const TrackId otherTrackId = addTrack(QStringLiteral("other.mp3"));
+
+    const int previousSetLogId = playlistDAO.createPlaylist(
+            QStringLiteral("previous"), PlaylistDAO::PLHT_SET_LOG);
+    ASSERT_TRUE(playlistDAO.appendTracksToPlaylist(
+            QList<TrackId>{oldTrackId, recentTrackId}, previousSetLogId));
+    const int currentSetLogId = playlistDAO.createPlaylist(
+            QStringLiteral("current"), PlaylistDAO::PLHT_SET_LOG);
+    ASSERT_TRUE(playlistDAO.appendTrackToPlaylist(currentTrackId, currentSetLogId));
+    const int playlistId = playlistDAO.createPlaylist(QStringLiteral("playlist"));
+    ASSERT_TRUE(playlistDAO.appendTrackToPlaylist(otherTrackId, playlistId));
+
+    // Move the old track and the track of the current session back in time
+    QSqlQuery query(dbConnection());
+    query.prepare(QStringLiteral(
+            "UPDATE PlaylistTracks SET pl_datetime_added = '2000-01-01 00:00:00' "
+            "WHERE track_id IN (:old_track_id, :current_track_id)"));
+    query.bindValue(":old_track_id", oldTrackId.toVariant());
+    query.bindValue(":current_track_id", currentTrackId.toVariant());
+    ASSERT_TRUE(query.exec());
+
+    const QDateTime since = QDateTime::currentDateTimeUtc().addSecs(-3600);
+    EXPECT_THAT(playlistDAO.getSetLogTrackIdsSince(since),
+            UnorderedElementsAre(recentTrackId, currentTrackId));
+}
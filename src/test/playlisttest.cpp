@@ -2,6 +2,7 @@
 
 #include <QDataStream>
 #include <QDebug>
+#include <QTemporaryDir>
 #include <QTemporaryFile>
 #include <QUrl>
 #include <QtGlobal>
@@ -207,3 +208,32 @@ TEST_F(PlaylistTest, PlsEndOfLine) {
     EXPECT_TRUE(entries.at(0).endsWith(QStringLiteral("cr.mp3")));
     EXPECT_TRUE(entries.at(1).endsWith(QStringLiteral("lf.mp3")));
 }
+
+TEST_F(PlaylistTest, WriteStreamedLocations) {
+    const QList<QString> locations = {
+            QStringLiteral("/music/first.mp3"),
+            QStringLiteral("/music/second.mp3"),
+            QStringLiteral("/music/third.mp3"),
+    };
+    int numProvidedLocations = 0;
+    const Parser::ForEachLocation forEachLocation =
+            [&](const std::function<void(const QString&)>& function) {
+                for (const auto& location : locations) {
+                    ++numProvidedLocations;
+                    function(location);
+                }
+            };
+
+    QTemporaryDir tempDir;
+    const QString m3uFilePath = tempDir.filePath(QStringLiteral("playlist.m3u8"));
+    ASSERT_TRUE(ParserM3u::writeM3UFile(m3uFilePath, forEachLocation, false, true));
+    EXPECT_EQ(locations.size(), numProvidedLocations);
+    QList<QString> m3uEntries = ParserM3u().parseAllLocations(m3uFilePath);
+    // The empty line after the last line break
+    m3uEntries.removeAll(QString());
+    EXPECT_EQ(locations, m3uEntries);
+
+    const QString plsFilePath = tempDir.filePath(QStringLiteral("playlist.pls"));
+    ASSERT_TRUE(ParserPls::writePLSFile(plsFilePath, forEachLocation, false));
+    EXPECT_EQ(locations, ParserPls().parseAllLocations(plsFilePath));
+}
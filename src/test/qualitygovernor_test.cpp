@@ -0,0 +1,88 @@
+#include "soundio/qualitygovernor.h"
+
+#include <gtest/gtest.h>
+
+#include <QSignalSpy>
+#include <memory>
+
+#include "control/controlobject.h"
+#include "test/mixxxtest.h"
+#include "util/time.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+class QualityGovernorTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        mixxx::Time::setTestMode(true);
+        mixxx::Time::addTestTime(10ms);
+        m_pAudioLatencyUsage = std::make_unique<ControlObject>(
+                ConfigKey(QStringLiteral("[App]"), QStringLiteral("audio_latency_usage")));
+        m_pGovernor = std::make_unique<mixxx::QualityGovernor>(config());
+    }
+
+    void TearDown() override {
+        m_pGovernor.reset();
+        m_pAudioLatencyUsage.reset();
+        mixxx::Time::setTestMode(false);
+    }
+
+    /// Reports the usage twice with the given time in between, like the
+    /// sound device does periodically.
+    template<class Rep, class Period>
+    void reportUsage(double usage, std::chrono::duration<Rep, Period> elapsed) {
+        m_pAudioLatencyUsage->set(usage);
+        application()->processEvents();
+        mixxx::Time::addTestTime(elapsed);
+        // Use a slightly different value to ensure that a change is emitted
+        m_pAudioLatencyUsage->set(usage + 0.001);
+        application()->processEvents();
+    }
+
+    double qualityReduction() const {
+        return ControlObject::get(
+                ConfigKey(QStringLiteral("[App]"), QStringLiteral("quality_reduction")));
+    }
+
+    std::unique_ptr<ControlObject> m_pAudioLatencyUsage;
+    std::unique_ptr<mixxx::QualityGovernor> m_pGovernor;
+};
+
+TEST_F(QualityGovernorTest, SingleSpikeIsIgnored) {
+    reportUsage(0.95, 10ms);
+    reportUsage(0.2, 10ms);
+    EXPECT_EQ(mixxx::QualityGovernor::Level::Full, m_pGovernor->level());
+    EXPECT_EQ(0.0, qualityReduction());
+}
+
+TEST_F(QualityGovernorTest, ReduceStepwiseAndRecoverWithHysteresis) {
+    QSignalSpy spy(m_pGovernor.get(), &mixxx::QualityGovernor::levelChanged);
+
+    reportUsage(0.95, 300ms);
+    EXPECT_EQ(mixxx::QualityGovernor::Level::Reduced, m_pGovernor->level());
+    EXPECT_EQ(1.0, qualityReduction());
+
+    reportUsage(0.95, 300ms);
+    EXPECT_EQ(mixxx::QualityGovernor::Level::Minimal, m_pGovernor->level());
+    EXPECT_EQ(2.0, qualityReduction());
+
+    // Within the hysteresis band nothing changes, even after a long time
+    reportUsage(0.6, 60s);
+    EXPECT_EQ(mixxx::QualityGovernor::Level::Minimal, m_pGovernor->level());
+
+    // A short relaxation is not sufficient for recovering
+    reportUsage(0.3, 1s);
+    EXPECT_EQ(mixxx::QualityGovernor::Level::Minimal, m_pGovernor->level());
+
+    reportUsage(0.3, 20s);
+    EXPECT_EQ(mixxx::QualityGovernor::Level::Reduced, m_pGovernor->level());
+    reportUsage(0.3, 20s);
+    EXPECT_EQ(mixxx::QualityGovernor::Level::Full, m_pGovernor->level());
+    EXPECT_EQ(0.0, qualityReduction());
+
+    EXPECT_EQ(4, spy.count());
+}
+
+} // namespace
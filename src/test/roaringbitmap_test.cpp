@@ -0,0 +1,90 @@
+#include "util/roaringbitmap.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+namespace {
+
+class RoaringBitmapTest : public ::testing::Test {
+  protected:
+    static std::vector<quint32> toVector(const std::set<quint32>& values) {
+        return std::vector<quint32>(values.begin(), values.end());
+    }
+};
+
+TEST_F(RoaringBitmapTest, addRemoveContains) {
+    mixxx::RoaringBitmap bitmap;
+    EXPECT_TRUE(bitmap.isEmpty());
+
+    EXPECT_TRUE(bitmap.add(1));
+    EXPECT_TRUE(bitmap.add(70000));
+    EXPECT_FALSE(bitmap.add(1));
+    EXPECT_EQ(2u, bitmap.cardinality());
+    EXPECT_TRUE(bitmap.contains(1));
+    EXPECT_TRUE(bitmap.contains(70000));
+    EXPECT_FALSE(bitmap.contains(2));
+    EXPECT_FALSE(bitmap.contains(4464));
+
+    EXPECT_TRUE(bitmap.remove(70000));
+    EXPECT_FALSE(bitmap.remove(70000));
+    EXPECT_EQ(std::vector<quint32>{1}, bitmap.toVector());
+
+    EXPECT_TRUE(bitmap.remove(1));
+    EXPECT_TRUE(bitmap.isEmpty());
+}
+
+TEST_F(RoaringBitmapTest, denseChunk) {
+    // Exceed the array size of a single chunk back and forth
+    mixxx::RoaringBitmap bitmap;
+    std::set<quint32> expected;
+    for (quint32 value = 0; value < 10000; value += 2) {
+        bitmap.add(value);
+        expected.insert(value);
+    }
+    EXPECT_EQ(expected.size(), bitmap.cardinality());
+    EXPECT_TRUE(bitmap.contains(9998));
+    EXPECT_FALSE(bitmap.contains(9999));
+    for (quint32 value = 0; value < 6000; value += 2) {
+        bitmap.remove(value);
+        expected.erase(value);
+    }
+    EXPECT_EQ(toVector(expected), bitmap.toVector());
+}
+
+TEST_F(RoaringBitmapTest, setOperations) {
+    // Sparse values in multiple chunks mixed with a dense chunk
+    mixxx::RoaringBitmap lhs;
+    mixxx::RoaringBitmap rhs;
+    std::set<quint32> lhsValues;
+    std::set<quint32> rhsValues;
+    for (quint32 value = 0; value < 200000; value += 3) {
+        lhs.add(value);
+        lhsValues.insert(value);
+    }
+    for (quint32 value = 60000; value < 140000; value += (value < 70000 ? 1 : 101)) {
+        rhs.add(value);
+        rhsValues.insert(value);
+    }
+
+    std::set<quint32> intersection;
+    std::set<quint32> difference;
+    std::set<quint32> union_ = rhsValues;
+    for (const auto value : lhsValues) {
+        if (rhsValues.count(value) > 0) {
+            intersection.insert(value);
+        } else {
+            difference.insert(value);
+        }
+        union_.insert(value);
+    }
+
+    EXPECT_EQ(toVector(intersection), (lhs & rhs).toVector());
+    EXPECT_EQ(toVector(union_), (lhs | rhs).toVector());
+    EXPECT_EQ(toVector(difference), (lhs - rhs).toVector());
+    EXPECT_EQ(lhs & rhs, rhs & lhs);
+    EXPECT_EQ(lhs | rhs, rhs | lhs);
+    EXPECT_NE(lhs - rhs, rhs - lhs);
+}
+
+} // anonymous namespace
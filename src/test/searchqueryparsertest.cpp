@@ -37,10 +37,9 @@ class SearchQueryParserTest : public LibraryTest {
 
     SearchQueryParser m_parser;
 
-    // The expected query to be returned by CrateFilterNode
-    const QString m_crateFilterQuery =
-        "id IN (SELECT DISTINCT track_id FROM crate_tracks"
-        " JOIN crates ON crate_id=id WHERE name LIKE '%%1%' ORDER BY track_id)";
+    // The expected query to be returned by CrateFilterNode. The ids of
+    // the few tracks in the test crates are inlined.
+    const QString m_crateFilterQuery = "id IN (%1)";
 };
 
 TEST_F(SearchQueryParserTest, EmptySearch) {
@@ -877,7 +876,7 @@ TEST_F(SearchQueryParserTest, CrateFilter) {
     EXPECT_FALSE(pQuery->match(pTrackB));
 
     EXPECT_STREQ(
-                 qPrintable(m_crateFilterQuery.arg(searchTerm)),
+                 qPrintable(m_crateFilterQuery.arg(trackAId.toString())),
                  qPrintable(pQuery->toSql()));
 }
 
@@ -970,7 +969,7 @@ TEST_F(SearchQueryParserTest, CrateFilterQuote){
     EXPECT_FALSE(pQuery->match(pTrackB));
 
     EXPECT_STREQ(
-                 qPrintable(m_crateFilterQuery.arg(searchTerm)),
+                 qPrintable(m_crateFilterQuery.arg(trackAId.toString())),
                  qPrintable(pQuery->toSql()));
 }
 
@@ -1016,15 +1015,58 @@ TEST_F(SearchQueryParserTest, CrateFilterWithOther){
     EXPECT_FALSE(pQuery->match(pTrackB));
 
     EXPECT_STREQ(
-                 qPrintable("(" + m_crateFilterQuery.arg(searchTerm) +
+                 qPrintable("(" + m_crateFilterQuery.arg(trackAId.toString()) +
                             ") AND ((artist LIKE '%asdf%') OR (album_artist LIKE '%asdf%'))"),
                  qPrintable(pQuery->toSql()));
 }
 
+// Checks that quotes in the crate name are escaped when collecting the
+// matching track ids and in the subselect that replaces them for large crates
+TEST_F(SearchQueryParserTest, CrateFilterEscapedQuote) {
+    // User's search term
+    QString searchTerm = "testA'1"; // #9419
+    QString searchTermEsc = "testA''1";
+
+    // locations for test tracks
+    const QString kTrackALocationTest(getTestDir().filePath(
+            QStringLiteral("id3-test-data/cover-test-jpg.mp3")));
+    const QString kTrackBLocationTest(getTestDir().filePath(
+            QStringLiteral("id3-test-data/cover-test-png.mp3")));
+
+    // Create new crate and add it to the collection
+    Crate testCrate;
+    testCrate.setName(searchTerm);
+    CrateId testCrateId;
+    internalCollection()->insertCrate(testCrate, &testCrateId);
+
+    // Add the tracks in the collection
+    TrackId trackAId = addTrackToCollection(kTrackALocationTest);
+    TrackId trackBId = addTrackToCollection(kTrackBLocationTest);
+
+    // Add track A to the newly created crate
+    QList<TrackId> trackIds;
+    trackIds << trackAId;
+    internalCollection()->addCrateTracks(testCrateId, trackIds);
+
+    const CrateStorage& crates = internalCollection()->crates();
+    CrateFilterNode node(&crates, searchTerm);
+    const mixxx::RoaringBitmap* pTrackIds = node.matchingTrackIds();
+    ASSERT_NE(nullptr, pTrackIds);
+    EXPECT_EQ(1u, pTrackIds->cardinality());
+    EXPECT_TRUE(pTrackIds->contains(CrateStorage::trackIdIndexValue(trackAId)));
+    EXPECT_FALSE(pTrackIds->contains(CrateStorage::trackIdIndexValue(trackBId)));
+
+    EXPECT_STREQ(
+            qPrintable(QStringLiteral(
+                    "SELECT DISTINCT track_id FROM crate_tracks"
+                    " JOIN crates ON crate_id=id WHERE name LIKE '%%1%' ORDER BY track_id")
+                            .arg(searchTermEsc)),
+            qPrintable(crates.formatQueryForTrackIdsByCrateNameLike(searchTerm)));
+}
+
 TEST_F(SearchQueryParserTest, CrateFilterWithCrateFilterAndNegation){
     // User's search term
     QString searchTermA = "testA'1"; // Also a test if "'" is escaped #9419
-    QString searchTermAEsc = "testA''1";
     QString searchTermB = "testB";
 
     // Parse the user query
@@ -1067,9 +1109,9 @@ TEST_F(SearchQueryParserTest, CrateFilterWithCrateFilterAndNegation){
     EXPECT_TRUE(pQueryA->match(pTrackA));
     EXPECT_FALSE(pQueryA->match(pTrackB));
 
+    // Both crate filters are intersected into a single clause
     EXPECT_STREQ(
-                 qPrintable("(" + m_crateFilterQuery.arg(searchTermAEsc) +
-                            ") AND (" + m_crateFilterQuery.arg(searchTermB) + ")"),
+                 qPrintable(m_crateFilterQuery.arg(trackAId.toString())),
                  qPrintable(pQueryA->toSql()));
 
     // parse again to test negation
@@ -1081,8 +1123,10 @@ TEST_F(SearchQueryParserTest, CrateFilterWithCrateFilterAndNegation){
     EXPECT_TRUE(pQueryB->match(pTrackB));
 
     EXPECT_STREQ(
-                 qPrintable("(" + m_crateFilterQuery.arg(searchTermAEsc) +
-                            ") AND (NOT (" + m_crateFilterQuery.arg(searchTermB) + "))"),
+                 qPrintable("(" +
+                         m_crateFilterQuery.arg(
+                                 trackAId.toString() + ',' + trackBId.toString()) +
+                         ") AND (NOT (" + m_crateFilterQuery.arg(trackAId.toString()) + "))"),
                  qPrintable(pQueryB->toSql()));
 }
 
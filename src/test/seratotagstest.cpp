@@ -341,3 +341,73 @@ TEST_F(SeratoTagsTest, Markers2RoundTrip) {
         }
     }
 }
+
+TEST_F(SeratoTagsTest, ReparseUnchangedMarkers2) {
+    const auto filetype = mixxx::taglib::FileType::MPEG;
+    QDir dir(MixxxTest::getOrInitTestDir().filePath(QStringLiteral("serato/data/mp3/markers2/")));
+    dir.setFilter(QDir::Files);
+    dir.setNameFilters(QStringList() << "*.octet-stream");
+    const QFileInfoList fileList = dir.entryInfoList();
+    for (const QFileInfo& fileInfo : fileList) {
+        auto file = QFile(fileInfo.filePath());
+        ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+        const QByteArray inputData = file.readAll();
+
+        mixxx::SeratoTags seratoTags;
+        ASSERT_TRUE(seratoTags.parseMarkers2(inputData, filetype));
+        const auto cueInfos = seratoTags.getCueInfos();
+
+        // Parsing the same data again is skipped and keeps the result
+        mixxx::SeratoTags reimportedTags = seratoTags;
+        EXPECT_TRUE(reimportedTags.parseMarkers2(inputData, filetype));
+        EXPECT_EQ(cueInfos, reimportedTags.getCueInfos());
+        EXPECT_TRUE(reimportedTags.isUnmodifiedCopyOf(seratoTags));
+        EXPECT_EQ(seratoTags, reimportedTags);
+
+        // Modified tags are compared by their contents
+        reimportedTags.setBpmLocked(!seratoTags.isBpmLocked());
+        EXPECT_FALSE(reimportedTags.isUnmodifiedCopyOf(seratoTags));
+        EXPECT_NE(seratoTags, reimportedTags);
+    }
+}
+
+TEST_F(SeratoTagsTest, FailedParseIsNotAnUnmodifiedCopy) {
+    const auto filetype = mixxx::taglib::FileType::MPEG;
+    const QByteArray invalidData = QByteArrayLiteral("invalid");
+
+    mixxx::SeratoTags firstTags;
+    ASSERT_FALSE(firstTags.parseMarkers2(invalidData, filetype));
+    EXPECT_EQ(mixxx::SeratoTags::ParserStatus::Failed, firstTags.status());
+    mixxx::SeratoTags secondTags;
+    ASSERT_FALSE(secondTags.parseMarkers2(invalidData, filetype));
+    EXPECT_FALSE(secondTags.isUnmodifiedCopyOf(firstTags));
+    EXPECT_FALSE(firstTags.isUnmodifiedCopyOf(firstTags));
+
+    // Unparsed tags don't contain anything
+    EXPECT_TRUE(mixxx::SeratoTags().isUnmodifiedCopyOf(mixxx::SeratoTags()));
+}
+
+TEST_F(SeratoTagsTest, ImportDisabled) {
+    const auto filetype = mixxx::taglib::FileType::MPEG;
+    QDir dir(MixxxTest::getOrInitTestDir().filePath(QStringLiteral("serato/data/mp3/markers2/")));
+    dir.setFilter(QDir::Files);
+    dir.setNameFilters(QStringList() << "*.octet-stream");
+    const QFileInfoList fileList = dir.entryInfoList();
+    ASSERT_FALSE(fileList.isEmpty());
+    auto file = QFile(fileList.first().filePath());
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    const QByteArray inputData = file.readAll();
+
+    mixxx::SeratoTags seratoTags;
+    seratoTags.disableImport();
+    EXPECT_FALSE(seratoTags.parseMarkers2(inputData, filetype));
+    EXPECT_TRUE(seratoTags.isEmpty());
+
+    // Tags parsed from the same data by another instance are reused
+    mixxx::SeratoTags firstTags;
+    ASSERT_TRUE(firstTags.parseMarkers2(inputData, filetype));
+    mixxx::SeratoTags secondTags;
+    ASSERT_TRUE(secondTags.parseMarkers2(inputData, filetype));
+    EXPECT_TRUE(secondTags.isUnmodifiedCopyOf(firstTags));
+    EXPECT_EQ(firstTags.getCueInfos(), secondTags.getCueInfos());
+}
@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include <QByteArray>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "skin/legacy/skindocumentcache.h"
+
+namespace {
+
+// Roughly the size of the deck template of a stock skin
+constexpr int kWidgetGroupCount = 500;
+
+QByteArray skinXml() {
+    QByteArray xml = QByteArrayLiteral("<skin><manifest><title>Benchmark</title></manifest>");
+    for (int i = 0; i < kWidgetGroupCount; ++i) {
+        xml += QStringLiteral(
+                "<WidgetGroup><ObjectName>Group%1</ObjectName>"
+                "<Layout>horizontal</Layout><Children>"
+                "<PushButton><TooltipId>play_cue_set</TooltipId>"
+                "<ObjectName>PlayButton</ObjectName>"
+                "<Connection><ConfigKey>[Channel1],play</ConfigKey></Connection>"
+                "</PushButton></Children></WidgetGroup>")
+                        .arg(i)
+                        .toUtf8();
+    }
+    xml += QByteArrayLiteral("</skin>");
+    return xml;
+}
+
+QString writeSkinFile(const QTemporaryDir& dir) {
+    const QString filePath = dir.filePath(QStringLiteral("skin.xml"));
+    QFile file(filePath);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(skinXml());
+    }
+    return filePath;
+}
+
+// Loading a document that is not cached, i.e. reading and parsing the file
+void BM_SkinDocumentCache_LoadUncached(benchmark::State& state) {
+    QTemporaryDir dir;
+    const QString filePath = writeSkinFile(dir);
+    for (auto _ : state) {
+        SkinDocumentCache::clear();
+        benchmark::DoNotOptimize(SkinDocumentCache::loadDocument(filePath, "skin"));
+    }
+    SkinDocumentCache::clear();
+}
+BENCHMARK(BM_SkinDocumentCache_LoadUncached);
+
+// Loading a cached document, which only validates the size and the
+// modification time of the file
+void BM_SkinDocumentCache_LoadCached(benchmark::State& state) {
+    QTemporaryDir dir;
+    const QString filePath = writeSkinFile(dir);
+    SkinDocumentCache::loadDocument(filePath, "skin");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SkinDocumentCache::loadDocument(filePath, "skin"));
+    }
+    SkinDocumentCache::clear();
+}
+BENCHMARK(BM_SkinDocumentCache_LoadCached);
+
+} // namespace
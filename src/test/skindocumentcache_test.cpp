@@ -0,0 +1,104 @@
+#include "skin/legacy/skindocumentcache.h"
+
+#include <QDomDocument>
+#include <QFile>
+#include <QTextStream>
+
+#include "test/mixxxtest.h"
+
+namespace {
+
+const QByteArray kSkinXml = QByteArrayLiteral(
+        "<skin>"
+        "<manifest><title>Test</title></manifest>"
+        "<WidgetGroup><ObjectName>Deck</ObjectName>"
+        "<Style><![CDATA[WWidget { color: red; }]]></Style>"
+        "<Template src=\"skin:deck.xml\"><SetVariable name=\"group\">"
+        "[Channel1]</SetVariable></Template>"
+        "</WidgetGroup>"
+        "</skin>");
+
+} // namespace
+
+class SkinDocumentCacheTest : public MixxxTest {
+  protected:
+    void TearDown() override {
+        SkinDocumentCache::clear();
+    }
+
+    QString writeFile(const QString& fileName, const QByteArray& content) {
+        const QString filePath = getTestDataDir().filePath(fileName);
+        QFile file(filePath);
+        EXPECT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(content);
+        file.close();
+        return filePath;
+    }
+
+    static QString toString(const QDomElement& element) {
+        QString result;
+        QTextStream stream(&result);
+        element.save(stream, 0);
+        return result;
+    }
+};
+
+TEST_F(SkinDocumentCacheTest, SerializeRoundTrip) {
+    QDomDocument document;
+    ASSERT_TRUE(document.setContent(kSkinXml));
+
+    mixxx::skin::SkinDomNode node;
+    SkinDocumentCache::serializeNode(document.documentElement(), &node);
+
+    QDomDocument restored;
+    restored.appendChild(SkinDocumentCache::deserializeNode(&restored, node));
+
+    EXPECT_QSTRING_EQ(toString(document.documentElement()),
+            toString(restored.documentElement()));
+    EXPECT_TRUE(restored.documentElement()
+                        .firstChildElement("WidgetGroup")
+                        .firstChildElement("Style")
+                        .firstChild()
+                        .isCDATASection());
+}
+
+TEST_F(SkinDocumentCacheTest, RestoreFromCacheFile) {
+    const QString skinPath = writeFile("skin.xml", kSkinXml);
+    const QString cachePath = getTestDataDir().filePath("skincache.bin");
+
+    SkinDocumentCache::setCacheFile(cachePath);
+    const QString expected = toString(SkinDocumentCache::loadDocument(skinPath, "skin"));
+    ASSERT_FALSE(expected.isEmpty());
+    ASSERT_TRUE(SkinDocumentCache::save());
+    ASSERT_TRUE(QFile::exists(cachePath));
+
+    // Simulate a restart
+    SkinDocumentCache::clear();
+    SkinDocumentCache::setCacheFile(cachePath);
+    EXPECT_QSTRING_EQ(expected, toString(SkinDocumentCache::loadDocument(skinPath, "skin")));
+}
+
+TEST_F(SkinDocumentCacheTest, ModifiedFileIsReparsed) {
+    const QString skinPath = writeFile("skin.xml", kSkinXml);
+    SkinDocumentCache::setCacheFile(getTestDataDir().filePath("skincache.bin"));
+    EXPECT_EQ(QStringLiteral("Test"),
+            SkinDocumentCache::loadDocument(skinPath, "skin")
+                    .firstChildElement("manifest")
+                    .firstChildElement("title")
+                    .text());
+
+    writeFile("skin.xml", QByteArrayLiteral("<skin><manifest><title>Changed</title></manifest></skin>"));
+    EXPECT_EQ(QStringLiteral("Changed"),
+            SkinDocumentCache::loadDocument(skinPath, "skin")
+                    .firstChildElement("manifest")
+                    .firstChildElement("title")
+                    .text());
+}
+
+TEST_F(SkinDocumentCacheTest, InvalidFile) {
+    const QString skinPath = writeFile("skin.xml", QByteArrayLiteral("<skin><unclosed></skin>"));
+    EXPECT_TRUE(SkinDocumentCache::loadDocument(skinPath, "skin").isNull());
+    EXPECT_TRUE(SkinDocumentCache::loadDocument(
+            getTestDataDir().filePath("missing.xml"), "skin")
+                        .isNull());
+}
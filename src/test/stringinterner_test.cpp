@@ -0,0 +1,72 @@
+#include "util/stringinterner.h"
+
+#include <gtest/gtest.h>
+
+#include <QThread>
+#include <vector>
+
+namespace {
+
+class StringInternerTest : public testing::Test {
+  protected:
+    mixxx::StringInterner m_interner;
+};
+
+TEST_F(StringInternerTest, EqualStringsShareStorage) {
+    // Construct the strings separately, like values read from the database
+    const QString first = QString::fromUtf8("Drum & Bass");
+    const QString second = QString::fromUtf8("Drum & Bass");
+    ASSERT_NE(first.constData(), second.constData());
+
+    const QString internedFirst = m_interner.intern(first);
+    const QString internedSecond = m_interner.intern(second);
+    EXPECT_EQ(first, internedSecond);
+    EXPECT_EQ(internedFirst.constData(), internedSecond.constData());
+    EXPECT_EQ(1, m_interner.size());
+}
+
+TEST_F(StringInternerTest, DifferentStrings) {
+    const QString house = m_interner.intern(QStringLiteral("House"));
+    const QString techno = m_interner.intern(QStringLiteral("Techno"));
+    EXPECT_EQ(QStringLiteral("House"), house);
+    EXPECT_EQ(QStringLiteral("Techno"), techno);
+    EXPECT_EQ(2, m_interner.size());
+}
+
+TEST_F(StringInternerTest, EmptyStringsAreNotStored) {
+    EXPECT_TRUE(m_interner.intern(QString()).isNull());
+    EXPECT_TRUE(m_interner.intern(QStringLiteral("")).isEmpty());
+    EXPECT_EQ(0, m_interner.size());
+}
+
+TEST_F(StringInternerTest, CapacityIsBounded) {
+    mixxx::StringInterner interner(mixxx::StringInterner::kShardCount);
+    for (int i = 0; i < 100; ++i) {
+        const QString value = QStringLiteral("Genre %1").arg(i);
+        EXPECT_EQ(value, interner.intern(value));
+    }
+    EXPECT_LE(interner.size(), mixxx::StringInterner::kShardCount);
+}
+
+TEST_F(StringInternerTest, ConcurrentInterning) {
+    constexpr int kThreadCount = 4;
+    constexpr int kDistinctValues = 100;
+    std::vector<QThread*> threads;
+    for (int i = 0; i < kThreadCount; ++i) {
+        threads.push_back(QThread::create([this] {
+            for (int j = 0; j < 10 * kDistinctValues; ++j) {
+                m_interner.intern(QStringLiteral("Genre %1").arg(j % kDistinctValues));
+            }
+        }));
+        threads.back()->start();
+    }
+    for (auto* pThread : threads) {
+        pThread->wait();
+        delete pThread;
+    }
+    EXPECT_EQ(kDistinctValues, m_interner.size());
+    EXPECT_EQ(m_interner.intern(QStringLiteral("Genre 42")).constData(),
+            m_interner.intern(QStringLiteral("Genre 42")).constData());
+}
+
+} // namespace
@@ -0,0 +1,167 @@
+#include "util/tracerecorder.h"
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QThread>
+
+namespace {
+
+class TraceRecorderTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        mixxx::TraceRecorder::clear();
+    }
+
+    void TearDown() override {
+        mixxx::TraceRecorder::setEnabled(false);
+        mixxx::TraceRecorder::clear();
+    }
+};
+
+TEST_F(TraceRecorderTest, DisabledRecordsNothing) {
+    ASSERT_FALSE(mixxx::TraceRecorder::isEnabled());
+    {
+        mixxx::ScopedTraceEvent trace("test", "disabled");
+    }
+    EXPECT_EQ(0u, mixxx::TraceRecorder::eventCount());
+}
+
+TEST_F(TraceRecorderTest, RecordFromMultipleThreads) {
+    mixxx::TraceRecorder::setEnabled(true);
+    {
+        mixxx::ScopedTraceEvent trace("test", "main");
+    }
+    QThread* pThread = QThread::create([] {
+        for (int i = 0; i < 10; ++i) {
+            mixxx::ScopedTraceEvent trace("test", "worker");
+        }
+    });
+    pThread->setObjectName(QStringLiteral("Worker \"1\""));
+    pThread->start();
+    pThread->wait();
+    delete pThread;
+    mixxx::TraceRecorder::setEnabled(false);
+
+    EXPECT_EQ(11u, mixxx::TraceRecorder::eventCount());
+
+    QTemporaryDir tempDir;
+    const QString filePath = tempDir.filePath(QStringLiteral("trace.json"));
+    ASSERT_TRUE(mixxx::TraceRecorder::writeChromeTrace(filePath));
+
+    QFile file(filePath);
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    QJsonParseError error;
+    const QJsonDocument json = QJsonDocument::fromJson(file.readAll(), &error);
+    ASSERT_EQ(QJsonParseError::NoError, error.error) << error.errorString().toStdString();
+
+    int numMainEvents = 0;
+    int numWorkerEvents = 0;
+    bool foundWorkerThreadName = false;
+    const QJsonArray events = json.object().value(QStringLiteral("traceEvents")).toArray();
+    for (const auto& value : events) {
+        const QJsonObject event = value.toObject();
+        const QString phase = event.value(QStringLiteral("ph")).toString();
+        if (phase == QStringLiteral("M")) {
+            foundWorkerThreadName |= event.value(QStringLiteral("args"))
+                                             .toObject()
+                                             .value(QStringLiteral("name"))
+                                             .toString() == QStringLiteral("Worker \"1\"");
+            continue;
+        }
+        EXPECT_EQ(QStringLiteral("X"), phase);
+        EXPECT_EQ(QStringLiteral("test"), event.value(QStringLiteral("cat")).toString());
+        EXPECT_GE(event.value(QStringLiteral("dur")).toDouble(), 0.0);
+        const QString name = event.value(QStringLiteral("name")).toString();
+        if (name == QStringLiteral("main")) {
+            ++numMainEvents;
+        } else if (name == QStringLiteral("worker")) {
+            ++numWorkerEvents;
+        }
+    }
+    EXPECT_EQ(1, numMainEvents);
+    EXPECT_EQ(10, numWorkerEvents);
+    EXPECT_TRUE(foundWorkerThreadName);
+}
+
+TEST_F(TraceRecorderTest, OverwriteOldestEvents) {
+    mixxx::TraceRecorder::setEnabled(true);
+    const std::size_t eventsPerThread = mixxx::TraceRecorder::eventsPerThread();
+    for (std::size_t i = 0; i < eventsPerThread + 100; ++i) {
+        mixxx::ScopedTraceEvent trace("test", "overflow");
+    }
+    mixxx::TraceRecorder::setEnabled(false);
+    EXPECT_EQ(eventsPerThread, mixxx::TraceRecorder::eventCount());
+}
+
+TEST_F(TraceRecorderTest, EscapeControlCharactersInThreadNames) {
+    mixxx::TraceRecorder::setEnabled(true);
+    QThread* pThread = QThread::create([] {
+        mixxx::ScopedTraceEvent trace("test", "worker");
+    });
+    pThread->setObjectName(QStringLiteral("Worker\t\x01"));
+    pThread->start();
+    pThread->wait();
+    delete pThread;
+    mixxx::TraceRecorder::setEnabled(false);
+
+    QTemporaryDir tempDir;
+    const QString filePath = tempDir.filePath(QStringLiteral("trace.json"));
+    ASSERT_TRUE(mixxx::TraceRecorder::writeChromeTrace(filePath));
+
+    QFile file(filePath);
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    QJsonParseError error;
+    const QJsonDocument json = QJsonDocument::fromJson(file.readAll(), &error);
+    ASSERT_EQ(QJsonParseError::NoError, error.error) << error.errorString().toStdString();
+
+    bool foundWorkerThreadName = false;
+    const QJsonArray events = json.object().value(QStringLiteral("traceEvents")).toArray();
+    for (const auto& value : events) {
+        foundWorkerThreadName |= value.toObject()
+                                         .value(QStringLiteral("args"))
+                                         .toObject()
+                                         .value(QStringLiteral("name"))
+                                         .toString() == QStringLiteral("Worker\t\x01");
+    }
+    EXPECT_TRUE(foundWorkerThreadName);
+}
+
+TEST_F(TraceRecorderTest, RealtimeThreadUsesSpareBuffer) {
+    mixxx::TraceRecorder::setEnabled(true);
+    QThread* pThread = QThread::create([] {
+        mixxx::TraceRecorder::markCurrentThreadRealtime();
+        mixxx::ScopedTraceEvent trace("test", "realtime");
+    });
+    pThread->start();
+    pThread->wait();
+    delete pThread;
+    mixxx::TraceRecorder::setEnabled(false);
+
+    EXPECT_EQ(1u, mixxx::TraceRecorder::eventCount());
+    EXPECT_EQ(0u, mixxx::TraceRecorder::droppedEventCount());
+}
+
+TEST_F(TraceRecorderTest, RecycleBuffersOfExitedThreads) {
+    mixxx::TraceRecorder::setEnabled(true);
+    for (int i = 0; i < 2 * mixxx::TraceRecorder::kMaxThreads; ++i) {
+        QThread* pThread = QThread::create([] {
+            mixxx::ScopedTraceEvent trace("test", "short-lived");
+        });
+        pThread->start();
+        pThread->wait();
+        delete pThread;
+    }
+    mixxx::TraceRecorder::setEnabled(false);
+
+    // The events of the oldest threads have been overwritten
+    EXPECT_LE(mixxx::TraceRecorder::eventCount(),
+            static_cast<std::size_t>(mixxx::TraceRecorder::kMaxThreads));
+    EXPECT_EQ(0u, mixxx::TraceRecorder::droppedEventCount());
+}
+
+} // namespace
@@ -56,3 +56,63 @@ TEST_F(TrackDAOTest, detectMovedTracks) {
     QSet<QString> trackLocations = trackDAO.getAllTrackLocations();
     EXPECT_THAT(trackLocations, UnorderedElementsAre(newFile.location(), otherFile.location()));
 }
+
+TEST_F(TrackDAOTest, detectMovedTracksByContentHash) {
+    TrackDAO& trackDAO = internalCollection()->getTrackDAO();
+
+    mixxx::FileInfo oldFile(QDir(QDir::tempPath() + QStringLiteral("/old/dir1")),
+            QStringLiteral("01 - Waterloo.mp3"));
+    // Renamed and re-tagged, i.e. the file size has changed
+    mixxx::FileInfo newFile(QDir(QDir::tempPath() + QStringLiteral("/new/dir2")),
+            QStringLiteral("Abba - Waterloo.mp3"));
+    // Same duration, but different content
+    mixxx::FileInfo otherFile(QDir(QDir::tempPath() + QStringLiteral("/new/dir2")),
+            QStringLiteral("Abba - Mamma Mia.mp3"));
+
+    TrackPointer pOldTrack = Track::newTemporary(mixxx::FileAccess(oldFile));
+    TrackPointer pNewTrack = Track::newTemporary(mixxx::FileAccess(newFile));
+    TrackPointer pOtherTrack = Track::newTemporary(mixxx::FileAccess(otherFile));
+    pOldTrack->setDuration(163);
+    pNewTrack->setDuration(163.2);
+    pOtherTrack->setDuration(163.2);
+
+    TrackId oldId = internalCollection()->addTrack(pOldTrack, false);
+    TrackId newId = internalCollection()->addTrack(pNewTrack, false);
+    internalCollection()->addTrack(pOtherTrack, false);
+
+    // The files don't exist and could not be hashed
+    QSqlQuery query(dbConnection());
+    query.prepare(
+            "UPDATE track_locations SET content_hash=:content_hash, "
+            "filesize=:filesize WHERE location=:location");
+    query.bindValue(":content_hash", 4711);
+    query.bindValue(":filesize", 1000);
+    query.bindValue(":location", oldFile.location());
+    ASSERT_TRUE(query.exec());
+    query.bindValue(":content_hash", 4711);
+    query.bindValue(":filesize", 1100);
+    query.bindValue(":location", newFile.location());
+    ASSERT_TRUE(query.exec());
+    query.bindValue(":content_hash", 4712);
+    query.bindValue(":filesize", 1000);
+    query.bindValue(":location", otherFile.location());
+    ASSERT_TRUE(query.exec());
+
+    // Mark as missing
+    query.prepare("UPDATE track_locations SET fs_deleted=1 WHERE location=:location");
+    query.bindValue(":location", oldFile.location());
+    ASSERT_TRUE(query.exec());
+
+    QList<RelocatedTrack> relocatedTracks;
+    QStringList addedTracks{newFile.location(), otherFile.location()};
+    bool cancel = false;
+    EXPECT_TRUE(trackDAO.detectMovedTracks(&relocatedTracks, addedTracks, &cancel));
+
+    ASSERT_EQ(1, relocatedTracks.size());
+    EXPECT_EQ(oldId, relocatedTracks.first().updatedTrackRef().getId());
+    EXPECT_EQ(newFile.location(), relocatedTracks.first().updatedTrackRef().getLocation());
+    EXPECT_EQ(newId, relocatedTracks.first().deletedTrackId());
+
+    QSet<QString> trackLocations = trackDAO.getAllTrackLocations();
+    EXPECT_THAT(trackLocations, UnorderedElementsAre(newFile.location(), otherFile.location()));
+}
@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+
+#include <QSet>
+#include <QStringList>
+#include <vector>
+
+#include "track/trackrecord.h"
+#include "util/stringinterner.h"
+
+namespace {
+
+constexpr int kTrackCount = 50000;
+
+// The payload of the string, excluding the header and the overhead of the
+// allocator. Shared buffers are only counted once.
+std::size_t stringBytes(const QString& string,
+        QSet<const void*>* pCountedBuffers) {
+    if (string.isEmpty() || pCountedBuffers->contains(string.constData())) {
+        return 0;
+    }
+    pCountedBuffers->insert(string.constData());
+    return (string.capacity() + 1) * sizeof(QChar);
+}
+
+std::size_t trackRecordBytes(
+        const mixxx::TrackRecord& trackRecord,
+        QSet<const void*>* pCountedBuffers) {
+    const auto& trackInfo = trackRecord.getMetadata().getTrackInfo();
+    const auto& albumInfo = trackRecord.getMetadata().getAlbumInfo();
+    return sizeof(mixxx::TrackRecord) +
+            stringBytes(trackInfo.getTitle(), pCountedBuffers) +
+            stringBytes(trackInfo.getArtist(), pCountedBuffers) +
+            stringBytes(trackInfo.getGenre(), pCountedBuffers) +
+            stringBytes(trackInfo.getComposer(), pCountedBuffers) +
+            stringBytes(trackInfo.getGrouping(), pCountedBuffers) +
+            stringBytes(trackRecord.getFileType(), pCountedBuffers) +
+            stringBytes(albumInfo.getTitle(), pCountedBuffers) +
+            stringBytes(albumInfo.getArtist(), pCountedBuffers);
+}
+
+// Each value is constructed separately, like values that are read from
+// the database.
+QString fieldValue(const char* prefix,
+        int index,
+        bool interned,
+        mixxx::StringInterner* pInterner) {
+    QString string = QStringLiteral("%1 %2").arg(QLatin1String(prefix)).arg(index);
+    if (interned) {
+        return pInterner->intern(string);
+    }
+    return string;
+}
+
+// Measures the memory per track record of a library with realistic
+// cardinalities of the metadata fields, with and without interning of
+// the low-cardinality fields like TrackDAO does.
+void BM_TrackRecord_MemoryPerTrack(benchmark::State& state) {
+    const bool interned = state.range(0) != 0;
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        mixxx::StringInterner interner;
+        std::vector<mixxx::TrackRecord> trackRecords(kTrackCount);
+        for (int i = 0; i < kTrackCount; ++i) {
+            auto& trackInfo = trackRecords[i].refMetadata().refTrackInfo();
+            auto& albumInfo = trackRecords[i].refMetadata().refAlbumInfo();
+            trackInfo.setTitle(fieldValue("Title", i, false, &interner));
+            trackInfo.setArtist(fieldValue("Artist", i % 2000, false, &interner));
+            trackInfo.setGenre(fieldValue("Genre", i % 50, interned, &interner));
+            trackInfo.setComposer(fieldValue("Composer", i % 1000, false, &interner));
+            trackInfo.setGrouping(fieldValue("Grouping", i % 20, interned, &interner));
+            albumInfo.setTitle(fieldValue("Album", i / 10, false, &interner));
+            albumInfo.setArtist(fieldValue("Artist", i % 2000, false, &interner));
+            trackRecords[i].setFileType(fieldValue("mp", i % 5, interned, &interner));
+        }
+        QSet<const void*> countedBuffers;
+        bytes = 0;
+        for (const auto& trackRecord : trackRecords) {
+            bytes += trackRecordBytes(trackRecord, &countedBuffers);
+        }
+        benchmark::DoNotOptimize(bytes);
+    }
+    state.counters["bytes_per_track"] = static_cast<double>(bytes) / kTrackCount;
+}
+BENCHMARK(BM_TrackRecord_MemoryPerTrack)->Arg(0)->Arg(1);
+
+void BM_StringInterner_Intern(benchmark::State& state) {
+    // Values of a low-cardinality field of many tracks
+    const int distinctValues = static_cast<int>(state.range(0));
+    QStringList values;
+    for (int i = 0; i < 10000; ++i) {
+        values.append(QStringLiteral("Genre %1").arg(i % distinctValues));
+    }
+    for (auto _ : state) {
+        mixxx::StringInterner interner;
+        for (const auto& value : std::as_const(values)) {
+            benchmark::DoNotOptimize(interner.intern(value));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_StringInterner_Intern)->Range(1 << 4, 1 << 12);
+
+} // namespace
@@ -0,0 +1,85 @@
+#include "library/tracksimilarityindex.h"
+
+#include <gtest/gtest.h>
+
+#include "util/math.h"
+
+namespace {
+
+using mixxx::track::io::key::ChromaticKey;
+
+class TrackSimilarityIndexTest : public ::testing::Test {
+  protected:
+    static TrackId trackId(int id) {
+        return TrackId(QVariant(id));
+    }
+
+    static TrackSimilarityIndex::Features features(
+            double bpm,
+            ChromaticKey key = mixxx::track::io::key::INVALID) {
+        TrackSimilarityIndex::Features features;
+        features.bpm = bpm;
+        features.key = key;
+        features.replayGainRatio = 1.0;
+        features.durationSeconds = 300;
+        return features;
+    }
+
+    TrackSimilarityIndex m_index;
+};
+
+TEST_F(TrackSimilarityIndexTest, findNearest) {
+    m_index.insertTrack(trackId(1), features(124, mixxx::track::io::key::A_MINOR));
+    m_index.insertTrack(trackId(2), features(126, mixxx::track::io::key::A_MINOR));
+    m_index.insertTrack(trackId(3), features(125, mixxx::track::io::key::F_SHARP_MAJOR));
+    m_index.insertTrack(trackId(4), features(200, mixxx::track::io::key::A_MINOR));
+    m_index.insertTrack(trackId(5), features(124, mixxx::track::io::key::E_MINOR));
+    m_index.insertTrack(trackId(6), features(0));
+    EXPECT_EQ(5, m_index.size());
+
+    // The reference track is excluded, the clashing key and the
+    // distant tempo rank last
+    EXPECT_EQ(QList<TrackId>({trackId(2), trackId(5), trackId(3), trackId(4)}),
+            m_index.findNearest(trackId(1), 10));
+    EXPECT_EQ(QList<TrackId>({trackId(2), trackId(5)}),
+            m_index.findNearest(trackId(1), 2));
+    EXPECT_EQ(QList<TrackId>({trackId(5), trackId(3)}),
+            m_index.findNearest(trackId(1), 2, [](TrackId candidateId) {
+                return candidateId != trackId(2);
+            }));
+
+    // Tracks without a BPM are not indexed
+    EXPECT_TRUE(m_index.findNearest(trackId(6), 10).isEmpty());
+}
+
+TEST_F(TrackSimilarityIndexTest, updateAndRemove) {
+    m_index.insertTrack(trackId(1), features(120));
+    m_index.insertTrack(trackId(2), features(121));
+    m_index.insertTrack(trackId(3), features(140));
+    EXPECT_EQ(QList<TrackId>({trackId(2)}), m_index.findNearest(trackId(1), 1));
+
+    m_index.insertTrack(trackId(3), features(120));
+    EXPECT_EQ(3, m_index.size());
+    EXPECT_EQ(QList<TrackId>({trackId(3)}), m_index.findNearest(trackId(1), 1));
+
+    m_index.removeTracks(QSet<TrackId>{trackId(3)});
+    EXPECT_EQ(2, m_index.size());
+    EXPECT_FALSE(m_index.trackFeatures(trackId(3)).has_value());
+    EXPECT_EQ(QList<TrackId>({trackId(2)}), m_index.findNearest(trackId(1), 10));
+}
+
+TEST_F(TrackSimilarityIndexTest, distance) {
+    const auto reference = features(120, mixxx::track::io::key::C_MAJOR);
+    EXPECT_DOUBLE_EQ(0.0, TrackSimilarityIndex::distance(reference, reference));
+
+    // A relative key is a single step
+    EXPECT_DOUBLE_EQ(1.0,
+            TrackSimilarityIndex::distance(reference,
+                    features(120, mixxx::track::io::key::A_MINOR)));
+
+    auto louder = reference;
+    louder.replayGainRatio = db2ratio(-3.0);
+    EXPECT_NEAR(1.0, TrackSimilarityIndex::distance(reference, louder), 1e-9);
+}
+
+} // namespace
@@ -1,6 +1,9 @@
 #include "track/globaltrackcache.h"
 
 #include <QCoreApplication>
+#include <QThread>
+#include <algorithm>
+#include <atomic>
 
 #include "moc_globaltrackcache.cpp"
 #include "track/track.h"
@@ -30,6 +33,15 @@ inline bool traceLogEnabled() {
 
 constexpr bool kLogStats = false;
 
+// Delay between writing the file tags of two tracks while throttled
+constexpr unsigned long kThrottledMetadataExportDelayMillis = 250;
+
+// Limits the time that the thread of the cache spends with saving
+// exported tracks before processing other events
+constexpr std::size_t kMaxExportedTracksSavedPerBatch = 16;
+
+std::atomic<bool> s_metadataExportThrottled(false);
+
 inline
 TrackRef createTrackRef(const Track& track) {
     return TrackRef::fromFileInfo(track.getFileInfo(), track.getId());
@@ -278,15 +290,13 @@ void GlobalTrackCache::evictAndSaveCachedTrack(GlobalTrackCacheEntryPointer cach
     // already have been either deleted or reused by a second
     // shared_ptr.
     if (s_pInstance) {
-        QMetaObject::invokeMethod(
-                s_pInstance,
-                [cacheEntryPtr = std::move(cacheEntryPtr)] {
-                    s_pInstance->slotEvictAndSave(cacheEntryPtr);
-                },
-                // Qt will choose either a direct or a queued connection
-                // depending on the thread from which this method has
-                // been invoked!
-                Qt::AutoConnection);
+        if (QThread::currentThread() == s_pInstance->thread()) {
+            std::vector<GlobalTrackCacheEntryPointer> cacheEntryPtrs;
+            cacheEntryPtrs.push_back(std::move(cacheEntryPtr));
+            s_pInstance->evictAndSave(std::move(cacheEntryPtrs));
+        } else {
+            s_pInstance->enqueueEviction(std::move(cacheEntryPtr));
+        }
     } else {
         // After the singular instance has been destroyed we are
         // not able to save pending changes. The track is deleted
@@ -299,17 +309,30 @@ void GlobalTrackCache::evictAndSaveCachedTrack(GlobalTrackCacheEntryPointer cach
     }
 }
 
+//static
+void GlobalTrackCache::setMetadataExportThrottled(bool throttled) {
+    s_metadataExportThrottled.store(throttled);
+}
+
 GlobalTrackCache::GlobalTrackCache(
         GlobalTrackCacheSaver* pSaver,
         deleteTrackFn_t deleteTrackFn)
         : m_pSaver(pSaver),
           m_deleteTrackFn(deleteTrackFn),
-          m_tracksById(kUnorderedCollectionMinCapacity, DbId::hash_fun) {
+          m_saveExportedTracksScheduled(false),
+          m_pMetadataExportCurrentTrack(nullptr),
+          m_metadataExportRunning(false),
+          m_tracksById(kUnorderedCollectionMinCapacity, DbId::hash_fun),
+          m_tracksByCanonicalLocation(kUnorderedCollectionMinCapacity) {
     DEBUG_ASSERT(m_pSaver);
-    qRegisterMetaType<GlobalTrackCacheEntryPointer>("GlobalTrackCacheEntryPointer");
+    // A single writer thread avoids concurrent disk I/O
+    m_metadataExportThreadPool.setMaxThreadCount(1);
 }
 
 GlobalTrackCache::~GlobalTrackCache() {
+    // All pending exports need to finish before saving the tracks
+    m_metadataExportThreadPool.waitForDone();
+    const auto locked = lockMutex(&m_mutex);
     deactivate();
 }
 
@@ -364,7 +387,8 @@ void GlobalTrackCache::relocateTracks(
     m_tracksByCanonicalLocation = std::move(relocatedTracksByCanonicalLocation);
 }
 
-void GlobalTrackCache::saveEvictedTrack(Track* pEvictedTrack) const {
+//static
+void GlobalTrackCache::detachEvictedTrack(Track* pEvictedTrack) {
     DEBUG_ASSERT(pEvictedTrack);
     // Disconnect all receivers and block signals before saving the
     // track. Accessing an object-under-destruction in signal handlers
@@ -374,12 +398,18 @@ void GlobalTrackCache::saveEvictedTrack(Track* pEvictedTrack) const {
     // a track that is about to deleted may cause access violations!!
     pEvictedTrack->disconnect();
     pEvictedTrack->blockSignals(true);
+}
+
+void GlobalTrackCache::saveEvictedTrack(Track* pEvictedTrack) const {
+    detachEvictedTrack(pEvictedTrack);
     m_pSaver->saveEvictedTrack(pEvictedTrack);
 }
 
 void GlobalTrackCache::deactivate() {
     DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
 
+    saveExportedTracksWhileLocked();
+
     if (isEmpty()) {
         return;
     }
@@ -429,9 +459,23 @@ bool GlobalTrackCache::isEmpty() const {
 
 TrackPointer GlobalTrackCache::lookupById(
         const TrackId& trackId) {
-    while (m_incompleteTrack && m_incompleteTrack->getId() == trackId) {
+    while ((m_incompleteTrack && m_incompleteTrack->getId() == trackId) ||
+            m_savingTrackIds.contains(trackId)) {
+        if (!m_exportingTracks.empty() && QThread::currentThread() == thread()) {
+            // Exported tracks are saved by this thread that must not wait for itself
+            Track* pExportingTrack = findExportingTrackWhileLocked(
+                    [&trackId](const TrackRef& trackRef) {
+                        return trackRef.getId() == trackId;
+                    });
+            if (pExportingTrack) {
+                saveExportingTrackWhileLocked(pExportingTrack);
+                continue;
+            }
+        }
         // The requested track is currently locked by another thread
         // (despite us currently owning the global track cache lock aka. m_mutex).
+        // Either it is still loaded or it has been evicted and is
+        // currently saved.
         //
         // The background metadata loader thread can use this mechanism
         // to avoid blocking the global lock for longer periods of time,
@@ -494,8 +538,20 @@ TrackPointer GlobalTrackCache::lookupByRef(
 
 TrackPointer GlobalTrackCache::lookupByCanonicalLocation(
         const QString& canonicalLocation) {
-    while (m_incompleteTrack &&
-            m_incompleteTrack->getFileInfo().canonicalLocationPath() == canonicalLocation) {
+    while ((m_incompleteTrack &&
+                   m_incompleteTrack->getFileInfo().canonicalLocationPath() ==
+                           canonicalLocation) ||
+            m_savingCanonicalLocations.contains(canonicalLocation)) {
+        if (!m_exportingTracks.empty() && QThread::currentThread() == thread()) {
+            Track* pExportingTrack = findExportingTrackWhileLocked(
+                    [&canonicalLocation](const TrackRef& trackRef) {
+                        return trackRef.getCanonicalLocation() == canonicalLocation;
+                    });
+            if (pExportingTrack) {
+                saveExportingTrackWhileLocked(pExportingTrack);
+                continue;
+            }
+        }
         // See GlobalTrackCache::lookupById for the comment on how
         // the synchronization with the background metadata loader
         // thread works.
@@ -809,51 +865,317 @@ void GlobalTrackCache::purgeTrackId(TrackId trackId) {
     }
 }
 
-void GlobalTrackCache::slotEvictAndSave(
+void GlobalTrackCache::enqueueEviction(
         GlobalTrackCacheEntryPointer cacheEntryPtr) {
+    bool evictionScheduled;
+    {
+        const auto locker = lockMutex(&m_pendingEvictionsMutex);
+        evictionScheduled = !m_pendingEvictions.empty();
+        m_pendingEvictions.push_back(std::move(cacheEntryPtr));
+    }
+    if (!evictionScheduled) {
+        // All evictions that are requested until the event loop of
+        // the cache picks up this invocation are processed as a batch
+        QMetaObject::invokeMethod(
+                this,
+                &GlobalTrackCache::slotEvictAndSavePending,
+                Qt::QueuedConnection);
+    }
+}
+
+void GlobalTrackCache::slotEvictAndSavePending() {
+    std::vector<GlobalTrackCacheEntryPointer> cacheEntryPtrs;
+    {
+        const auto locker = lockMutex(&m_pendingEvictionsMutex);
+        cacheEntryPtrs.swap(m_pendingEvictions);
+    }
+    evictAndSave(std::move(cacheEntryPtrs));
+}
+
+void GlobalTrackCache::evictAndSave(
+        std::vector<GlobalTrackCacheEntryPointer> cacheEntryPtrs) {
     DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
-    DEBUG_ASSERT(cacheEntryPtr);
 
-    // GlobalTrackCacheSaver::saveEvictedTrack() requires that
-    // exclusive access is guaranteed for the duration of the
-    // whole invocation!
-    GlobalTrackCacheLocker cacheLocker;
+    std::vector<EvictedTrack> evictedTracks;
+    evictedTracks.reserve(cacheEntryPtrs.size());
 
-    if (!cacheEntryPtr->expired()) {
-        // We have handed out (revived) this track again after our reference count
-        // drops to zero and before acquiring the lock at the beginning of this function
-        if (debugLogEnabled()) {
-            kLogger.debug()
-                    << "Skip to evict and save a revived or reallocated track"
-                    << cacheEntryPtr->getPlainPtr();
+    {
+        GlobalTrackCacheLocker cacheLocker;
+        for (auto& cacheEntryPtr : cacheEntryPtrs) {
+            DEBUG_ASSERT(cacheEntryPtr);
+            if (!cacheEntryPtr->expired()) {
+                // We have handed out (revived) this track again after our reference count
+                // drops to zero and before acquiring the lock at the beginning of this function
+                if (debugLogEnabled()) {
+                    kLogger.debug()
+                            << "Skip to evict and save a revived or reallocated track"
+                            << cacheEntryPtr->getPlainPtr();
+                }
+                continue;
+            }
+
+            auto trackRef = createTrackRef(*cacheEntryPtr->getPlainPtr());
+            if (!tryEvict(cacheEntryPtr->getPlainPtr(), trackRef)) {
+                // A second deleter has already evicted the track from cache after our
+                // reference count drops to zero and before acquiring the lock at the
+                // beginning of this function
+                if (debugLogEnabled()) {
+                    kLogger.debug()
+                            << "Skip to save an already evicted track again"
+                            << cacheEntryPtr->getPlainPtr();
+                }
+                continue;
+            }
+            DEBUG_ASSERT(!isCached(cacheEntryPtr->getPlainPtr()));
+
+            // Suspend all lookups for this track until it has been saved
+            if (trackRef.hasId()) {
+                m_savingTrackIds.insert(trackRef.getId());
+            }
+            if (trackRef.hasCanonicalLocation()) {
+                m_savingCanonicalLocations.insert(trackRef.getCanonicalLocation());
+            }
+            evictedTracks.push_back(EvictedTrack{
+                    std::move(cacheEntryPtr),
+                    std::move(trackRef)});
         }
+    }
+    if (evictedTracks.empty()) {
         return;
     }
 
-    if (!tryEvict(cacheEntryPtr->getPlainPtr())) {
-        // A second deleter has already evicted the track from cache after our
-        // reference count drops to zero and before acquiring the lock at the
-        // beginning of this function
-        if (debugLogEnabled()) {
-            kLogger.debug()
-                    << "Skip to save an already evicted track again"
-                    << cacheEntryPtr->getPlainPtr();
+    // GlobalTrackCacheSaver::saveEvictedTrack() requires that the
+    // evicted tracks are not accessible for the duration of the
+    // whole invocation. This is ensured by suspending all lookups
+    // for their ids and canonical locations, so the cache is not
+    // locked and lookups of other tracks don't need to wait for
+    // the database.
+    std::vector<EvictedTrack> savedTracks;
+    std::vector<EvictedTrack> exportingTracks;
+    for (auto& evictedTrack : evictedTracks) {
+        Track* pEvictedTrack = evictedTrack.cacheEntryPtr->getPlainPtr();
+        if (m_pSaver->needsMetadataExport(pEvictedTrack)) {
+            // Lookups remain suspended until the writer thread has
+            // exported the metadata and the track has been saved.
+            detachEvictedTrack(pEvictedTrack);
+            exportingTracks.push_back(std::move(evictedTrack));
+            continue;
         }
-        return;
+        saveEvictedTrack(pEvictedTrack);
+        savedTracks.push_back(std::move(evictedTrack));
     }
 
-    DEBUG_ASSERT(!isCached(cacheEntryPtr->getPlainPtr()));
-    saveEvictedTrack(cacheEntryPtr->getPlainPtr());
-
-    // Explicitly release the cacheEntryPtr including the owned
-    // track object while the cache is still locked.
-    cacheEntryPtr.reset();
+    GlobalTrackCacheLocker cacheLocker;
+    if (!exportingTracks.empty()) {
+        bool startWriter;
+        {
+            const auto locker = lockMutex(&m_metadataExportMutex);
+            for (auto& exportingTrack : exportingTracks) {
+                Track* pEvictedTrack = exportingTrack.cacheEntryPtr->getPlainPtr();
+                m_metadataExportQueue.push_back(pEvictedTrack);
+                m_exportingTracks.emplace(pEvictedTrack, std::move(exportingTrack));
+            }
+            startWriter = !m_metadataExportRunning;
+            m_metadataExportRunning = true;
+        }
+        if (startWriter) {
+            m_metadataExportThreadPool.start([this] {
+                exportMetadata();
+            });
+        }
+    }
+    finishSavingWhileLocked(std::move(savedTracks));
 
     // Finally the exclusive lock on the cache is released implicitly
     // when exiting the scope of this method.
 }
 
-bool GlobalTrackCache::tryEvict(Track* plainPtr) {
+void GlobalTrackCache::finishSavingWhileLocked(std::vector<EvictedTrack>&& savedTracks) {
+    if (savedTracks.empty()) {
+        return;
+    }
+    for (const auto& savedTrack : savedTracks) {
+        if (savedTrack.trackRef.hasId()) {
+            m_savingTrackIds.remove(savedTrack.trackRef.getId());
+        }
+        if (savedTrack.trackRef.hasCanonicalLocation()) {
+            m_savingCanonicalLocations.remove(savedTrack.trackRef.getCanonicalLocation());
+        }
+    }
+    // Explicitly release the cache entries including the owned
+    // track objects while the cache is still locked.
+    savedTracks.clear();
+    m_isTrackCompleted.wakeAll();
+}
+
+void GlobalTrackCache::exportMetadata() {
+    while (true) {
+        if (s_metadataExportThrottled.load()) {
+            QThread::msleep(kThrottledMetadataExportDelayMillis);
+        }
+        Track* pTrack;
+        {
+            const auto locker = lockMutex(&m_metadataExportMutex);
+            if (m_metadataExportQueue.empty()) {
+                m_metadataExportRunning = false;
+                return;
+            }
+            pTrack = m_metadataExportQueue.front();
+            m_metadataExportQueue.pop_front();
+            m_pMetadataExportCurrentTrack = pTrack;
+        }
+        const auto exportResult = m_pSaver->exportEvictedTrackMetadata(pTrack);
+        bool scheduleSave;
+        {
+            const auto locker = lockMutex(&m_mutex);
+            {
+                const auto exportLocker = lockMutex(&m_metadataExportMutex);
+                m_pMetadataExportCurrentTrack = nullptr;
+            }
+            const auto i = m_exportingTracks.find(pTrack);
+            VERIFY_OR_DEBUG_ASSERT(i != m_exportingTracks.end()) {
+                continue;
+            }
+            i->second.metadataExported = true;
+            i->second.exportResult = exportResult;
+            scheduleSave = !m_saveExportedTracksScheduled;
+            m_saveExportedTracksScheduled = true;
+        }
+        m_isTrackCompleted.wakeAll();
+        if (scheduleSave) {
+            QMetaObject::invokeMethod(
+                    this,
+                    &GlobalTrackCache::slotSaveExportedTracks,
+                    Qt::QueuedConnection);
+        }
+    }
+}
+
+void GlobalTrackCache::slotSaveExportedTracks() {
+    DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
+
+    std::vector<EvictedTrack> exportedTracks;
+    bool scheduleSave = false;
+    {
+        GlobalTrackCacheLocker cacheLocker;
+        for (auto i = m_exportingTracks.begin(); i != m_exportingTracks.end();) {
+            if (!i->second.metadataExported) {
+                ++i;
+                continue;
+            }
+            if (exportedTracks.size() >= kMaxExportedTracksSavedPerBatch) {
+                // Save the remaining tracks after processing other events
+                scheduleSave = true;
+                break;
+            }
+            exportedTracks.push_back(std::move(i->second));
+            i = m_exportingTracks.erase(i);
+        }
+        m_saveExportedTracksScheduled = scheduleSave;
+    }
+    if (scheduleSave) {
+        QMetaObject::invokeMethod(
+                this,
+                &GlobalTrackCache::slotSaveExportedTracks,
+                Qt::QueuedConnection);
+    }
+    // Save without locking the cache like in evictAndSave()
+    for (const auto& exportedTrack : exportedTracks) {
+        m_pSaver->saveExportedTrack(
+                exportedTrack.cacheEntryPtr->getPlainPtr(),
+                exportedTrack.exportResult);
+    }
+    GlobalTrackCacheLocker cacheLocker;
+    finishSavingWhileLocked(std::move(exportedTracks));
+}
+
+void GlobalTrackCache::saveExportedTracksWhileLocked() {
+    DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
+
+    if (m_exportingTracks.empty()) {
+        return;
+    }
+    // Wait until the writer thread has exported all pending tracks
+    while (std::any_of(m_exportingTracks.begin(),
+            m_exportingTracks.end(),
+            [](const auto& entry) { return !entry.second.metadataExported; })) {
+        m_isTrackCompleted.wait(&m_mutex);
+    }
+    std::vector<EvictedTrack> exportedTracks;
+    exportedTracks.reserve(m_exportingTracks.size());
+    for (auto& entry : m_exportingTracks) {
+        m_pSaver->saveExportedTrack(
+                entry.second.cacheEntryPtr->getPlainPtr(),
+                entry.second.exportResult);
+        exportedTracks.push_back(std::move(entry.second));
+    }
+    m_exportingTracks.clear();
+    finishSavingWhileLocked(std::move(exportedTracks));
+}
+
+Track* GlobalTrackCache::findExportingTrackWhileLocked(
+        const std::function<bool(const TrackRef&)>& matches) const {
+    for (const auto& entry : m_exportingTracks) {
+        if (matches(entry.second.trackRef)) {
+            return entry.first;
+        }
+    }
+    return nullptr;
+}
+
+void GlobalTrackCache::saveExportingTrackWhileLocked(Track* pTrack) {
+    DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
+
+    auto i = m_exportingTracks.find(pTrack);
+    VERIFY_OR_DEBUG_ASSERT(i != m_exportingTracks.end()) {
+        return;
+    }
+    bool exportDirectly = false;
+    if (!i->second.metadataExported) {
+        bool exportedByWriter;
+        {
+            const auto locker = lockMutex(&m_metadataExportMutex);
+            const auto queued = std::find(
+                    m_metadataExportQueue.begin(), m_metadataExportQueue.end(), pTrack);
+            exportedByWriter = queued == m_metadataExportQueue.end();
+            if (!exportedByWriter) {
+                // Take the track away from the writer thread
+                m_metadataExportQueue.erase(queued);
+            }
+        }
+        if (exportedByWriter) {
+            // The writer thread is currently exporting this track
+            DEBUG_ASSERT(m_pMetadataExportCurrentTrack == pTrack);
+            while (!i->second.metadataExported) {
+                m_isTrackCompleted.wait(&m_mutex);
+                i = m_exportingTracks.find(pTrack);
+                VERIFY_OR_DEBUG_ASSERT(i != m_exportingTracks.end()) {
+                    return;
+                }
+            }
+        } else {
+            exportDirectly = true;
+        }
+    }
+    // Lookups of this track remain suspended until finishSavingWhileLocked()
+    // and nobody else accesses the detached entry. The file tags and the
+    // database are written without holding the lock, so lookups of other
+    // tracks don't need to wait for the I/O.
+    std::vector<EvictedTrack> exportedTracks;
+    exportedTracks.push_back(std::move(i->second));
+    m_exportingTracks.erase(i);
+    EvictedTrack& exportedTrack = exportedTracks.back();
+    m_mutex.unlock();
+    if (exportDirectly) {
+        exportedTrack.exportResult = m_pSaver->exportEvictedTrackMetadata(pTrack);
+        exportedTrack.metadataExported = true;
+    }
+    m_pSaver->saveExportedTrack(pTrack, exportedTrack.exportResult);
+    m_mutex.lock();
+    finishSavingWhileLocked(std::move(exportedTracks));
+}
+
+bool GlobalTrackCache::tryEvict(Track* plainPtr, const TrackRef& trackRef) {
     DEBUG_ASSERT(plainPtr);
     // Make the cached track object invisible to avoid reusing
     // it before starting to save it. This is achieved by
@@ -864,7 +1186,6 @@ bool GlobalTrackCache::tryEvict(Track* plainPtr) {
     // of the given plainPtr!!
     bool evicted = false;
     bool notEvicted = false;
-    const auto trackRef = createTrackRef(*plainPtr);
     if (debugLogEnabled()) {
         kLogger.debug()
                 << "Evicting track"
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <QSet>
+#include <QThreadPool>
 #include <QWaitCondition>
-#include <map>
+#include <deque>
+#include <functional>
 #include <unordered_map>
+#include <vector>
 
 #include "track/track_decl.h"
 #include "track/trackref.h"
@@ -177,10 +181,13 @@ private:
     ///
     /// GlobalTrackCache ensures that the given pointer is valid
     /// and the last and only reference to this Track object.
-    /// While invoked the GlobalTrackCache is locked to ensure
-    /// that this particular track is not accessible while
-    /// saving the Track object, e.g. by updating the database
-    /// and exporting file tags.
+    /// The track has already been evicted from the cache and
+    /// lookups for the same id or canonical location are suspended
+    /// until this callback returns. This ensures that this particular
+    /// track is not accessible while saving the Track object, e.g.
+    /// by updating the database and exporting file tags. The cache
+    /// itself is not locked and lookups for other tracks are not
+    /// blocked.
     ///
     /// This callback method will always be invoked from the
     /// event loop thread of the owning GlobalTrackCache instance.
@@ -192,6 +199,39 @@ private:
     virtual void saveEvictedTrack(
             Track* pEvictedTrack) noexcept = 0;
 
+    /// Decide if the metadata of an evicted track needs to be exported
+    /// into file tags before saving it. Writing file tags is slow and
+    /// is therefore performed by exportEvictedTrackMetadata() on a
+    /// dedicated writer thread. Afterwards saveExportedTrack() is
+    /// invoked instead of saveEvictedTrack().
+    ///
+    /// Invoked from the event loop thread of the GlobalTrackCache.
+    virtual bool needsMetadataExport(
+            Track* pEvictedTrack) noexcept {
+        Q_UNUSED(pEvictedTrack);
+        return false;
+    }
+
+    /// Export the metadata of an evicted track into file tags.
+    ///
+    /// Invoked from the writer thread of the GlobalTrackCache with
+    /// exclusive access to the evicted track.
+    virtual ExportTrackMetadataResult exportEvictedTrackMetadata(
+            Track* pEvictedTrack) noexcept {
+        Q_UNUSED(pEvictedTrack);
+        return ExportTrackMetadataResult::Skipped;
+    }
+
+    /// Save an evicted track after its metadata has been exported.
+    ///
+    /// Invoked from the event loop thread of the GlobalTrackCache.
+    virtual void saveExportedTrack(
+            Track* pEvictedTrack,
+            ExportTrackMetadataResult exportResult) noexcept {
+        Q_UNUSED(exportResult);
+        saveEvictedTrack(pEvictedTrack);
+    }
+
   protected:
     virtual ~GlobalTrackCacheSaver() = default;
 };
@@ -215,8 +255,13 @@ class GlobalTrackCache : public QObject {
     // Deleter callbacks for the smart-pointer
     static void evictAndSaveCachedTrack(GlobalTrackCacheEntryPointer cacheEntryPtr);
 
+    // Slows down the export of metadata into files, e.g. to avoid
+    // disk I/O while tracks are playing. Might be called from any thread.
+    static void setMetadataExportThrottled(bool throttled);
+
   private slots:
-    void slotEvictAndSave(GlobalTrackCacheEntryPointer cacheEntryPtr);
+    void slotEvictAndSavePending();
+    void slotSaveExportedTracks();
 
   private:
     friend class GlobalTrackCacheLocker;
@@ -263,13 +308,38 @@ class GlobalTrackCache : public QObject {
 
     void purgeTrackId(TrackId trackId);
 
-    bool tryEvict(Track* plainPtr);
+    struct EvictedTrack {
+        GlobalTrackCacheEntryPointer cacheEntryPtr;
+        TrackRef trackRef;
+        // Only used while exporting metadata
+        bool metadataExported = false;
+        ExportTrackMetadataResult exportResult = ExportTrackMetadataResult::Skipped;
+    };
+
+    void enqueueEviction(GlobalTrackCacheEntryPointer cacheEntryPtr);
+    void evictAndSave(std::vector<GlobalTrackCacheEntryPointer> cacheEntryPtrs);
+    void finishSavingWhileLocked(std::vector<EvictedTrack>&& savedTracks);
+
+    // Runs on the writer thread
+    void exportMetadata();
+    // Waits for the writer thread to export all pending tracks, only
+    // used when deactivating the cache
+    void saveExportedTracksWhileLocked();
+    Track* findExportingTrackWhileLocked(
+            const std::function<bool(const TrackRef&)>& matches) const;
+    // Finishes the export of a single track, either by waiting for the
+    // writer thread or by exporting it directly, and saves it. The lock
+    // is temporarily released while exporting and saving.
+    void saveExportingTrackWhileLocked(Track* pTrack);
+
+    bool tryEvict(Track* plainPtr, const TrackRef& trackRef);
     bool isCached(Track* plainPtr) const;
 
     bool isEmpty() const;
 
     void deactivate();
 
+    static void detachEvictedTrack(Track* pEvictedTrack);
     void saveEvictedTrack(Track* pEvictedTrack) const;
 
     // Managed by GlobalTrackCacheLocker
@@ -281,15 +351,39 @@ class GlobalTrackCache : public QObject {
 
     // Managed by GlobalTrackCacheResolver.
     // The track that is currently locked by the asynchronous metadata loader background thread.
-    // m_isTrackCompleted will be signaled once the asynchronous loading has been completed.
+    // m_isTrackCompleted will be signaled once the asynchronous loading has been completed
+    // or once evicted tracks have been saved.
     TrackPointer m_incompleteTrack;
     QWaitCondition m_isTrackCompleted;
 
+    // Ids and canonical locations of evicted tracks that are currently
+    // saved without holding m_mutex. Lookups for these keys are suspended
+    // until saving has finished.
+    QSet<TrackId> m_savingTrackIds;
+    QSet<QString> m_savingCanonicalLocations;
+
+    // Evictions that have been requested from other threads and that
+    // are processed as a batch on the thread of the cache.
+    QMutex m_pendingEvictionsMutex;
+    std::vector<GlobalTrackCacheEntryPointer> m_pendingEvictions;
+
+    // Evicted tracks whose metadata is exported by the writer thread
+    // before they are saved. Guarded by m_mutex.
+    std::unordered_map<Track*, EvictedTrack> m_exportingTracks;
+    bool m_saveExportedTracksScheduled;
+
+    // The queue of the writer thread
+    QMutex m_metadataExportMutex;
+    std::deque<Track*> m_metadataExportQueue;
+    Track* m_pMetadataExportCurrentTrack;
+    bool m_metadataExportRunning;
+    QThreadPool m_metadataExportThreadPool;
+
     // This caches the unsaved Tracks by ID
     typedef std::unordered_map<TrackId, GlobalTrackCacheEntryPointer, TrackId::hash_fun_t> TracksById;
     TracksById m_tracksById;
 
     // This caches the unsaved Tracks by location
-    typedef std::map<QString, GlobalTrackCacheEntryPointer> TracksByCanonicalLocation;
+    typedef std::unordered_map<QString, GlobalTrackCacheEntryPointer> TracksByCanonicalLocation;
     TracksByCanonicalLocation m_tracksByCanonicalLocation;
 };
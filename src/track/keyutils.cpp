@@ -791,6 +791,22 @@ QList<mixxx::track::io::key::ChromaticKey> KeyUtils::getCompatibleKeys(
     return compatible;
 }
 
+// static
+int KeyUtils::camelotDistance(
+        mixxx::track::io::key::ChromaticKey key,
+        mixxx::track::io::key::ChromaticKey otherKey) {
+    if (!ChromaticKey_IsValid(key) ||
+            key == mixxx::track::io::key::INVALID ||
+            !ChromaticKey_IsValid(otherKey) ||
+            otherKey == mixxx::track::io::key::INVALID) {
+        return -1;
+    }
+    const int numberSteps = qAbs(
+            keyToOpenKeyNumber(key) - keyToOpenKeyNumber(otherKey));
+    const int modeSteps = keyIsMajor(key) == keyIsMajor(otherKey) ? 0 : 1;
+    return qMin(numberSteps, 12 - numberSteps) + modeSteps;
+}
+
 int KeyUtils::keyToCircleOfFifthsOrder(mixxx::track::io::key::ChromaticKey key,
                                        KeyNotation notation) {
     if (!ChromaticKey_IsValid(key)) {
@@ -95,6 +95,13 @@ class KeyUtils {
     static QList<mixxx::track::io::key::ChromaticKey> getCompatibleKeys(
         mixxx::track::io::key::ChromaticKey key);
 
+    /// Returns the number of steps between both keys on the Camelot wheel,
+    /// i.e. the Circle of Fifths as encoded by the OpenKey numbers. Moving
+    /// to an adjacent number or switching between the relative major and
+    /// minor key is one step each. Returns -1 if any of the keys is invalid.
+    static int camelotDistance(mixxx::track::io::key::ChromaticKey key,
+            mixxx::track::io::key::ChromaticKey otherKey);
+
     static mixxx::track::io::key::ChromaticKey guessKeyFromText(const QString& text);
 
     static mixxx::track::io::key::ChromaticKey calculateGlobalKey(
@@ -2,6 +2,9 @@
 
 #include <mp3guessenc.h>
 
+#include <QCache>
+#include <QCryptographicHash>
+#include <QMutex>
 #include <optional>
 
 #include "sources/soundsourceproxy.h"
@@ -18,6 +21,7 @@
 #include "track/serato/cueinfoimporter.h"
 #include "track/taglib/trackmetadata_file.h"
 #include "util/color/predefinedcolorpalettes.h"
+#include "util/compatibility/qmutex.h"
 
 namespace {
 
@@ -67,10 +71,106 @@ bool isCueInfoValid(const mixxx::CueInfo& cueInfo) {
     return true;
 }
 
+// The number of successfully parsed tags of each kind that are kept for
+// reuse, independent of the lifetime of the tracks
+constexpr int kParsedTagCacheSize = 256;
+
+mixxx::cache_key_t sourceCacheKey(const QByteArray& data, mixxx::taglib::FileType fileType) {
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(data);
+    hash.addData(QByteArray(1, static_cast<char>(fileType)));
+    return mixxx::cacheKeyFromMessageDigest(hash.result());
+}
+
+/// Thread-safe, because tracks are imported by multiple threads.
+template<typename T>
+class ParsedTagCache final {
+  public:
+    ParsedTagCache()
+            : m_cache(kParsedTagCacheSize) {
+    }
+
+    bool lookup(mixxx::cache_key_t key, T* pTag) const {
+        const auto locked = lockMutex(&m_mutex);
+        const T* pCachedTag = m_cache.object(key);
+        if (!pCachedTag) {
+            return false;
+        }
+        *pTag = *pCachedTag;
+        return true;
+    }
+
+    void insert(mixxx::cache_key_t key, const T& tag) {
+        const auto locked = lockMutex(&m_mutex);
+        m_cache.insert(key, new T(tag));
+    }
+
+    static ParsedTagCache& instance() {
+        static ParsedTagCache s_instance;
+        return s_instance;
+    }
+
+  private:
+    mutable QMutex m_mutex;
+    QCache<mixxx::cache_key_t, T> m_cache;
+};
+
 } // namespace
 
 namespace mixxx {
 
+template<typename T>
+bool SeratoTags::parseTag(T* pTag,
+        ParserStatus* pStatus,
+        cache_key_t* pSourceKey,
+        const QByteArray& data,
+        taglib::FileType fileType) {
+    if (m_importDisabled) {
+        return false;
+    }
+    const cache_key_t sourceKey = sourceCacheKey(data, fileType);
+    if (!m_modified && *pStatus != ParserStatus::None && *pSourceKey == sourceKey) {
+        return *pStatus == ParserStatus::Parsed;
+    }
+    auto& parsedTagCache = ParsedTagCache<T>::instance();
+    bool success = parsedTagCache.lookup(sourceKey, pTag);
+    if (!success) {
+        success = T::parse(pTag, data, fileType);
+        if (success) {
+            // Failures are not cached, because the result of a failed
+            // parse depends on the previous contents of the tag
+            parsedTagCache.insert(sourceKey, *pTag);
+        }
+    }
+    *pStatus = success ? ParserStatus::Parsed : ParserStatus::Failed;
+    *pSourceKey = sourceKey;
+    return success;
+}
+
+bool SeratoTags::parseBeatGrid(const QByteArray& data, taglib::FileType fileType) {
+    return parseTag(&m_seratoBeatGrid,
+            &m_seratoBeatGridParserStatus,
+            &m_seratoBeatGridSourceKey,
+            data,
+            fileType);
+}
+
+bool SeratoTags::parseMarkers(const QByteArray& data, taglib::FileType fileType) {
+    return parseTag(&m_seratoMarkers,
+            &m_seratoMarkersParserStatus,
+            &m_seratoMarkersSourceKey,
+            data,
+            fileType);
+}
+
+bool SeratoTags::parseMarkers2(const QByteArray& data, taglib::FileType fileType) {
+    return parseTag(&m_seratoMarkers2,
+            &m_seratoMarkers2ParserStatus,
+            &m_seratoMarkers2SourceKey,
+            data,
+            fileType);
+}
+
 double SeratoTags::guessTimingOffsetMillis(
         const QString& filePath,
         const QString& fileType,
@@ -342,6 +442,7 @@ void SeratoTags::setCueInfos(const QList<CueInfo>& cueInfos, double timingOffset
 
     m_seratoMarkers.setCues(cueList);
     m_seratoMarkers2.setCues(cueList);
+    m_modified = true;
 }
 
 std::optional<RgbColor::optional_t> SeratoTags::getTrackColor() const {
@@ -364,6 +465,7 @@ void SeratoTags::setTrackColor(const RgbColor::optional_t& color) {
     auto storedColor = SeratoStoredTrackColor::fromDisplayedColor(color);
     m_seratoMarkers.setTrackColor(storedColor);
     m_seratoMarkers2.setTrackColor(storedColor);
+    m_modified = true;
 }
 
 bool SeratoTags::isBpmLocked() const {
@@ -372,6 +474,7 @@ bool SeratoTags::isBpmLocked() const {
 
 void SeratoTags::setBpmLocked(bool bpmLocked) {
     m_seratoMarkers2.setBpmLocked(bpmLocked);
+    m_modified = true;
 }
 
 } // namespace mixxx
@@ -8,6 +8,7 @@
 #include "track/serato/beatgrid.h"
 #include "track/serato/markers.h"
 #include "track/serato/markers2.h"
+#include "util/cache.h"
 
 namespace mixxx {
 
@@ -23,8 +24,13 @@ class SeratoTags final {
 
     SeratoTags()
             : m_seratoBeatGridParserStatus(ParserStatus::None),
+              m_seratoBeatGridSourceKey(invalidCacheKey()),
               m_seratoMarkersParserStatus(ParserStatus::None),
-              m_seratoMarkers2ParserStatus(ParserStatus::None) {
+              m_seratoMarkersSourceKey(invalidCacheKey()),
+              m_seratoMarkers2ParserStatus(ParserStatus::None),
+              m_seratoMarkers2SourceKey(invalidCacheKey()),
+              m_modified(false),
+              m_importDisabled(false) {
     }
 
     static double guessTimingOffsetMillis(
@@ -56,22 +62,20 @@ class SeratoTags final {
         return ParserStatus::Parsed;
     }
 
-    bool parseBeatGrid(const QByteArray& data, taglib::FileType fileType) {
-        bool success = SeratoBeatGrid::parse(&m_seratoBeatGrid, data, fileType);
-        m_seratoBeatGridParserStatus = success ? ParserStatus::Parsed : ParserStatus::Failed;
-        return success;
+    /// Tags that are re-imported from unmodified data are not parsed
+    /// again. The results are also reused for other instances, e.g. after
+    /// the track has been evicted from the cache and is loaded again.
+    bool parseBeatGrid(const QByteArray& data, taglib::FileType fileType);
+    bool parseMarkers(const QByteArray& data, taglib::FileType fileType);
+    bool parseMarkers2(const QByteArray& data, taglib::FileType fileType);
+
+    /// Skip the import of Serato tags from the file, because they would be
+    /// discarded afterwards. Only reset by assigning new tags.
+    void disableImport() {
+        m_importDisabled = true;
     }
-
-    bool parseMarkers(const QByteArray& data, taglib::FileType fileType) {
-        bool success = SeratoMarkers::parse(&m_seratoMarkers, data, fileType);
-        m_seratoMarkersParserStatus = success ? ParserStatus::Parsed : ParserStatus::Failed;
-        return success;
-    }
-
-    bool parseMarkers2(const QByteArray& data, taglib::FileType fileType) {
-        bool success = SeratoMarkers2::parse(&m_seratoMarkers2, data, fileType);
-        m_seratoMarkers2ParserStatus = success ? ParserStatus::Parsed : ParserStatus::Failed;
-        return success;
+    bool isImportDisabled() const {
+        return m_importDisabled;
     }
 
     QByteArray dumpBeatGrid(taglib::FileType fileType) const {
@@ -97,6 +101,7 @@ class SeratoTags final {
             const Duration& duration,
             double timingOffset) {
         m_seratoBeatGrid.setBeats(pBeats, signalInfo, duration, timingOffset);
+        m_modified = true;
     }
 
     /// Return the track color.
@@ -116,16 +121,63 @@ class SeratoTags final {
     bool isBpmLocked() const;
     void setBpmLocked(bool bpmLocked);
 
+    /// Returns true if both tags have been parsed successfully from the
+    /// same data and have not been modified afterwards. Much cheaper than
+    /// comparing the dumped tags.
+    bool isUnmodifiedCopyOf(const SeratoTags& other) const {
+        return !m_modified && !other.m_modified &&
+                isParsedFromSameSource(m_seratoBeatGridParserStatus,
+                        m_seratoBeatGridSourceKey,
+                        other.m_seratoBeatGridParserStatus,
+                        other.m_seratoBeatGridSourceKey) &&
+                isParsedFromSameSource(m_seratoMarkersParserStatus,
+                        m_seratoMarkersSourceKey,
+                        other.m_seratoMarkersParserStatus,
+                        other.m_seratoMarkersSourceKey) &&
+                isParsedFromSameSource(m_seratoMarkers2ParserStatus,
+                        m_seratoMarkers2SourceKey,
+                        other.m_seratoMarkers2ParserStatus,
+                        other.m_seratoMarkers2SourceKey);
+    }
+
   private:
+    static bool isParsedFromSameSource(ParserStatus status,
+            cache_key_t sourceKey,
+            ParserStatus otherStatus,
+            cache_key_t otherSourceKey) {
+        // The contents of a tag that failed to parse depend on its
+        // previous contents and must be compared
+        return status != ParserStatus::Failed &&
+                status == otherStatus &&
+                sourceKey == otherSourceKey;
+    }
+
+    template<typename T>
+    bool parseTag(T* pTag,
+            ParserStatus* pStatus,
+            cache_key_t* pSourceKey,
+            const QByteArray& data,
+            taglib::FileType fileType);
+
     SeratoBeatGrid m_seratoBeatGrid;
     ParserStatus m_seratoBeatGridParserStatus;
+    // The digest of the parsed data, instead of a copy of the data
+    cache_key_t m_seratoBeatGridSourceKey;
     SeratoMarkers m_seratoMarkers;
     ParserStatus m_seratoMarkersParserStatus;
+    cache_key_t m_seratoMarkersSourceKey;
     SeratoMarkers2 m_seratoMarkers2;
     ParserStatus m_seratoMarkers2ParserStatus;
+    cache_key_t m_seratoMarkers2SourceKey;
+    // Set when the parsed tags have been modified
+    bool m_modified;
+    bool m_importDisabled;
 };
 
 inline bool operator==(const SeratoTags& lhs, const SeratoTags& rhs) {
+    if (lhs.isUnmodifiedCopyOf(rhs)) {
+        return true;
+    }
     // FIXME: Find a more efficient way to do this
     return (lhs.dumpBeatGrid(taglib::FileType::MPEG) ==
                     rhs.dumpBeatGrid(taglib::FileType::MPEG) &&
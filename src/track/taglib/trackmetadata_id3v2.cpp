@@ -1052,6 +1052,10 @@ void importTrackMetadataFromTag(
 #endif // __EXTRA_METADATA__
 
     // Serato tags
+    if (pTrackMetadata->getTrackInfo().getSeratoTags().isImportDisabled()) {
+        // Don't even read the GEOB frames
+        return;
+    }
     const QByteArray seratoBeatGrid =
             readFirstGeneralEncapsulatedObjectFrame(
                     tag,
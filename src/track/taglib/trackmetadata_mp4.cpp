@@ -350,6 +350,9 @@ void importTrackMetadataFromTag(
 #endif // __EXTRA_METADATA__
 
     // Serato tags
+    if (pTrackMetadata->getTrackInfo().getSeratoTags().isImportDisabled()) {
+        return;
+    }
     TagLib::String seratoBeatGridData;
     if (readAtom(
                 tag,
@@ -488,7 +488,8 @@ void importTrackMetadataFromTag(
     //
     // FIXME: We're only parsing FLAC tags for now, since the Ogg format is
     // different we don't support it yet.
-    if (fileType == FileType::FLAC) {
+    if (fileType == FileType::FLAC &&
+            !pTrackMetadata->getTrackInfo().getSeratoTags().isImportDisabled()) {
         TagLib::String seratoBeatGridData;
         if (readCommentField(tag,
                     kCommentFieldKeySeratoBeatGrid,
@@ -10,6 +10,7 @@
 #include "track/keyfactory.h"
 #include "util/assert.h"
 #include "util/logger.h"
+#include "util/memoryusage.h"
 #include "util/time.h"
 
 namespace {
@@ -61,6 +62,63 @@ inline mixxx::Bpm getBeatsPointerBpm(
     return pBeats->getBpmInRange(mixxx::audio::kStartFramePos, trackEndPosition);
 }
 
+qint64 stringBytes(const QString& str) {
+    return str.capacity() * qint64{sizeof(QChar)};
+}
+
+// Strings that are shared between tracks, e.g. interned genres, are
+// accounted for each track.
+qint64 estimateRecordPayloadBytes(const mixxx::TrackRecord& record) {
+    const auto& trackInfo = record.getMetadata().getTrackInfo();
+    const auto& albumInfo = record.getMetadata().getAlbumInfo();
+    qint64 bytes = 0;
+    for (const QString* pString : {
+                 &trackInfo.getArtist(),
+                 &trackInfo.getComment(),
+                 &trackInfo.getComposer(),
+                 &trackInfo.getConductor(),
+                 &trackInfo.getDiscNumber(),
+                 &trackInfo.getDiscTotal(),
+                 &trackInfo.getEncoder(),
+                 &trackInfo.getEncoderSettings(),
+                 &trackInfo.getGenre(),
+                 &trackInfo.getGrouping(),
+                 &trackInfo.getISRC(),
+                 &trackInfo.getKeyText(),
+                 &trackInfo.getLanguage(),
+                 &trackInfo.getLyricist(),
+                 &trackInfo.getMood(),
+                 &trackInfo.getMovement(),
+                 &trackInfo.getRemixer(),
+                 &trackInfo.getSubtitle(),
+                 &trackInfo.getTitle(),
+                 &trackInfo.getTrackNumber(),
+                 &trackInfo.getTrackTotal(),
+                 &trackInfo.getWork(),
+                 &trackInfo.getYear(),
+                 &albumInfo.getArtist(),
+                 &albumInfo.getCopyright(),
+                 &albumInfo.getLicense(),
+                 &albumInfo.getRecordLabel(),
+                 &albumInfo.getTitle(),
+                 &record.getFileType(),
+                 &record.getUrl(),
+                 &record.getCoverInfo().coverLocation,
+         }) {
+        bytes += stringBytes(*pString);
+    }
+    return bytes;
+}
+
+qint64 estimateBeatsBytes(const mixxx::BeatsPointer& pBeats) {
+    if (!pBeats) {
+        return 0;
+    }
+    return sizeof(mixxx::Beats) +
+            static_cast<qint64>(pBeats->getMarkers().size()) *
+            qint64{sizeof(mixxx::BeatMarker)};
+}
+
 constexpr int kMaxBeatsUndoStack = 10;
 // The minimum time that has to pass between beat changes to consider them 'separate'.
 // Used to filter actions done in quick succession.
@@ -95,7 +153,8 @@ Track::Track(
           m_record(trackId),
           m_bDirty(false),
           m_bMarkedForMetadataExport(false),
-          m_undoingBeatsChange(false) {
+          m_undoingBeatsChange(false),
+          m_memoryUsage(mixxx::MemoryUsage::Subsystem::Track, sizeof(Track)) {
     if (kLogStats && kLogger.debugEnabled()) {
         long numberOfInstancesBefore = s_numberOfInstances.fetch_add(1);
         kLogger.debug()
@@ -1472,6 +1531,21 @@ void Track::importPendingCueInfosMarkDirtyAndUnlock(
     emit cuesUpdated();
 }
 
+void Track::updateMemoryUsage() {
+    qint64 bytes = sizeof(Track) + estimateRecordPayloadBytes(m_record);
+    for (const auto& pCue : std::as_const(m_cuePoints)) {
+        bytes += sizeof(Cue) + stringBytes(pCue->getLabel());
+    }
+#ifdef __STEM__
+    bytes += static_cast<qint64>(m_stemInfo.size()) * qint64{sizeof(StemInfo)};
+#endif
+    bytes += estimateBeatsBytes(m_pBeats);
+    for (const auto& pBeats : std::as_const(m_pBeatsUndoStack)) {
+        bytes += estimateBeatsBytes(pBeats);
+    }
+    m_memoryUsage.setBytes(bytes);
+}
+
 void Track::markDirty() {
     auto locked = lockMutex(&m_qMutex);
     setDirtyAndUnlock(&locked, true);
@@ -1486,6 +1560,9 @@ void Track::setDirtyAndUnlock(QT_RECURSIVE_MUTEX_LOCKER* pLock, bool bDirty) {
     const bool dirtyChanged = m_bDirty != bDirty;
     m_bDirty = bDirty;
 
+    // Every modification ends here
+    updateMemoryUsage();
+
     const auto trackId = m_record.getId();
 
     // Unlock before emitting any signals!
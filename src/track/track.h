@@ -20,6 +20,7 @@
 #include "util/color/predefinedcolorpalettes.h"
 #include "util/compatibility/qmutex.h"
 #include "util/fileaccess.h"
+#include "util/memoryusage.h"
 #include "util/performancetimer.h"
 #include "waveform/waveform.h"
 
@@ -526,6 +527,9 @@ class Track : public QObject {
     }
     void setDirtyAndUnlock(QT_RECURSIVE_MUTEX_LOCKER* pLock, bool bDirty);
 
+    /// Re-estimates the accounted memory, must be called while locked.
+    void updateMemoryUsage();
+
     void afterKeysUpdated(QT_RECURSIVE_MUTEX_LOCKER* pLock);
 
     void afterBeatsAndBpmUpdated(QT_RECURSIVE_MUTEX_LOCKER* pLock);
@@ -635,6 +639,10 @@ class Track : public QObject {
     mixxx::BeatsImporterPointer m_pBeatsImporterPending;
     std::unique_ptr<mixxx::CueInfoImporter> m_pCueInfoImporterPending;
 
+    // The estimated size of this object including its metadata, cues and
+    // beats. Waveforms are accounted separately.
+    mixxx::ScopedMemoryUsage m_memoryUsage;
+
     friend class TrackDAO;
     void setHeaderParsedFromTrackDAO(bool headerParsed) {
         // Always operating on a newly created, exclusive instance! No need
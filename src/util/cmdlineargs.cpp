@@ -55,6 +55,7 @@ CmdlineArgs::CmdlineArgs()
           m_controllerDebug(false),
           m_controllerAbortOnWarning(false),
           m_developer(false),
+          m_headless(false),
 #ifdef MIXXX_USE_QML
           m_qml(false),
 #endif
@@ -240,6 +241,16 @@ bool CmdlineArgs::parse(const QStringList& arguments, CmdlineArgs::ParseMode mod
     parser.addOption(timelinePath);
     parser.addOption(timelinePathDeprecated);
 
+    const QCommandLineOption tracePath(QStringLiteral("trace-path"),
+            forUserFeedback ? QCoreApplication::translate("CmdlineArgs",
+                                      "Record trace events from startup on and write them "
+                                      "as Chrome/Perfetto JSON to the given file. "
+                                      "Recording can be toggled at runtime with the "
+                                      "[App],trace_recording control.")
+                            : QString(),
+            QStringLiteral("path"));
+    parser.addOption(tracePath);
+
     const QCommandLineOption enableLegacyVuMeter(QStringLiteral("enable-legacy-vumeter"),
             forUserFeedback ? QCoreApplication::translate("CmdlineArgs",
                                       "Use legacy vu meter")
@@ -282,6 +293,15 @@ bool CmdlineArgs::parse(const QStringList& arguments, CmdlineArgs::ParseMode mod
                             : QString());
     parser.addOption(developer);
 
+    const QCommandLineOption headless(QStringLiteral("headless"),
+            forUserFeedback ? QCoreApplication::translate("CmdlineArgs",
+                                      "Runs the audio engine, library, Auto DJ, controllers "
+                                      "and broadcasting without a user interface. Mixxx can "
+                                      "then be controlled with controllers or through a local "
+                                      "control socket.")
+                            : QString());
+    parser.addOption(headless);
+
 #ifdef MIXXX_USE_QML
     const QCommandLineOption qml(QStringLiteral("new-ui"),
             forUserFeedback
@@ -472,12 +492,17 @@ bool CmdlineArgs::parse(const QStringList& arguments, CmdlineArgs::ParseMode mod
         m_timelinePath = parser.value(timelinePathDeprecated);
     }
 
+    if (parser.isSet(tracePath)) {
+        m_tracePath = parser.value(tracePath);
+    }
+
     m_useLegacyVuMeter = parser.isSet(enableLegacyVuMeter);
     m_useLegacySpinny = parser.isSet(enableLegacySpinny);
     m_controllerDebug = parser.isSet(controllerDebug) || parser.isSet(controllerDebugDeprecated);
     m_controllerPreviewScreens = parser.isSet(controllerPreviewScreens);
     m_controllerAbortOnWarning = parser.isSet(controllerAbortOnWarning);
     m_developer = parser.isSet(developer);
+    m_headless = parser.isSet(headless);
 #ifdef MIXXX_USE_QML
     m_qml = parser.isSet(qml);
     if (parser.isSet(qmlDeprecated)) {
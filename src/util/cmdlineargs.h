@@ -46,6 +46,9 @@ class CmdlineArgs final {
         return m_controllerAbortOnWarning;
     }
     bool getDeveloper() const { return m_developer; }
+    bool isHeadless() const {
+        return m_headless;
+    }
 #ifdef MIXXX_USE_QML
     bool isQml() const {
         return m_qml;
@@ -79,6 +82,9 @@ class CmdlineArgs final {
     }
     const QString& getResourcePath() const { return m_resourcePath; }
     const QString& getTimelinePath() const { return m_timelinePath; }
+    const QString& getTracePath() const {
+        return m_tracePath;
+    }
 
     const QString& getStyle() const {
         return m_styleName;
@@ -107,6 +113,7 @@ class CmdlineArgs final {
     bool m_controllerPreviewScreens;
     bool m_controllerAbortOnWarning; // Controller Engine will be stricter
     bool m_developer; // Developer Mode
+    bool m_headless;
 #ifdef MIXXX_USE_QML
     bool m_qml;
     bool m_awareOfRisk;
@@ -126,5 +133,6 @@ class CmdlineArgs final {
     QString m_settingsPath;
     QString m_resourcePath;
     QString m_timelinePath;
+    QString m_tracePath;
     QString m_styleName;
 };
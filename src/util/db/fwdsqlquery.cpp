@@ -3,6 +3,7 @@
 #include "util/performancetimer.h"
 #include "util/logger.h"
 #include "util/assert.h"
+#include "util/tracerecorder.h"
 
 
 namespace {
@@ -65,6 +66,7 @@ bool FwdSqlQuery::hasDuplicateColumnNameError() const {
 bool FwdSqlQuery::execPrepared() {
     DEBUG_ASSERT(isPrepared());
     DEBUG_ASSERT(!hasError());
+    mixxx::ScopedTraceEvent trace("db", "FwdSqlQuery::execPrepared");
     PerformanceTimer timer;
     if (kLogger.traceEnabled()) {
         timer.start();
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include "util/duration.h"
+
+namespace mixxx {
+
+/// The time at which the input event that is currently processed by this
+/// thread has been received, e.g. a MIDI message from a controller. Control
+/// changes that are triggered while processing the event may use it to
+/// render their effect at a constant latency instead of at the next engine
+/// callback boundary.
+class InputEventTime final {
+  public:
+    /// Returns 0 if no timestamped input event is processed by this thread.
+    static qint64 currentNanos() {
+        return s_currentNanos;
+    }
+
+  private:
+    friend class ScopedInputEventTime;
+
+    static inline thread_local qint64 s_currentNanos = 0;
+};
+
+/// Marks the scope in which an input event with the given timestamp
+/// (see Time::elapsed()) is processed.
+class ScopedInputEventTime final {
+  public:
+    explicit ScopedInputEventTime(Duration timestamp)
+            : m_previousNanos(InputEventTime::s_currentNanos) {
+        InputEventTime::s_currentNanos = timestamp.toIntegerNanos();
+    }
+    ~ScopedInputEventTime() {
+        InputEventTime::s_currentNanos = m_previousNanos;
+    }
+
+    ScopedInputEventTime(const ScopedInputEventTime&) = delete;
+    ScopedInputEventTime& operator=(const ScopedInputEventTime&) = delete;
+
+  private:
+    const qint64 m_previousNanos;
+};
+
+} // namespace mixxx
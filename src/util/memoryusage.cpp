@@ -0,0 +1,78 @@
+#include "util/memoryusage.h"
+
+#include <QMutex>
+#include <vector>
+
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+
+namespace mixxx {
+
+namespace {
+
+struct EvictorEntry {
+    int id;
+    MemoryUsage::Subsystem subsystem;
+    MemoryUsage::Evictor evictor;
+};
+
+QMutex s_evictorsMutex;
+std::vector<EvictorEntry> s_evictors;
+int s_nextEvictorId = 0;
+
+} // anonymous namespace
+
+std::array<std::atomic<qint64>, MemoryUsage::kSubsystemCount> MemoryUsage::s_bytes{};
+
+// static
+int MemoryUsage::addEvictor(Subsystem subsystem, Evictor evictor) {
+    DEBUG_ASSERT(evictor);
+    const auto locked = lockMutex(&s_evictorsMutex);
+    const int evictorId = s_nextEvictorId++;
+    s_evictors.push_back(EvictorEntry{evictorId, subsystem, std::move(evictor)});
+    return evictorId;
+}
+
+// static
+void MemoryUsage::removeEvictor(int evictorId) {
+    const auto locked = lockMutex(&s_evictorsMutex);
+    std::erase_if(s_evictors, [evictorId](const EvictorEntry& entry) {
+        return entry.id == evictorId;
+    });
+}
+
+// static
+void MemoryUsage::evict(Subsystem subsystem) {
+    std::vector<Evictor> evictors;
+    {
+        const auto locked = lockMutex(&s_evictorsMutex);
+        for (const auto& entry : s_evictors) {
+            if (entry.subsystem == subsystem) {
+                evictors.push_back(entry.evictor);
+            }
+        }
+    }
+    // Invoked without holding the lock, evictors may release objects
+    // that remove their own evictors
+    for (const auto& evictor : evictors) {
+        evictor();
+    }
+}
+
+// static
+QString MemoryUsage::subsystemName(Subsystem subsystem) {
+    switch (subsystem) {
+    case Subsystem::CachingReader:
+        return QStringLiteral("caching_reader");
+    case Subsystem::Waveform:
+        return QStringLiteral("waveform");
+    case Subsystem::Track:
+        return QStringLiteral("track");
+    case Subsystem::LibraryTableCache:
+        return QStringLiteral("library_table_cache");
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return QString();
+}
+
+} // namespace mixxx
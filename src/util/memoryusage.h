@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+#include <functional>
+
+namespace mixxx {
+
+/// Process-wide accounting of the memory that is held by the major caches
+/// and data structures. The counters are updated with relaxed atomics and
+/// are safe to use from any thread, including the engine thread.
+///
+/// The numbers are estimates of the payload that is owned by each
+/// subsystem and do not include the overhead of the allocator.
+class MemoryUsage {
+  public:
+    enum class Subsystem : int {
+        /// Sample buffers of all CachingReaders
+        CachingReader,
+        /// Waveform and waveform summary data
+        Waveform,
+        /// Track objects that are alive, i.e. cached in GlobalTrackCache
+        Track,
+        /// Rows of the library table cache (BaseTrackCache)
+        LibraryTableCache,
+    };
+    static constexpr int kSubsystemCount = 4;
+
+    static void add(Subsystem subsystem, qint64 bytes) {
+        s_bytes[static_cast<int>(subsystem)].fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    static qint64 bytes(Subsystem subsystem) {
+        return s_bytes[static_cast<int>(subsystem)].load(std::memory_order_relaxed);
+    }
+
+    /// Returns a name that is suitable for control and stat keys.
+    static QString subsystemName(Subsystem subsystem);
+
+    /// Releases memory of a subsystem on demand by dropping data that
+    /// can be reloaded later.
+    using Evictor = std::function<void()>;
+
+    /// Registers an evictor for the subsystem and returns an id for
+    /// removing it again. Evictors are invoked in the main thread and
+    /// must be removed before their owner is destroyed.
+    static int addEvictor(Subsystem subsystem, Evictor evictor);
+    static void removeEvictor(int evictorId);
+    /// Invokes all evictors of the subsystem.
+    static void evict(Subsystem subsystem);
+
+  private:
+    static std::array<std::atomic<qint64>, kSubsystemCount> s_bytes;
+};
+
+/// Accounts the memory of a single owner. Intended to be used as a member
+/// of the object that holds the memory. The accounted memory is released
+/// on destruction.
+class ScopedMemoryUsage final {
+  public:
+    explicit ScopedMemoryUsage(MemoryUsage::Subsystem subsystem, qint64 bytes = 0)
+            : m_subsystem(subsystem),
+              m_bytes(bytes) {
+        MemoryUsage::add(m_subsystem, m_bytes);
+    }
+    ~ScopedMemoryUsage() {
+        MemoryUsage::add(m_subsystem, -m_bytes);
+    }
+
+    ScopedMemoryUsage(const ScopedMemoryUsage& other)
+            : ScopedMemoryUsage(other.m_subsystem, other.m_bytes) {
+    }
+    ScopedMemoryUsage& operator=(const ScopedMemoryUsage& other) {
+        if (this != &other) {
+            MemoryUsage::add(m_subsystem, -m_bytes);
+            m_subsystem = other.m_subsystem;
+            m_bytes = other.m_bytes;
+            MemoryUsage::add(m_subsystem, m_bytes);
+        }
+        return *this;
+    }
+
+    qint64 bytes() const {
+        return m_bytes;
+    }
+
+    void setBytes(qint64 bytes) {
+        MemoryUsage::add(m_subsystem, bytes - m_bytes);
+        m_bytes = bytes;
+    }
+
+  private:
+    MemoryUsage::Subsystem m_subsystem;
+    qint64 m_bytes;
+};
+
+} // namespace mixxx
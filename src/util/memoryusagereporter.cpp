@@ -0,0 +1,83 @@
+#include "util/memoryusagereporter.h"
+
+#include <QPixmapCache>
+#include <QtDebug>
+
+#include "control/controlobject.h"
+#include "moc_memoryusagereporter.cpp"
+#include "util/stat.h"
+
+namespace mixxx {
+
+namespace {
+
+const QString kMemoryGroup = QStringLiteral("[Memory]");
+
+const ConfigKey kPixmapCacheLimitKbConfigKey =
+        ConfigKey(kMemoryGroup, QStringLiteral("pixmap_cache_limit_kb"));
+
+constexpr int kUpdateIntervalMillis = 1000;
+
+constexpr qint64 kBytesPerKb = 1024;
+
+} // anonymous namespace
+
+MemoryUsageReporter::MemoryUsageReporter(UserSettingsPointer pConfig, QObject* pParent)
+        : QObject(pParent) {
+    for (int i = 0; i < MemoryUsage::kSubsystemCount; ++i) {
+        const auto subsystem = static_cast<MemoryUsage::Subsystem>(i);
+        const QString name = MemoryUsage::subsystemName(subsystem);
+        SubsystemReport& report = m_subsystems[i];
+        report.pControlKb = std::make_unique<ControlObject>(
+                ConfigKey(kMemoryGroup, name + QStringLiteral("_kb")));
+        report.pControlKb->setReadOnly();
+        report.statKey = QStringLiteral("MemoryUsage ") + name;
+        report.softLimitBytes = pConfig->getValue(
+                                        ConfigKey(kMemoryGroup,
+                                                name + QStringLiteral("_soft_limit_kb")),
+                                        0) *
+                kBytesPerKb;
+    }
+
+    // Overrides the default that depends on the device pixel ratio
+    const int pixmapCacheLimitKb = pConfig->getValue(kPixmapCacheLimitKbConfigKey, 0);
+    if (pixmapCacheLimitKb > 0) {
+        qInfo() << "MemoryUsageReporter: Limiting the pixmap cache to"
+                << pixmapCacheLimitKb << "kB";
+        QPixmapCache::setCacheLimit(pixmapCacheLimitKb);
+    }
+
+    connect(&m_timer, &QTimer::timeout, this, &MemoryUsageReporter::slotUpdate);
+    m_timer.start(kUpdateIntervalMillis);
+}
+
+MemoryUsageReporter::~MemoryUsageReporter() = default;
+
+void MemoryUsageReporter::slotUpdate() {
+    for (int i = 0; i < MemoryUsage::kSubsystemCount; ++i) {
+        const auto subsystem = static_cast<MemoryUsage::Subsystem>(i);
+        const qint64 bytes = MemoryUsage::bytes(subsystem);
+        SubsystemReport& report = m_subsystems[i];
+        report.pControlKb->forceSet(static_cast<double>(bytes) / kBytesPerKb);
+        Stat::track(report.statKey,
+                Stat::UNSPECIFIED,
+                Stat::experimentFlags(Stat::COUNT | Stat::AVERAGE | Stat::MIN | Stat::MAX),
+                static_cast<double>(bytes));
+
+        if (report.softLimitBytes <= 0) {
+            continue;
+        }
+        const bool overSoftLimit = bytes > report.softLimitBytes;
+        if (overSoftLimit && !report.overSoftLimit) {
+            qWarning() << "MemoryUsageReporter:"
+                       << MemoryUsage::subsystemName(subsystem)
+                       << "uses" << bytes / kBytesPerKb
+                       << "kB and exceeds its soft limit of"
+                       << report.softLimitBytes / kBytesPerKb << "kB";
+            MemoryUsage::evict(subsystem);
+        }
+        report.overSoftLimit = overSoftLimit;
+    }
+}
+
+} // namespace mixxx
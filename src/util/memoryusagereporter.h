@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <array>
+#include <memory>
+
+#include "preferences/usersettings.h"
+#include "util/memoryusage.h"
+
+class ControlObject;
+
+namespace mixxx {
+
+/// Periodically publishes the counters of MemoryUsage as read-only
+/// controls in the [Memory] group and as developer stats. Soft limits
+/// for each subsystem can be configured in the [Memory] section of the
+/// settings. Exceeding a soft limit logs a warning and invokes the
+/// evictors of the subsystem once, e.g. the library table caches release
+/// the tracks they keep alive, so GlobalTrackCache can evict them together
+/// with their waveforms. Subsystems without evictors, like the
+/// preallocated reader chunks, are only reported.
+///
+/// The size of the pixmap cache, that is used for cover art and waveform
+/// overviews, is enforced by QPixmapCache itself, which evicts the least
+/// recently used pixmaps when the configured limit is exceeded.
+class MemoryUsageReporter : public QObject {
+    Q_OBJECT
+  public:
+    explicit MemoryUsageReporter(UserSettingsPointer pConfig, QObject* pParent = nullptr);
+    ~MemoryUsageReporter() override;
+
+  public slots:
+    void slotUpdate();
+
+  private:
+    struct SubsystemReport {
+        std::unique_ptr<ControlObject> pControlKb;
+        QString statKey;
+        qint64 softLimitBytes = 0;
+        bool overSoftLimit = false;
+    };
+
+    std::array<SubsystemReport, MemoryUsage::kSubsystemCount> m_subsystems;
+    QTimer m_timer;
+};
+
+} // namespace mixxx
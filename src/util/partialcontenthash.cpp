@@ -0,0 +1,103 @@
+#include "util/partialcontenthash.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QtEndian>
+#include <algorithm>
+#include <array>
+
+#include "util/assert.h"
+
+namespace mixxx {
+
+namespace {
+
+constexpr qint64 kBlockSize = 8 * 1024;
+
+// Distances of the hashed blocks from the end of the audio payload.
+// Using blocks further away from the end reduces the collisions of
+// different files that end with silence.
+constexpr std::array<qint64, 3> kBlockEndOffsets = {0, 256 * 1024, 1024 * 1024};
+
+constexpr qint64 kId3v2HeaderSize = 10;
+constexpr qint64 kId3v1TagSize = 128;
+constexpr qint64 kApeTagFooterSize = 32;
+
+QByteArray readAt(QIODevice* pDevice, qint64 pos, qint64 size) {
+    if (pos < 0 || !pDevice->seek(pos)) {
+        return QByteArray();
+    }
+    return pDevice->read(size);
+}
+
+// Returns the size of a leading ID3v2 tag or 0 if there is none
+qint64 leadingTagSize(QIODevice* pDevice) {
+    const QByteArray header = readAt(pDevice, 0, kId3v2HeaderSize);
+    if (header.size() < kId3v2HeaderSize || !header.startsWith("ID3")) {
+        return 0;
+    }
+    // The size is stored as a synchsafe integer with 7 bits per byte
+    qint64 size = 0;
+    for (int i = 6; i < 10; ++i) {
+        size = (size << 7) | (static_cast<quint8>(header.at(i)) & 0x7F);
+    }
+    const bool hasFooter = (static_cast<quint8>(header.at(5)) & 0x10) != 0;
+    return kId3v2HeaderSize + size + (hasFooter ? kId3v2HeaderSize : 0);
+}
+
+// Returns the end of the audio payload before trailing ID3v1 and
+// APEv2 tags
+qint64 payloadEnd(QIODevice* pDevice, qint64 fileSize) {
+    qint64 end = fileSize;
+    if (readAt(pDevice, end - kId3v1TagSize, 3) == "TAG") {
+        end -= kId3v1TagSize;
+    }
+    const QByteArray footer = readAt(pDevice, end - kApeTagFooterSize, kApeTagFooterSize);
+    if (footer.size() == kApeTagFooterSize && footer.startsWith("APETAGEX")) {
+        // The tag size includes the footer but not the optional header
+        const qint64 tagSize = qFromLittleEndian<quint32>(footer.constData() + 12);
+        const quint32 flags = qFromLittleEndian<quint32>(footer.constData() + 20);
+        const bool hasHeader = (flags & 0x80000000u) != 0;
+        end -= tagSize + (hasHeader ? kApeTagFooterSize : 0);
+    }
+    return end;
+}
+
+} // anonymous namespace
+
+cache_key_t partialContentHash(QIODevice* pDevice) {
+    DEBUG_ASSERT(pDevice);
+    DEBUG_ASSERT(pDevice->isOpen());
+    VERIFY_OR_DEBUG_ASSERT(!pDevice->isSequential()) {
+        return invalidCacheKey();
+    }
+    const qint64 begin = leadingTagSize(pDevice);
+    const qint64 end = payloadEnd(pDevice, pDevice->size());
+    if (end <= begin) {
+        return invalidCacheKey();
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    for (const qint64 endOffset : kBlockEndOffsets) {
+        const qint64 blockEnd = end - endOffset;
+        if (blockEnd <= begin) {
+            break;
+        }
+        const qint64 blockBegin = std::max(begin, blockEnd - kBlockSize);
+        const QByteArray block = readAt(pDevice, blockBegin, blockEnd - blockBegin);
+        if (block.size() != blockEnd - blockBegin) {
+            return invalidCacheKey();
+        }
+        hash.addData(block);
+    }
+    return cacheKeyFromMessageDigest(hash.result());
+}
+
+cache_key_t partialContentHash(const QString& filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return invalidCacheKey();
+    }
+    return partialContentHash(&file);
+}
+
+} // namespace mixxx
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QString>
+
+#include "util/cache.h"
+
+class QIODevice;
+
+namespace mixxx {
+
+/// Hashes a few small blocks at the end of the audio payload of a file,
+/// i.e. after stripping a leading ID3v2 tag and trailing ID3v1 and APEv2
+/// tags. Reading only a few kilobytes per file is fast enough to be done
+/// for every file while scanning.
+///
+/// The hash survives renaming, moving and re-tagging a file as long as
+/// its tags are stored at the beginning or in ID3v1/APEv2 tags at the end.
+/// Different files ending with the same digital silence may collide, so
+/// the hash is only meaningful in combination with the duration.
+///
+/// Returns an invalid cache key if the file could not be read.
+cache_key_t partialContentHash(QIODevice* pDevice);
+cache_key_t partialContentHash(const QString& filePath);
+
+} // namespace mixxx
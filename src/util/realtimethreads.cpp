@@ -0,0 +1,248 @@
+#include "util/realtimethreads.h"
+
+#include <QStringList>
+
+#ifdef __LINUX__
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+#include "control/controlobject.h"
+#include "moc_realtimethreads.cpp"
+#include "util/assert.h"
+#include "util/logger.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("RealtimeThreads");
+
+const QString kRealtimeGroup = QStringLiteral("[Realtime]");
+
+const ConfigKey kLockMemoryConfigKey =
+        ConfigKey(kRealtimeGroup, QStringLiteral("lock_memory"));
+
+constexpr int kUpdateIntervalMillis = 1000;
+
+#ifdef __LINUX__
+// Touched once by the audio callback thread after locking the memory,
+// so that deeper calls do not page fault on a fresh stack page.
+constexpr int kStackPrefaultBytes = 64 * 1024;
+constexpr int kPageBytes = 4096;
+
+void prefaultStack() {
+    volatile char buffer[kStackPrefaultBytes];
+    for (int i = 0; i < kStackPrefaultBytes; i += kPageBytes) {
+        buffer[i] = 0;
+    }
+}
+
+QString errorString(int error) {
+    return QString::fromLocal8Bit(std::strerror(error));
+}
+#endif
+
+/// Parses a list of CPU indices like "0,2-3".
+QList<int> parseCpuList(const QString& cpuList) {
+    QList<int> cpus;
+    const QStringList items = cpuList.split(QChar(','), Qt::SkipEmptyParts);
+    for (const auto& item : items) {
+        const QStringList range = item.trimmed().split(QChar('-'));
+        bool firstOk = false;
+        bool lastOk = false;
+        const int first = range.first().toInt(&firstOk);
+        const int last = range.size() == 2 ? range.last().toInt(&lastOk) : first;
+        if (!firstOk || (range.size() == 2 && !lastOk) || range.size() > 2 ||
+                first < 0 || last < first) {
+            kLogger.warning() << "Ignoring invalid CPU list" << cpuList;
+            return {};
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.append(cpu);
+        }
+    }
+    return cpus;
+}
+
+} // anonymous namespace
+
+// static
+std::array<RealtimeThreads::ThreadClassSettings, RealtimeThreads::kThreadClassCount>
+        RealtimeThreads::s_settings;
+// static
+std::array<std::atomic<int>, RealtimeThreads::kThreadClassCount>
+        RealtimeThreads::s_affinityStatus{};
+// static
+std::array<std::atomic<int>, RealtimeThreads::kThreadClassCount>
+        RealtimeThreads::s_priorityStatus{};
+// static
+std::atomic<int> RealtimeThreads::s_memoryLockStatus{0};
+
+RealtimeThreads::RealtimeThreads(UserSettingsPointer pConfig, QObject* pParent)
+        : QObject(pParent) {
+    for (int i = 0; i < kThreadClassCount; ++i) {
+        const QString name = threadClassName(static_cast<ThreadClass>(i));
+        ThreadClassSettings& settings = s_settings[i];
+        settings.cpus = parseCpuList(pConfig->getValueString(
+                ConfigKey(kRealtimeGroup, name + QStringLiteral("_cpus"))));
+        settings.priority = pConfig->getValue(
+                ConfigKey(kRealtimeGroup, name + QStringLiteral("_priority")), 0);
+        ThreadClassReport& report = m_reports[i];
+        report.pAffinityStatus = std::make_unique<ControlObject>(
+                ConfigKey(kRealtimeGroup, name + QStringLiteral("_affinity_status")));
+        report.pAffinityStatus->setReadOnly();
+        report.pPriorityStatus = std::make_unique<ControlObject>(
+                ConfigKey(kRealtimeGroup, name + QStringLiteral("_priority_status")));
+        report.pPriorityStatus->setReadOnly();
+    }
+    m_pMemoryLockStatus = std::make_unique<ControlObject>(
+            ConfigKey(kRealtimeGroup, QStringLiteral("memory_lock_status")));
+    m_pMemoryLockStatus->setReadOnly();
+
+    if (pConfig->getValue(kLockMemoryConfigKey, false)) {
+#ifdef __LINUX__
+        // With a limited RLIMIT_MEMLOCK locking future memory would let
+        // allocations fail as soon as the limit is reached.
+        struct rlimit limit;
+        if (getrlimit(RLIMIT_MEMLOCK, &limit) != 0 || limit.rlim_cur != RLIM_INFINITY) {
+            kLogger.warning() << "Not locking memory, because RLIMIT_MEMLOCK"
+                              << "is not unlimited for this user";
+            setStatus(&s_memoryLockStatus, false);
+        } else if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+            kLogger.warning() << "Failed to lock memory:" << errorString(errno);
+            setStatus(&s_memoryLockStatus, false);
+        } else {
+#ifdef __GLIBC__
+            // Keep freed memory in the locked heap instead of returning it
+            // to the OS and faulting it in again on the next allocation.
+            mallopt(M_TRIM_THRESHOLD, -1);
+#endif
+            kLogger.info() << "Locked all current and future memory";
+            setStatus(&s_memoryLockStatus, true);
+        }
+#else
+        kLogger.warning() << "Locking memory is not supported on this platform";
+        setStatus(&s_memoryLockStatus, false);
+#endif
+    }
+
+    slotUpdate();
+    connect(&m_timer, &QTimer::timeout, this, &RealtimeThreads::slotUpdate);
+    m_timer.start(kUpdateIntervalMillis);
+}
+
+RealtimeThreads::~RealtimeThreads() = default;
+
+// static
+QString RealtimeThreads::threadClassName(ThreadClass threadClass) {
+    switch (threadClass) {
+    case ThreadClass::AudioCallback:
+        return QStringLiteral("audio_callback");
+    case ThreadClass::RubberBandWorker:
+        return QStringLiteral("rubberband_worker");
+    case ThreadClass::CachingReaderWorker:
+        return QStringLiteral("caching_reader_worker");
+    case ThreadClass::SideChain:
+        return QStringLiteral("side_chain");
+    case ThreadClass::Controller:
+        return QStringLiteral("controller");
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return QString();
+}
+
+// static
+void RealtimeThreads::setStatus(std::atomic<int>* pStatus, bool success) {
+    if (!success) {
+        // A failure of any thread of a class is sticky
+        pStatus->store(static_cast<int>(Status::Failed), std::memory_order_relaxed);
+        return;
+    }
+    int expected = static_cast<int>(Status::NotConfigured);
+    pStatus->compare_exchange_strong(expected,
+            static_cast<int>(Status::Applied),
+            std::memory_order_relaxed);
+}
+
+// static
+void RealtimeThreads::applyToCurrentThread(ThreadClass threadClass) {
+    static thread_local bool s_applied = false;
+    if (s_applied) {
+        return;
+    }
+    s_applied = true;
+
+    const int index = static_cast<int>(threadClass);
+    const ThreadClassSettings& settings = s_settings[index];
+#ifdef __LINUX__
+    if (!settings.cpus.isEmpty()) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for (const int cpu : settings.cpus) {
+            if (cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &cpuSet);
+            }
+        }
+        const int result = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+        if (result == 0) {
+            kLogger.info() << "Pinned" << threadClassName(threadClass)
+                           << "thread to CPUs" << settings.cpus;
+        } else {
+            kLogger.warning() << "Failed to pin" << threadClassName(threadClass)
+                              << "thread to CPUs" << settings.cpus << ":"
+                              << errorString(result);
+        }
+        setStatus(&s_affinityStatus[index], result == 0);
+    }
+    if (settings.priority > 0) {
+        struct sched_param param = {};
+        param.sched_priority = qBound(sched_get_priority_min(SCHED_FIFO),
+                settings.priority,
+                sched_get_priority_max(SCHED_FIFO));
+        const int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (result == 0) {
+            kLogger.info() << "Scheduled" << threadClassName(threadClass)
+                           << "thread with SCHED_FIFO priority" << param.sched_priority;
+        } else {
+            kLogger.warning() << "Failed to schedule" << threadClassName(threadClass)
+                              << "thread with SCHED_FIFO priority"
+                              << param.sched_priority << ":" << errorString(result);
+        }
+        setStatus(&s_priorityStatus[index], result == 0);
+    }
+    if (threadClass == ThreadClass::AudioCallback &&
+            memoryLockStatus() == Status::Applied) {
+        prefaultStack();
+    }
+#else
+    if (!settings.cpus.isEmpty() || settings.priority > 0) {
+        kLogger.warning() << "Configuring the" << threadClassName(threadClass)
+                          << "thread is not supported on this platform";
+        if (!settings.cpus.isEmpty()) {
+            setStatus(&s_affinityStatus[index], false);
+        }
+        if (settings.priority > 0) {
+            setStatus(&s_priorityStatus[index], false);
+        }
+    }
+#endif
+}
+
+void RealtimeThreads::slotUpdate() {
+    for (int i = 0; i < kThreadClassCount; ++i) {
+        const auto threadClass = static_cast<ThreadClass>(i);
+        ThreadClassReport& report = m_reports[i];
+        report.pAffinityStatus->forceSet(static_cast<double>(affinityStatus(threadClass)));
+        report.pPriorityStatus->forceSet(static_cast<double>(priorityStatus(threadClass)));
+    }
+    m_pMemoryLockStatus->forceSet(static_cast<double>(memoryLockStatus()));
+}
+
+} // namespace mixxx
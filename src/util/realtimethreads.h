@@ -0,0 +1,114 @@
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <array>
+#include <atomic>
+#include <memory>
+
+#include "preferences/usersettings.h"
+
+class ControlObject;
+
+namespace mixxx {
+
+/// Configures the scheduling of the threads that the audio engine depends
+/// on. For each class of threads the CPU cores it may run on and a
+/// SCHED_FIFO priority can be set in the [Realtime] section of the settings:
+///
+///   [Realtime]
+///   audio_callback_cpus 2,3
+///   audio_callback_priority 80
+///   caching_reader_worker_cpus 1-3
+///   lock_memory 1
+///
+/// With lock_memory all current and future memory of the process is locked
+/// into RAM. Every buffer that is allocated afterwards, including those from
+/// SampleUtil::alloc(), is faulted in when it is mapped and not in the audio
+/// callback when it is first touched.
+///
+/// The settings are only implemented on Linux. Whether each setting has been
+/// applied successfully is logged and published as read-only controls in
+/// the [Realtime] group: 1 = applied, 0 = not configured, -1 = failed.
+class RealtimeThreads : public QObject {
+    Q_OBJECT
+  public:
+    enum class ThreadClass : int {
+        /// The thread that runs the audio callback of the sound device
+        /// that drives the engine.
+        AudioCallback,
+        /// The RubberBandWorkerPool
+        RubberBandWorker,
+        CachingReaderWorker,
+        /// EngineSideChain, i.e. recording and broadcasting
+        SideChain,
+        /// The thread of the ControllerManager
+        Controller,
+    };
+    static constexpr int kThreadClassCount = 5;
+
+    enum class Status : int {
+        Failed = -1,
+        NotConfigured = 0,
+        Applied = 1,
+    };
+
+    /// Reads the settings and locks the memory if configured. Must be
+    /// created before any of the threads is started and only once.
+    explicit RealtimeThreads(UserSettingsPointer pConfig, QObject* pParent = nullptr);
+    ~RealtimeThreads() override;
+
+    /// Applies the CPU affinity and priority that are configured for the
+    /// given class to the calling thread. Only the first invocation per
+    /// thread has an effect, i.e. a thread keeps the settings of the class
+    /// it has been configured for first. This is cheap enough to be invoked
+    /// from the hot path of a thread.
+    static void applyToCurrentThread(ThreadClass threadClass);
+
+    static Status affinityStatus(ThreadClass threadClass) {
+        return static_cast<Status>(
+                s_affinityStatus[static_cast<int>(threadClass)].load(
+                        std::memory_order_relaxed));
+    }
+    static Status priorityStatus(ThreadClass threadClass) {
+        return static_cast<Status>(
+                s_priorityStatus[static_cast<int>(threadClass)].load(
+                        std::memory_order_relaxed));
+    }
+    static Status memoryLockStatus() {
+        return static_cast<Status>(s_memoryLockStatus.load(std::memory_order_relaxed));
+    }
+
+    /// Returns a name that is suitable for setting and control keys.
+    static QString threadClassName(ThreadClass threadClass);
+
+  private slots:
+    void slotUpdate();
+
+  private:
+    struct ThreadClassSettings {
+        /// Empty if the affinity should not be changed
+        QList<int> cpus;
+        /// 0 if the priority should not be changed
+        int priority = 0;
+    };
+
+    struct ThreadClassReport {
+        std::unique_ptr<ControlObject> pAffinityStatus;
+        std::unique_ptr<ControlObject> pPriorityStatus;
+    };
+
+    static void setStatus(std::atomic<int>* pStatus, bool success);
+
+    /// Written once by the constructor before the threads are started
+    static std::array<ThreadClassSettings, kThreadClassCount> s_settings;
+    static std::array<std::atomic<int>, kThreadClassCount> s_affinityStatus;
+    static std::array<std::atomic<int>, kThreadClassCount> s_priorityStatus;
+    static std::atomic<int> s_memoryLockStatus;
+
+    std::array<ThreadClassReport, kThreadClassCount> m_reports;
+    std::unique_ptr<ControlObject> m_pMemoryLockStatus;
+    QTimer m_timer;
+};
+
+} // namespace mixxx
@@ -0,0 +1,342 @@
+#include "util/roaringbitmap.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "util/assert.h"
+
+namespace mixxx {
+
+namespace {
+
+inline quint16 highBits(quint32 value) {
+    return static_cast<quint16>(value >> 16);
+}
+
+inline quint16 lowBits(quint32 value) {
+    return static_cast<quint16>(value & 0xFFFF);
+}
+
+inline bool testBit(const std::vector<quint64>& words, quint16 low) {
+    return (words[low / 64] & (quint64{1} << (low % 64))) != 0;
+}
+
+} // anonymous namespace
+
+bool RoaringBitmap::Chunk::contains(quint16 low) const {
+    if (isBitset()) {
+        return testBit(bitset, low);
+    }
+    return std::binary_search(array.begin(), array.end(), low);
+}
+
+bool RoaringBitmap::Chunk::add(quint16 low) {
+    if (isBitset()) {
+        quint64& word = bitset[low / 64];
+        const quint64 mask = quint64{1} << (low % 64);
+        if ((word & mask) != 0) {
+            return false;
+        }
+        word |= mask;
+        ++cardinality;
+        return true;
+    }
+    const auto it = std::lower_bound(array.begin(), array.end(), low);
+    if (it != array.end() && *it == low) {
+        return false;
+    }
+    if (cardinality < kMaxArraySize) {
+        array.insert(it, low);
+        ++cardinality;
+        return true;
+    }
+    bitset = toBitset();
+    array = std::vector<quint16>();
+    bitset[low / 64] |= quint64{1} << (low % 64);
+    ++cardinality;
+    return true;
+}
+
+bool RoaringBitmap::Chunk::remove(quint16 low) {
+    if (isBitset()) {
+        quint64& word = bitset[low / 64];
+        const quint64 mask = quint64{1} << (low % 64);
+        if ((word & mask) == 0) {
+            return false;
+        }
+        word &= ~mask;
+        if (--cardinality <= kMaxArraySize) {
+            std::vector<quint64> words = std::move(bitset);
+            assignBitset(std::move(words));
+        }
+        return true;
+    }
+    const auto it = std::lower_bound(array.begin(), array.end(), low);
+    if (it == array.end() || *it != low) {
+        return false;
+    }
+    array.erase(it);
+    --cardinality;
+    return true;
+}
+
+std::vector<quint64> RoaringBitmap::Chunk::toBitset() const {
+    if (isBitset()) {
+        return bitset;
+    }
+    std::vector<quint64> words(kBitsetWords, 0);
+    for (const quint16 low : array) {
+        words[low / 64] |= quint64{1} << (low % 64);
+    }
+    return words;
+}
+
+void RoaringBitmap::Chunk::assignBitset(std::vector<quint64>&& words) {
+    DEBUG_ASSERT(static_cast<int>(words.size()) == kBitsetWords);
+    int count = 0;
+    for (const quint64 word : words) {
+        count += qPopulationCount(word);
+    }
+    cardinality = count;
+    if (count > kMaxArraySize) {
+        array = std::vector<quint16>();
+        bitset = std::move(words);
+        return;
+    }
+    std::vector<quint16> values;
+    values.reserve(count);
+    for (int i = 0; i < kBitsetWords; ++i) {
+        quint64 word = words[i];
+        while (word != 0) {
+            values.push_back(static_cast<quint16>(i * 64 + qCountTrailingZeroBits(word)));
+            word &= word - 1;
+        }
+    }
+    array = std::move(values);
+    bitset = std::vector<quint64>();
+}
+
+std::vector<RoaringBitmap::Chunk>::iterator RoaringBitmap::findChunk(quint16 key) {
+    return std::lower_bound(m_chunks.begin(),
+            m_chunks.end(),
+            key,
+            [](const Chunk& chunk, quint16 key) { return chunk.key < key; });
+}
+
+std::vector<RoaringBitmap::Chunk>::const_iterator RoaringBitmap::findChunk(quint16 key) const {
+    return std::lower_bound(m_chunks.begin(),
+            m_chunks.end(),
+            key,
+            [](const Chunk& chunk, quint16 key) { return chunk.key < key; });
+}
+
+quint64 RoaringBitmap::cardinality() const {
+    quint64 result = 0;
+    for (const auto& chunk : m_chunks) {
+        result += chunk.cardinality;
+    }
+    return result;
+}
+
+bool RoaringBitmap::contains(quint32 value) const {
+    const auto it = findChunk(highBits(value));
+    return it != m_chunks.end() && it->key == highBits(value) && it->contains(lowBits(value));
+}
+
+bool RoaringBitmap::add(quint32 value) {
+    auto it = findChunk(highBits(value));
+    if (it == m_chunks.end() || it->key != highBits(value)) {
+        Chunk chunk;
+        chunk.key = highBits(value);
+        it = m_chunks.insert(it, std::move(chunk));
+    }
+    return it->add(lowBits(value));
+}
+
+bool RoaringBitmap::remove(quint32 value) {
+    const auto it = findChunk(highBits(value));
+    if (it == m_chunks.end() || it->key != highBits(value)) {
+        return false;
+    }
+    if (!it->remove(lowBits(value))) {
+        return false;
+    }
+    if (it->cardinality == 0) {
+        m_chunks.erase(it);
+    }
+    return true;
+}
+
+RoaringBitmap& RoaringBitmap::operator&=(const RoaringBitmap& other) {
+    if (&other == this) {
+        return *this;
+    }
+    std::vector<Chunk> result;
+    auto lhs = m_chunks.begin();
+    auto rhs = other.m_chunks.cbegin();
+    while (lhs != m_chunks.end() && rhs != other.m_chunks.cend()) {
+        if (lhs->key < rhs->key) {
+            ++lhs;
+            continue;
+        }
+        if (rhs->key < lhs->key) {
+            ++rhs;
+            continue;
+        }
+        Chunk chunk;
+        chunk.key = lhs->key;
+        if (lhs->isBitset() && rhs->isBitset()) {
+            std::vector<quint64> words = std::move(lhs->bitset);
+            for (int i = 0; i < kBitsetWords; ++i) {
+                words[i] &= rhs->bitset[i];
+            }
+            chunk.assignBitset(std::move(words));
+        } else if (lhs->isBitset() || rhs->isBitset()) {
+            const Chunk& arrayChunk = lhs->isBitset() ? *rhs : *lhs;
+            const Chunk& bitsetChunk = lhs->isBitset() ? *lhs : *rhs;
+            for (const quint16 low : arrayChunk.array) {
+                if (testBit(bitsetChunk.bitset, low)) {
+                    chunk.array.push_back(low);
+                }
+            }
+            chunk.cardinality = static_cast<int>(chunk.array.size());
+        } else {
+            std::set_intersection(lhs->array.begin(),
+                    lhs->array.end(),
+                    rhs->array.begin(),
+                    rhs->array.end(),
+                    std::back_inserter(chunk.array));
+            chunk.cardinality = static_cast<int>(chunk.array.size());
+        }
+        if (chunk.cardinality > 0) {
+            result.push_back(std::move(chunk));
+        }
+        ++lhs;
+        ++rhs;
+    }
+    m_chunks = std::move(result);
+    return *this;
+}
+
+RoaringBitmap& RoaringBitmap::operator|=(const RoaringBitmap& other) {
+    if (&other == this) {
+        return *this;
+    }
+    std::vector<Chunk> result;
+    result.reserve(std::max(m_chunks.size(), other.m_chunks.size()));
+    auto lhs = m_chunks.begin();
+    auto rhs = other.m_chunks.cbegin();
+    while (lhs != m_chunks.end() || rhs != other.m_chunks.cend()) {
+        if (rhs == other.m_chunks.cend() ||
+                (lhs != m_chunks.end() && lhs->key < rhs->key)) {
+            result.push_back(std::move(*lhs));
+            ++lhs;
+            continue;
+        }
+        if (lhs == m_chunks.end() || rhs->key < lhs->key) {
+            result.push_back(*rhs);
+            ++rhs;
+            continue;
+        }
+        Chunk chunk;
+        chunk.key = lhs->key;
+        if (lhs->isBitset() || rhs->isBitset()) {
+            std::vector<quint64> words = lhs->toBitset();
+            if (rhs->isBitset()) {
+                for (int i = 0; i < kBitsetWords; ++i) {
+                    words[i] |= rhs->bitset[i];
+                }
+            } else {
+                for (const quint16 low : rhs->array) {
+                    words[low / 64] |= quint64{1} << (low % 64);
+                }
+            }
+            chunk.assignBitset(std::move(words));
+        } else {
+            std::set_union(lhs->array.begin(),
+                    lhs->array.end(),
+                    rhs->array.begin(),
+                    rhs->array.end(),
+                    std::back_inserter(chunk.array));
+            chunk.cardinality = static_cast<int>(chunk.array.size());
+            if (chunk.cardinality > kMaxArraySize) {
+                chunk.assignBitset(chunk.toBitset());
+            }
+        }
+        result.push_back(std::move(chunk));
+        ++lhs;
+        ++rhs;
+    }
+    m_chunks = std::move(result);
+    return *this;
+}
+
+RoaringBitmap& RoaringBitmap::operator-=(const RoaringBitmap& other) {
+    if (&other == this) {
+        clear();
+        return *this;
+    }
+    std::vector<Chunk> result;
+    result.reserve(m_chunks.size());
+    auto rhs = other.m_chunks.cbegin();
+    for (auto& chunk : m_chunks) {
+        while (rhs != other.m_chunks.cend() && rhs->key < chunk.key) {
+            ++rhs;
+        }
+        if (rhs == other.m_chunks.cend() || rhs->key != chunk.key) {
+            result.push_back(std::move(chunk));
+            continue;
+        }
+        if (chunk.isBitset()) {
+            std::vector<quint64> words = std::move(chunk.bitset);
+            if (rhs->isBitset()) {
+                for (int i = 0; i < kBitsetWords; ++i) {
+                    words[i] &= ~rhs->bitset[i];
+                }
+            } else {
+                for (const quint16 low : rhs->array) {
+                    words[low / 64] &= ~(quint64{1} << (low % 64));
+                }
+            }
+            chunk.assignBitset(std::move(words));
+        } else {
+            const auto end = std::remove_if(chunk.array.begin(),
+                    chunk.array.end(),
+                    [&rhs](quint16 low) { return rhs->contains(low); });
+            chunk.array.erase(end, chunk.array.end());
+            chunk.cardinality = static_cast<int>(chunk.array.size());
+        }
+        if (chunk.cardinality > 0) {
+            result.push_back(std::move(chunk));
+        }
+    }
+    m_chunks = std::move(result);
+    return *this;
+}
+
+std::vector<quint32> RoaringBitmap::toVector() const {
+    std::vector<quint32> values;
+    values.reserve(cardinality());
+    forEach([&values](quint32 value) { values.push_back(value); });
+    return values;
+}
+
+bool operator==(const RoaringBitmap& lhs, const RoaringBitmap& rhs) {
+    if (lhs.m_chunks.size() != rhs.m_chunks.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.m_chunks.size(); ++i) {
+        const auto& lhsChunk = lhs.m_chunks[i];
+        const auto& rhsChunk = rhs.m_chunks[i];
+        // The representation only depends on the cardinality
+        if (lhsChunk.key != rhsChunk.key ||
+                lhsChunk.cardinality != rhsChunk.cardinality ||
+                lhsChunk.array != rhsChunk.array ||
+                lhsChunk.bitset != rhsChunk.bitset) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace mixxx
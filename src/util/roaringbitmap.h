@@ -0,0 +1,120 @@
+#pragma once
+
+#include <QtAlgorithms>
+#include <QtGlobal>
+#include <vector>
+
+namespace mixxx {
+
+/// A compressed set of unsigned 32-bit integers with the layout of a
+/// roaring bitmap: The values are partitioned into chunks by their upper
+/// 16 bits. Each chunk stores the lower 16 bits of its values either as a
+/// sorted array, if it contains only a few values, or as a bitset with
+/// 2^16 bits otherwise.
+///
+/// Sets of database ids, i.e. mostly dense ranges of small integers, need
+/// considerably less memory than in a QSet and can be intersected or
+/// merged in linear time.
+class RoaringBitmap final {
+  public:
+    RoaringBitmap() = default;
+
+    bool isEmpty() const {
+        return m_chunks.empty();
+    }
+    quint64 cardinality() const;
+
+    bool contains(quint32 value) const;
+
+    /// Returns true if the value has not been contained before.
+    bool add(quint32 value);
+    /// Returns true if the value has been contained before.
+    bool remove(quint32 value);
+    void clear() {
+        m_chunks.clear();
+    }
+
+    RoaringBitmap& operator&=(const RoaringBitmap& other);
+    RoaringBitmap& operator|=(const RoaringBitmap& other);
+    /// Removes all values that are contained in other.
+    RoaringBitmap& operator-=(const RoaringBitmap& other);
+
+    /// Invokes the function with each value in ascending order.
+    template<typename F>
+    void forEach(F&& function) const {
+        for (const auto& chunk : m_chunks) {
+            const quint32 high = static_cast<quint32>(chunk.key) << 16;
+            if (chunk.isBitset()) {
+                for (int i = 0; i < kBitsetWords; ++i) {
+                    quint64 word = chunk.bitset[i];
+                    while (word != 0) {
+                        const int bit = qCountTrailingZeroBits(word);
+                        function(high | static_cast<quint32>(i * 64 + bit));
+                        word &= word - 1;
+                    }
+                }
+            } else {
+                for (const quint16 low : chunk.array) {
+                    function(high | low);
+                }
+            }
+        }
+    }
+
+    /// Returns all values in ascending order.
+    std::vector<quint32> toVector() const;
+
+    friend bool operator==(const RoaringBitmap& lhs, const RoaringBitmap& rhs);
+
+  private:
+    /// Chunks with more values are stored as a bitset, which needs
+    /// less memory than an array of 16-bit values from this size on.
+    static constexpr int kMaxArraySize = 4096;
+    static constexpr int kBitsetWords = (1 << 16) / 64;
+
+    struct Chunk {
+        quint16 key = 0;
+        int cardinality = 0;
+        /// Either the sorted values or empty if stored as a bitset.
+        std::vector<quint16> array;
+        /// Either kBitsetWords words or empty if stored as an array.
+        std::vector<quint64> bitset;
+
+        bool isBitset() const {
+            return !bitset.empty();
+        }
+        bool contains(quint16 low) const;
+        bool add(quint16 low);
+        bool remove(quint16 low);
+
+        /// Returns the values as a bitset, regardless of the representation.
+        std::vector<quint64> toBitset() const;
+        /// Stores the bitset in the representation that suits its
+        /// cardinality.
+        void assignBitset(std::vector<quint64>&& words);
+    };
+
+    std::vector<Chunk>::iterator findChunk(quint16 key);
+    std::vector<Chunk>::const_iterator findChunk(quint16 key) const;
+
+    /// Sorted by key without empty chunks.
+    std::vector<Chunk> m_chunks;
+};
+
+inline bool operator!=(const RoaringBitmap& lhs, const RoaringBitmap& rhs) {
+    return !(lhs == rhs);
+}
+
+inline RoaringBitmap operator&(RoaringBitmap lhs, const RoaringBitmap& rhs) {
+    return lhs &= rhs;
+}
+
+inline RoaringBitmap operator|(RoaringBitmap lhs, const RoaringBitmap& rhs) {
+    return lhs |= rhs;
+}
+
+inline RoaringBitmap operator-(RoaringBitmap lhs, const RoaringBitmap& rhs) {
+    return lhs -= rhs;
+}
+
+} // namespace mixxx
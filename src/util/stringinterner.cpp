@@ -0,0 +1,43 @@
+#include "util/stringinterner.h"
+
+#include "util/compatibility/qmutex.h"
+
+namespace mixxx {
+
+StringInterner::StringInterner(int capacity)
+        : m_capacityPerShard((capacity + kShardCount - 1) / kShardCount) {
+}
+
+QString StringInterner::intern(const QString& string) {
+    if (string.isEmpty()) {
+        // Empty strings don't allocate any memory
+        return string;
+    }
+    Shard& shard = m_shards[qHash(string) % kShardCount];
+    const auto locker = lockMutex(&shard.mutex);
+    const auto it = shard.strings.constFind(string);
+    if (it != shard.strings.constEnd()) {
+        return *it;
+    }
+    if (shard.strings.size() >= m_capacityPerShard) {
+        return string;
+    }
+    return *shard.strings.insert(string);
+}
+
+int StringInterner::size() const {
+    int size = 0;
+    for (const auto& shard : m_shards) {
+        const auto locker = lockMutex(&shard.mutex);
+        size += static_cast<int>(shard.strings.size());
+    }
+    return size;
+}
+
+// static
+StringInterner& StringInterner::trackMetadata() {
+    static StringInterner s_instance;
+    return s_instance;
+}
+
+} // namespace mixxx
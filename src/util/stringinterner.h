@@ -0,0 +1,47 @@
+#pragma once
+
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <array>
+
+namespace mixxx {
+
+/// Deduplicates the storage of strings with a low cardinality, e.g. the
+/// genre or the file type of tracks. All equal strings that have been
+/// interned share the same implicitly shared buffer, instead of each track
+/// holding its own copy that has been read from the database.
+///
+/// Interned strings are never released, so only fields with a low
+/// cardinality should be interned. The number of interned strings is
+/// bounded by a capacity. Once it is reached, new strings are returned
+/// unchanged without being stored.
+///
+/// Thread-safe. The strings are distributed among independently locked
+/// shards by their hash, so concurrent track loads rarely contend for the
+/// same lock.
+class StringInterner final {
+  public:
+    static constexpr int kShardCount = 16;
+    static constexpr int kDefaultCapacity = 4096;
+
+    explicit StringInterner(int capacity = kDefaultCapacity);
+
+    QString intern(const QString& string);
+
+    int size() const;
+
+    /// The shared instance for the metadata of tracks
+    static StringInterner& trackMetadata();
+
+  private:
+    struct Shard {
+        mutable QMutex mutex;
+        QSet<QString> strings;
+    };
+
+    const int m_capacityPerShard;
+    std::array<Shard, kShardCount> m_shards;
+};
+
+} // namespace mixxx
@@ -0,0 +1,390 @@
+#include "util/tracerecorder.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QThread>
+#include <QtDebug>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+
+namespace mixxx {
+
+namespace {
+
+struct TraceEvent {
+    const char* category;
+    const char* name;
+    qint64 beginNanos;
+    qint64 durationNanos;
+};
+
+// Written by a single thread, read by the exporting thread.
+struct ThreadBuffer {
+    explicit ThreadBuffer(std::size_t eventCapacity)
+            : capacity(eventCapacity),
+              events(std::make_unique<TraceEvent[]>(eventCapacity)),
+              writeCount(0),
+              threadId(0),
+              threadName{},
+              published(false),
+              owned(false) {
+    }
+
+    const std::size_t capacity;
+    const std::unique_ptr<TraceEvent[]> events;
+    // The total number of events that have been written. Only the last
+    // capacity events are available.
+    std::atomic<std::size_t> writeCount;
+    // Set by the owning thread when claiming the buffer and only read by
+    // the exporting thread after published has been set
+    int threadId;
+    char threadName[TraceRecorder::kMaxThreadNameLength + 1];
+    std::atomic<bool> published;
+    // Set while the owning thread is alive
+    std::atomic<bool> owned;
+};
+
+constexpr int kSpareThreadBuffers = 2;
+
+// Buffers are never deleted, so they can be claimed without locking. The
+// mutex only serializes the allocation of new buffers.
+QMutex s_registryMutex;
+std::array<std::atomic<ThreadBuffer*>, TraceRecorder::kMaxThreads> s_threadBuffers{};
+std::atomic<int> s_threadBufferCount(0);
+std::atomic<int> s_nextThreadId(1);
+std::atomic<std::size_t> s_droppedEventCount(0);
+std::atomic<std::size_t> s_eventsPerThread(TraceRecorder::kDefaultEventsPerThread);
+
+thread_local bool t_realtime = false;
+
+// Lock-free
+ThreadBuffer* tryClaimThreadBuffer(bool emptyOnly) {
+    const int count = s_threadBufferCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i) {
+        ThreadBuffer* pBuffer = s_threadBuffers[i].load(std::memory_order_acquire);
+        if (pBuffer->owned.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        if (emptyOnly && pBuffer->writeCount.load(std::memory_order_relaxed) > 0) {
+            continue;
+        }
+        bool owned = false;
+        if (pBuffer->owned.compare_exchange_strong(owned, true, std::memory_order_acq_rel)) {
+            return pBuffer;
+        }
+    }
+    return nullptr;
+}
+
+// Returns false if the maximum number of buffers has been reached
+bool allocateThreadBufferLocked() {
+    const int count = s_threadBufferCount.load(std::memory_order_relaxed);
+    if (count >= TraceRecorder::kMaxThreads) {
+        return false;
+    }
+    s_threadBuffers[count].store(
+            new ThreadBuffer(s_eventsPerThread.load(std::memory_order_relaxed)),
+            std::memory_order_release);
+    s_threadBufferCount.store(count + 1, std::memory_order_release);
+    return true;
+}
+
+void allocateSpareThreadBuffersLocked() {
+    int spareCount = 0;
+    const int count = s_threadBufferCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; ++i) {
+        const ThreadBuffer* pBuffer = s_threadBuffers[i].load(std::memory_order_relaxed);
+        if (!pBuffer->owned.load(std::memory_order_relaxed) &&
+                pBuffer->writeCount.load(std::memory_order_relaxed) == 0) {
+            ++spareCount;
+        }
+    }
+    for (; spareCount < kSpareThreadBuffers; ++spareCount) {
+        if (!allocateThreadBufferLocked()) {
+            return;
+        }
+    }
+}
+
+ThreadBuffer* claimThreadBuffer() {
+    // Empty buffers are preferred to keep the events of exited threads
+    ThreadBuffer* pBuffer = tryClaimThreadBuffer(true);
+    if (t_realtime) {
+        // Recycling a buffer would release the name of its former thread
+        return pBuffer;
+    }
+    if (!pBuffer) {
+        const auto locker = lockMutex(&s_registryMutex);
+        if (allocateThreadBufferLocked()) {
+            pBuffer = tryClaimThreadBuffer(true);
+        }
+    }
+    if (!pBuffer) {
+        pBuffer = tryClaimThreadBuffer(false);
+        if (!pBuffer) {
+            return nullptr;
+        }
+        // The exporting thread must not read the name while it is replaced
+        const auto locker = lockMutex(&s_registryMutex);
+        pBuffer->published.store(false, std::memory_order_relaxed);
+        pBuffer->writeCount.store(0, std::memory_order_relaxed);
+    }
+    {
+        // Replace the spare buffer for real-time threads
+        const auto locker = lockMutex(&s_registryMutex);
+        allocateSpareThreadBuffersLocked();
+    }
+    return pBuffer;
+}
+
+// Neither locks nor allocates memory
+void copyThreadName(char* pDest, const QString& name) {
+    std::size_t length = 0;
+    for (const QChar ch : name) {
+        if (length == TraceRecorder::kMaxThreadNameLength) {
+            break;
+        }
+        const char latin1 = ch.toLatin1();
+        pDest[length++] = latin1 > 0 ? latin1 : '?';
+    }
+    pDest[length] = '\0';
+}
+
+void publishThreadBuffer(ThreadBuffer* pBuffer) {
+    pBuffer->threadId = s_nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    // Only increments the reference count of the shared string
+    const QString threadName = QThread::currentThread()->objectName();
+    copyThreadName(pBuffer->threadName, threadName);
+    pBuffer->published.store(true, std::memory_order_release);
+}
+
+// Releases the buffer when the thread exits
+class ThreadBufferHolder final {
+  public:
+    ~ThreadBufferHolder() {
+        if (m_pBuffer) {
+            m_pBuffer->owned.store(false, std::memory_order_release);
+        }
+    }
+
+    ThreadBuffer* get() {
+        if (!m_pBuffer) {
+            m_pBuffer = claimThreadBuffer();
+            if (m_pBuffer) {
+                if (t_realtime) {
+                    // A spare buffer that has not been published yet, so
+                    // the exporting thread doesn't read it
+                    publishThreadBuffer(m_pBuffer);
+                } else {
+                    const auto locker = lockMutex(&s_registryMutex);
+                    publishThreadBuffer(m_pBuffer);
+                }
+            }
+        }
+        return m_pBuffer;
+    }
+
+  private:
+    ThreadBuffer* m_pBuffer = nullptr;
+};
+
+thread_local ThreadBufferHolder t_threadBuffer;
+
+// A copy of the buffer list, which is exported without locking
+struct ThreadBufferSnapshot {
+    int threadId;
+    QString threadName;
+    const ThreadBuffer* pBuffer;
+    std::size_t writeCount;
+};
+
+std::vector<ThreadBufferSnapshot> snapshotThreadBuffers() {
+    std::vector<ThreadBufferSnapshot> snapshots;
+    const auto locker = lockMutex(&s_registryMutex);
+    const int count = s_threadBufferCount.load(std::memory_order_acquire);
+    snapshots.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const ThreadBuffer* pBuffer = s_threadBuffers[i].load(std::memory_order_acquire);
+        // The name and id are written before the buffer is published and
+        // the first event is written after that
+        if (!pBuffer->published.load(std::memory_order_acquire)) {
+            continue;
+        }
+        const std::size_t writeCount = pBuffer->writeCount.load(std::memory_order_acquire);
+        if (writeCount == 0) {
+            continue;
+        }
+        QString threadName = QString::fromLatin1(pBuffer->threadName);
+        if (threadName.isEmpty()) {
+            threadName = QStringLiteral("Thread %1").arg(pBuffer->threadId);
+        }
+        snapshots.push_back(ThreadBufferSnapshot{
+                pBuffer->threadId, std::move(threadName), pBuffer, writeCount});
+    }
+    return snapshots;
+}
+
+QString jsonString(const QString& value) {
+    QString result;
+    result.reserve(value.size() + 2);
+    result.append(QChar('"'));
+    for (const QChar ch : value) {
+        if (ch == QChar('\\') || ch == QChar('"')) {
+            result.append(QChar('\\'));
+            result.append(ch);
+        } else if (ch.unicode() < 0x20) {
+            // Control characters are not allowed in JSON strings
+            result.append(QStringLiteral("\\u%1").arg(ch.unicode(), 4, 16, QChar('0')));
+        } else {
+            result.append(ch);
+        }
+    }
+    result.append(QChar('"'));
+    return result;
+}
+
+} // anonymous namespace
+
+std::atomic<bool> TraceRecorder::s_enabled(false);
+
+// static
+void TraceRecorder::setEnabled(bool enabled) {
+    qInfo() << "TraceRecorder:" << (enabled ? "Enabling" : "Disabling") << "trace recording";
+    if (enabled) {
+        const auto locker = lockMutex(&s_registryMutex);
+        allocateSpareThreadBuffersLocked();
+    }
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+// static
+std::size_t TraceRecorder::eventsPerThread() {
+    return s_eventsPerThread.load(std::memory_order_relaxed);
+}
+
+// static
+void TraceRecorder::setEventsPerThread(std::size_t eventsPerThread) {
+    VERIFY_OR_DEBUG_ASSERT(eventsPerThread > 0) {
+        return;
+    }
+    s_eventsPerThread.store(eventsPerThread, std::memory_order_relaxed);
+}
+
+// static
+void TraceRecorder::markCurrentThreadRealtime() {
+    t_realtime = true;
+}
+
+// static
+void TraceRecorder::record(
+        const char* category,
+        const char* name,
+        Duration begin,
+        Duration end) {
+    ThreadBuffer* pBuffer = t_threadBuffer.get();
+    if (!pBuffer) {
+        s_droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const std::size_t index = pBuffer->writeCount.load(std::memory_order_relaxed);
+    pBuffer->events[index % pBuffer->capacity] = TraceEvent{
+            category,
+            name,
+            begin.toIntegerNanos(),
+            (end - begin).toIntegerNanos()};
+    // Publish the event for the exporting thread
+    pBuffer->writeCount.store(index + 1, std::memory_order_release);
+}
+
+// static
+void TraceRecorder::clear() {
+    const auto locker = lockMutex(&s_registryMutex);
+    const int count = s_threadBufferCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i) {
+        ThreadBuffer* pBuffer = s_threadBuffers[i].load(std::memory_order_acquire);
+        if (!pBuffer->owned.load(std::memory_order_acquire)) {
+            // Turns the buffer into a spare buffer
+            pBuffer->published.store(false, std::memory_order_relaxed);
+        }
+        pBuffer->writeCount.store(0, std::memory_order_release);
+    }
+    s_droppedEventCount.store(0, std::memory_order_relaxed);
+}
+
+// static
+std::size_t TraceRecorder::eventCount() {
+    std::size_t count = 0;
+    for (const auto& snapshot : snapshotThreadBuffers()) {
+        count += std::min(snapshot.writeCount, snapshot.pBuffer->capacity);
+    }
+    return count;
+}
+
+// static
+std::size_t TraceRecorder::droppedEventCount() {
+    return s_droppedEventCount.load(std::memory_order_relaxed);
+}
+
+// static
+bool TraceRecorder::writeChromeTrace(const QString& filePath) {
+    // Buffers are never deleted, so the events can be written without
+    // holding the lock
+    const std::vector<ThreadBufferSnapshot> snapshots = snapshotThreadBuffers();
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "TraceRecorder: Could not open file for writing:" << filePath;
+        return false;
+    }
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QTextStream out(&file);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& snapshot : snapshots) {
+        out << (first ? "" : ",")
+            << "\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << pid
+            << ",\"tid\":" << snapshot.threadId
+            << ",\"args\":{\"name\":" << jsonString(snapshot.threadName) << "}}";
+        first = false;
+
+        const std::size_t writeCount = snapshot.writeCount;
+        const std::size_t capacity = snapshot.pBuffer->capacity;
+        const std::size_t beginIndex = writeCount > capacity ? writeCount - capacity : 0;
+        for (std::size_t i = beginIndex; i < writeCount; ++i) {
+            const TraceEvent& event = snapshot.pBuffer->events[i % capacity];
+            // Timestamps are in microseconds with fractional nanoseconds
+            out << ",\n{\"ph\":\"X\",\"cat\":\"" << event.category
+                << "\",\"name\":\"" << event.name
+                << "\",\"pid\":" << pid
+                << ",\"tid\":" << snapshot.threadId
+                << ",\"ts\":" << QString::number(event.beginNanos / 1000.0, 'f', 3)
+                << ",\"dur\":" << QString::number(event.durationNanos / 1000.0, 'f', 3)
+                << "}";
+        }
+    }
+    out << "\n]}\n";
+    out.flush();
+
+    if (!file.commit()) {
+        qWarning() << "TraceRecorder: Failed to write" << filePath << file.errorString();
+        return false;
+    }
+    const std::size_t droppedEventCount = TraceRecorder::droppedEventCount();
+    if (droppedEventCount > 0) {
+        qWarning() << "TraceRecorder: Dropped" << droppedEventCount
+                   << "events of real-time threads without a spare buffer";
+    }
+    qInfo() << "TraceRecorder: Wrote trace events to" << filePath;
+    return true;
+}
+
+} // namespace mixxx
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <QString>
+#include <atomic>
+
+#include "util/duration.h"
+#include "util/time.h"
+
+namespace mixxx {
+
+/// Low-overhead recorder for trace events that can be captured during a
+/// real session and inspected in chrome://tracing or https://ui.perfetto.dev.
+///
+/// Each thread records into its own preallocated ring buffer without any
+/// locking. The first event that a thread records claims a buffer. Real-time
+/// threads only claim one of the spare buffers that are preallocated when
+/// recording is enabled and drop their events if none is left. Other threads
+/// allocate a new buffer if needed, which takes a lock and allocates memory
+/// once. If a buffer is full the oldest events are overwritten.
+///
+/// The buffers of exited threads are kept for exporting and are recycled
+/// for new threads when the maximum number of buffers has been reached.
+///
+/// Category and event names are stored as plain pointers and must therefore
+/// refer to string literals.
+class TraceRecorder {
+  public:
+    /// The default number of events that are kept per thread, i.e. 256 KiB.
+    static constexpr std::size_t kDefaultEventsPerThread = 1 << 13;
+    /// The maximum number of threads that can record at the same time.
+    static constexpr int kMaxThreads = 64;
+    /// Longer thread names are truncated.
+    static constexpr std::size_t kMaxThreadNameLength = 63;
+
+    /// The number of events that are kept per thread. Only applies to the
+    /// buffers that are allocated afterwards, so it should be set before
+    /// recording is enabled for the first time.
+    static std::size_t eventsPerThread();
+    static void setEventsPerThread(std::size_t eventsPerThread);
+
+    static bool isEnabled() {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+    static void setEnabled(bool enabled);
+
+    /// Marks the calling thread as a real-time thread that must neither
+    /// lock nor allocate memory when recording events. Must be called
+    /// before the thread records its first event.
+    static void markCurrentThreadRealtime();
+
+    /// Records a complete event that started at begin and ended at end,
+    /// both measured by mixxx::Time::elapsed().
+    static void record(
+            const char* category,
+            const char* name,
+            Duration begin,
+            Duration end);
+
+    /// Discards all recorded events. Recording should be disabled while
+    /// calling this function.
+    static void clear();
+
+    /// Returns the number of events that are currently stored.
+    static std::size_t eventCount();
+
+    /// Returns the number of events that have been dropped since the last
+    /// clear(), because no buffer was available for the recording thread.
+    static std::size_t droppedEventCount();
+
+    /// Writes all recorded events in the Chrome trace event JSON format.
+    /// Recording should be disabled while calling this function, otherwise
+    /// events that are recorded concurrently might be incomplete.
+    static bool writeChromeTrace(const QString& filePath);
+
+  private:
+    static std::atomic<bool> s_enabled;
+};
+
+/// Records the lifetime of this object as a trace event if recording
+/// is enabled. Otherwise only a relaxed atomic load is performed.
+class ScopedTraceEvent final {
+  public:
+    ScopedTraceEvent(const char* category, const char* name)
+            : m_category(category),
+              m_name(name),
+              m_active(TraceRecorder::isEnabled()) {
+        if (m_active) {
+            m_begin = Time::elapsed();
+        }
+    }
+    ~ScopedTraceEvent() {
+        if (m_active) {
+            TraceRecorder::record(m_category, m_name, m_begin, Time::elapsed());
+        }
+    }
+
+    ScopedTraceEvent(const ScopedTraceEvent&) = delete;
+    ScopedTraceEvent& operator=(const ScopedTraceEvent&) = delete;
+
+  private:
+    const char* const m_category;
+    const char* const m_name;
+    const bool m_active;
+    Duration m_begin;
+};
+
+} // namespace mixxx
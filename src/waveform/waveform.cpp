@@ -242,12 +242,14 @@ void Waveform::resize(int size) {
     m_dataSize = size;
     m_textureStride = computeTextureStride(size);
     m_data.resize(m_textureStride * m_textureStride);
+    m_memoryUsage.setBytes(m_data.size() * sizeof(WaveformData));
 }
 
 void Waveform::assign(int size) {
     m_dataSize = size;
     m_textureStride = computeTextureStride(size);
     m_data.assign(m_textureStride * m_textureStride, {});
+    m_memoryUsage.setBytes(m_data.size() * sizeof(WaveformData));
     m_saveState = SaveState::SavePending;
 }
 
@@ -11,6 +11,7 @@
 #include "audio/signalinfo.h"
 #include "util/class.h"
 #include "util/compatibility/qmutex.h"
+#include "util/memoryusage.h"
 
 enum BandIndex { AllBand = 0,
     Low = 1,
@@ -169,6 +170,7 @@ class Waveform {
     // TODO(XXX): In the future we should switch to QVector and use the raw data
     // pointer when performance matters.
     std::vector<WaveformData> m_data;
+    mixxx::ScopedMemoryUsage m_memoryUsage{mixxx::MemoryUsage::Subsystem::Waveform};
     // Not allowed to change after the constructor runs.
     double m_visualSampleRate;
     // Not allowed to change after the constructor runs.
@@ -25,6 +25,7 @@
 #include "util/math.h"
 #include "util/performancetimer.h"
 #include "util/timer.h"
+#include "util/tracerecorder.h"
 #include "waveform/guitick.h"
 #include "waveform/sharedglcontext.h"
 #include "waveform/visualsmanager.h"
@@ -40,6 +41,7 @@
 #include "waveform/widgets/simplesignalwaveformwidget.h"
 #include "waveform/widgets/softwarewaveformwidget.h"
 #include "waveform/widgets/waveformwidgetabstract.h"
+#include "widget/wglwidget.h"
 #include "widget/wvumeterbase.h"
 #include "widget/wvumeterlegacy.h"
 #include "widget/wwaveformviewer.h"
@@ -85,6 +87,8 @@ const ConfigKey kDefaultZoomKey =
 const ConfigKey kFrameRateKey =
         ConfigKey(kWaveformGroup, QStringLiteral("FrameRate"));
 const ConfigKey kVSyncKey = ConfigKey(kWaveformGroup, QStringLiteral("VSync"));
+const ConfigKey kBatchContextSwitchesKey =
+        ConfigKey(kWaveformGroup, QStringLiteral("batch_context_switches"));
 
 ConfigKey visualGainKey(int index) {
     return ConfigKey(kWaveformGroup, QStringLiteral("VisualGain_") + QString::number(index));
@@ -126,7 +130,9 @@ WaveformWidgetFactory::WaveformWidgetFactory()
           m_configType(WaveformWidgetType::Empty),
           m_config(nullptr),
           m_skipRender(false),
+          m_batchContextSwitches(false),
           m_frameRate(60),
+          m_frameRateDivisor(1),
           m_endOfTrackWarningTime(30),
           m_defaultZoom(WaveformWidgetRenderer::s_waveformDefaultZoom),
           m_zoomSync(true),
@@ -389,6 +395,9 @@ bool WaveformWidgetFactory::setConfig(UserSettingsPointer config) {
         m_config->setValue(kDefaultZoomKey, m_defaultZoom);
     }
 
+    m_batchContextSwitches = m_config->getValue(
+            kBatchContextSwitchesKey, m_batchContextSwitches);
+
     bool zoomSync = m_config->getValue(kZoomSyncKey, m_zoomSync);
     setZoomSync(zoomSync);
 
@@ -556,10 +565,24 @@ void WaveformWidgetFactory::setFrameRate(int frameRate) {
         m_config->setValue(kFrameRateKey, m_frameRate);
     }
     if (m_vsyncThread) {
-        m_vsyncThread->setSyncIntervalTimeMicros(static_cast<int>(1e6 / m_frameRate));
+        m_vsyncThread->setSyncIntervalTimeMicros(syncIntervalTimeMicros());
+    }
+}
+
+void WaveformWidgetFactory::setFrameRateDivisor(int divisor) {
+    VERIFY_OR_DEBUG_ASSERT(divisor >= 1) {
+        divisor = 1;
+    }
+    m_frameRateDivisor = divisor;
+    if (m_vsyncThread) {
+        m_vsyncThread->setSyncIntervalTimeMicros(syncIntervalTimeMicros());
     }
 }
 
+int WaveformWidgetFactory::syncIntervalTimeMicros() const {
+    return static_cast<int>(1e6 * m_frameRateDivisor / m_frameRate);
+}
+
 void WaveformWidgetFactory::setEndOfTrackWarningTime(int endTime) {
     m_endOfTrackWarningTime = endTime;
     if (m_config) {
@@ -803,10 +826,17 @@ void WaveformWidgetFactory::notifyZoomChange(WWaveformViewer* viewer) {
 }
 
 void WaveformWidgetFactory::renderSelf() {
+    mixxx::ScopedTraceEvent trace("waveform", "WaveformWidgetFactory::render");
     ScopedTimer t(QStringLiteral("WaveformWidgetFactory::render() %1waveforms"),
             static_cast<int>(m_waveformWidgetHolders.size()));
 
     if (!m_skipRender) {
+#ifdef MIXXX_USE_QOPENGL
+        // Release the context once after all waveforms, spinnies and
+        // VU meters have been rendered instead of after each of them.
+        WGLWidget::ScopedBatchedContextSwitches batchedContextSwitches(
+                m_batchContextSwitches);
+#endif
         if (m_type) {   // no regular updates for an empty waveform
             // next rendered frame is displayed after next buffer swap and than after VSync
             QVarLengthArray<bool, 10> shouldRenderWaveforms(
@@ -877,11 +907,18 @@ void WaveformWidgetFactory::render() {
 }
 
 void WaveformWidgetFactory::swapSelf() {
+    mixxx::ScopedTraceEvent trace("waveform", "WaveformWidgetFactory::swap");
     ScopedTimer t(QStringLiteral("WaveformWidgetFactory::swap() %1waveforms"),
             static_cast<int>(m_waveformWidgetHolders.size()));
 
     // Do this in an extra slot to be sure to hit the desired interval
     if (!m_skipRender) {
+#ifdef MIXXX_USE_QOPENGL
+        // Same for the swaps. Each swap only needs the context of its own
+        // window to be current.
+        WGLWidget::ScopedBatchedContextSwitches batchedContextSwitches(
+                m_batchContextSwitches);
+#endif
         if (m_type) {   // no regular updates for an empty waveform
             // Show rendered buffer from last render() run
             //qDebug() << "swap() start" << m_vsyncThread->elapsed();
@@ -1236,7 +1273,7 @@ void WaveformWidgetFactory::startVSync(
     m_pVisualsManager = pVisualsManager;
     m_vsyncThread = new VSyncThread(this, vSyncMode);
     m_vsyncThread->setObjectName(QStringLiteral("VSync"));
-    m_vsyncThread->setSyncIntervalTimeMicros(static_cast<int>(1e6 / m_frameRate));
+    m_vsyncThread->setSyncIntervalTimeMicros(syncIntervalTimeMicros());
 
 #ifdef MIXXX_USE_QOPENGL
     if (m_vsyncThread->vsyncMode() == VSyncThread::ST_PLL) {
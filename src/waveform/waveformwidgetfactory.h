@@ -122,6 +122,9 @@ class WaveformWidgetFactory : public QObject,
 
     void setFrameRate(int frameRate);
     int getFrameRate() const { return m_frameRate;}
+    /// Temporarily renders only every n-th frame, e.g. while the audio
+    /// engine is overloaded. Unlike setFrameRate() this is not persisted.
+    void setFrameRateDivisor(int divisor);
     // bool getVSync() const { return m_vSyncType;}
     void setEndOfTrackWarningTime(int endTime);
     int getEndOfTrackWarningTime() const { return m_endOfTrackWarningTime;}
@@ -283,6 +286,7 @@ class WaveformWidgetFactory : public QObject,
   private:
     void renderSelf();
     void swapSelf();
+    int syncIntervalTimeMicros() const;
 
     void addHandle(
             QHash<WaveformWidgetType::Type, QList<WaveformWidgetBackend>>&
@@ -314,7 +318,13 @@ class WaveformWidgetFactory : public QObject,
     UserSettingsPointer m_config;
 
     bool m_skipRender;
+    // Release the OpenGL context once per render or swap pass instead of
+    // once per widget, see WGLWidget::ScopedBatchedContextSwitches.
+    // Experimental and off by default, because the benefit has not been
+    // measured yet.
+    bool m_batchContextSwitches;
     int m_frameRate;
+    int m_frameRateDivisor;
     int m_endOfTrackWarningTime;
     double m_defaultZoom;
     bool m_zoomSync;
@@ -1,9 +1,33 @@
+#include <QOpenGLContext>
 #include <QResizeEvent>
 
+#include "util/assert.h"
 #include "widget/openglwindow.h"
 #include "widget/tooltipqopengl.h"
 #include "widget/wglwidget.h"
 
+bool WGLWidget::s_batchedContextSwitches = false;
+
+WGLWidget::ScopedBatchedContextSwitches::ScopedBatchedContextSwitches(bool enabled)
+        : m_enabled(enabled && !s_batchedContextSwitches) {
+    // Nested scopes are not supported and fall back to the outer scope
+    DEBUG_ASSERT(!enabled || !s_batchedContextSwitches);
+    if (m_enabled) {
+        s_batchedContextSwitches = true;
+    }
+}
+
+WGLWidget::ScopedBatchedContextSwitches::~ScopedBatchedContextSwitches() {
+    if (!m_enabled) {
+        return;
+    }
+    s_batchedContextSwitches = false;
+    QOpenGLContext* pContext = QOpenGLContext::currentContext();
+    if (pContext) {
+        pContext->doneCurrent();
+    }
+}
+
 WGLWidget::WGLWidget(QWidget* pParent)
         : QWidget(pParent),
           m_pOpenGLWindow(nullptr),
@@ -65,7 +89,7 @@ void WGLWidget::makeCurrentIfNeeded() {
 }
 
 void WGLWidget::doneCurrent() {
-    if (m_pOpenGLWindow) {
+    if (m_pOpenGLWindow && !s_batchedContextSwitches) {
         m_pOpenGLWindow->doneCurrent();
     }
 }
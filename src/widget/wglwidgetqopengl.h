@@ -17,6 +17,24 @@ class TrackDropTarget;
 
 class WGLWidget : public QWidget {
   public:
+    /// Defers releasing the OpenGL context to the end of the scope while a
+    /// batch of widgets is rendered or swapped on the GUI thread. Every
+    /// doneCurrent() within the scope is a no-op, and the context that is
+    /// current at the end is released once. Making the context of the next
+    /// widget current implicitly releases the previous one, so the explicit
+    /// release between widgets is only an extra context switch.
+    class ScopedBatchedContextSwitches final {
+      public:
+        explicit ScopedBatchedContextSwitches(bool enabled);
+        ~ScopedBatchedContextSwitches();
+
+        ScopedBatchedContextSwitches(const ScopedBatchedContextSwitches&) = delete;
+        ScopedBatchedContextSwitches& operator=(const ScopedBatchedContextSwitches&) = delete;
+
+      private:
+        const bool m_enabled;
+    };
+
     WGLWidget(QWidget* parent);
     ~WGLWidget();
 
@@ -47,6 +65,8 @@ class WGLWidget : public QWidget {
     QPaintDevice* paintDevice();
 
   private:
+    static bool s_batchedContextSwitches;
+
     OpenGLWindow* m_pOpenGLWindow;
     QWidget* m_pContainerWidget;
     TrackDropTarget* m_pTrackDropTarget;
@@ -68,6 +68,8 @@ WOverview::WOverview(
           m_trackLoaded(false),
           m_pHoveredMark(nullptr),
           m_scaleFactor(1.0),
+          m_marksLayerGain(0),
+          m_marksLayerHovered(false),
           m_trackSampleRateControl(
                   m_group,
                   QStringLiteral("track_samplerate")),
@@ -269,6 +271,7 @@ void WOverview::setup(const QDomNode& node, const SkinContext& context) {
     }
 
     setFocusPolicy(Qt::NoFocus);
+    invalidateLayers();
 }
 
 void WOverview::initWithTrack(TrackPointer pTrack) {
@@ -339,6 +342,7 @@ void WOverview::slotWaveformSummaryUpdated() {
         m_actualCompletion = 0;
         m_waveformPeak = -1.0;
         m_pixmapDone = false;
+        m_waveformLayer = QPixmap();
 
         update();
     }
@@ -364,6 +368,7 @@ void WOverview::slotTrackLoaded(TrackPointer pTrack) {
     if (m_pCurrentTrack) {
         updateCues(m_pCurrentTrack->getCuePoints());
     }
+    invalidateLayers();
     update();
 }
 
@@ -392,6 +397,7 @@ void WOverview::slotLoadingTrack(TrackPointer pNewTrack, TrackPointer pOldTrack)
     // signal has been received.
     m_trackLoaded = false;
     m_endOfTrack = false;
+    invalidateLayers();
 
     if (pNewTrack) {
         m_pCurrentTrack = pNewTrack;
@@ -412,7 +418,11 @@ void WOverview::slotLoadingTrack(TrackPointer pNewTrack, TrackPointer pOldTrack)
 
 void WOverview::onEndOfTrackChange(double v) {
     //qDebug() << "WOverview::onEndOfTrackChange()" << v;
-    m_endOfTrack = v > 0.0;
+    const bool endOfTrack = v > 0.0;
+    if (m_endOfTrack != endOfTrack) {
+        m_endOfTrack = endOfTrack;
+        m_waveformLayer = QPixmap();
+    }
     update();
 }
 
@@ -428,6 +438,7 @@ void WOverview::onMarkChanged(double v) {
 void WOverview::onMarkRangeChange(double v) {
     Q_UNUSED(v);
     //qDebug() << "WOverview::onMarkRangeChange()" << v;
+    m_marksLayer = QPixmap();
     update();
 }
 
@@ -463,6 +474,7 @@ void WOverview::slotTypeControlChanged(double v) {
     m_type = type;
     m_pWaveform.clear();
     m_waveformSourceImage = QImage();
+    m_waveformLayer = QPixmap();
     slotWaveformSummaryUpdated();
 }
 
@@ -506,6 +518,7 @@ void WOverview::updateCues(const QList<CuePointer> &loadedCues) {
     }
 
     m_marks.update();
+    m_marksLayer = QPixmap();
 }
 
 // connecting the tracks cuesUpdated and onMarkChanged is not possible
@@ -684,19 +697,22 @@ void WOverview::paintEvent(QPaintEvent* pEvent) {
     Q_UNUSED(pEvent);
     ScopedTimer t(QStringLiteral("WOverview::paintEvent"));
 
-    QPainter painter(this);
-    painter.fillRect(rect(), m_backgroundColor);
-
-    if (!m_backgroundPixmap.isNull()) {
-        painter.drawPixmap(rect(), m_backgroundPixmap);
+    // The background with the waveform and the marks are cached in layers
+    // that are only redrawn after they have changed. A play position update
+    // only draws the played overlay, the play position and the labels.
+    if (m_pCurrentTrack && updateWaveformImageScaled()) {
+        m_waveformLayer = QPixmap();
+    }
+    if (m_waveformLayer.isNull()) {
+        drawWaveformLayer();
     }
 
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, m_waveformLayer);
+
     if (m_pCurrentTrack) {
         // Refer to util/ScopePainter.h to understand the semantics of
         // ScopePainter.
-        drawEndOfTrackBackground(&painter);
-        drawAxis(&painter);
-        drawWaveformPixmap(&painter);
         drawPlayedOverlay(&painter);
         drawMinuteMarkers(&painter);
         drawPlayPosition(&painter);
@@ -709,8 +725,13 @@ void WOverview::paintEvent(QPaintEvent* pEvent) {
             const auto gain = static_cast<CSAMPLE_GAIN>(length() - 2) /
                     static_cast<CSAMPLE_GAIN>(trackSamples);
 
-            drawRangeMarks(&painter, offset, gain);
-            drawMarks(&painter, offset, gain);
+            // The labels of a hovered mark show the distance to the play
+            // position, so the layer is redrawn as long as a mark is hovered.
+            if (m_marksLayer.isNull() || m_marksLayerGain != gain ||
+                    m_pHoveredMark || m_marksLayerHovered) {
+                drawMarksLayer(offset, gain);
+            }
+            painter.drawPixmap(0, 0, m_marksLayer);
             drawPickupPosition(&painter);
             drawTimeRuler(&painter);
             drawMarkLabels(&painter, offset, gain);
@@ -726,6 +747,45 @@ void WOverview::paintEvent(QPaintEvent* pEvent) {
     }
 }
 
+void WOverview::invalidateLayers() {
+    m_waveformLayer = QPixmap();
+    m_marksLayer = QPixmap();
+}
+
+QPixmap WOverview::createLayer() const {
+    QPixmap layer(size() * m_devicePixelRatio);
+    layer.setDevicePixelRatio(m_devicePixelRatio);
+    layer.fill(Qt::transparent);
+    return layer;
+}
+
+void WOverview::drawWaveformLayer() {
+    m_waveformLayer = createLayer();
+    QPainter painter(&m_waveformLayer);
+    painter.setFont(font());
+    painter.fillRect(rect(), m_backgroundColor);
+
+    if (!m_backgroundPixmap.isNull()) {
+        painter.drawPixmap(rect(), m_backgroundPixmap);
+    }
+
+    if (m_pCurrentTrack) {
+        drawEndOfTrackBackground(&painter);
+        drawAxis(&painter);
+        drawWaveformPixmap(&painter);
+    }
+}
+
+void WOverview::drawMarksLayer(const float offset, const float gain) {
+    m_marksLayer = createLayer();
+    QPainter painter(&m_marksLayer);
+    painter.setFont(font());
+    drawRangeMarks(&painter, offset, gain);
+    drawMarks(&painter, offset, gain);
+    m_marksLayerGain = gain;
+    m_marksLayerHovered = m_pHoveredMark != nullptr;
+}
+
 void WOverview::drawEndOfTrackBackground(QPainter* pPainter) {
     if (m_endOfTrack) {
         PainterScope painterScope(pPainter);
@@ -745,9 +805,9 @@ void WOverview::drawAxis(QPainter* pPainter) {
     }
 }
 
-void WOverview::drawWaveformPixmap(QPainter* pPainter) {
+bool WOverview::updateWaveformImageScaled() {
     if (m_waveformSourceImage.isNull()) {
-        return;
+        return false;
     }
 
     WaveformWidgetFactory* pWidgetFactory = WaveformWidgetFactory::instance();
@@ -793,8 +853,15 @@ void WOverview::drawWaveformPixmap(QPainter* pPainter) {
                 Qt::IgnoreAspectRatio,
                 Qt::SmoothTransformation);
         m_diffGain = diffGain;
+        return true;
     }
+    return false;
+}
 
+void WOverview::drawWaveformPixmap(QPainter* pPainter) {
+    if (m_waveformSourceImage.isNull() || m_waveformImageScaled.isNull()) {
+        return;
+    }
     pPainter->drawImage(rect(), m_waveformImageScaled);
 }
 
@@ -1491,6 +1558,7 @@ bool WOverview::drawNextPixmapPart() {
 
     m_waveformImageScaled = QImage();
     m_diffGain = 0;
+    m_waveformLayer = QPixmap();
 
     // Test if the complete waveform is done
     if (m_actualCompletion >= dataSize - 2) {
@@ -1546,6 +1614,7 @@ void WOverview::resizeEvent(QResizeEvent* pEvent) {
 
     m_waveformImageScaled = QImage();
     m_diffGain = 0;
+    invalidateLayers();
     Init();
 }
 
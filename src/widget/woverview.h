@@ -85,6 +85,13 @@ class WOverview : public WWidget, public TrackDropTarget {
             ConstWaveformPointer pWaveform,
             const int nextCompletion);
 
+    void invalidateLayers();
+    QPixmap createLayer() const;
+    void drawWaveformLayer();
+    void drawMarksLayer(const float offset, const float gain);
+    // Returns true if m_waveformImageScaled has been updated
+    bool updateWaveformImageScaled();
+
     void drawEndOfTrackBackground(QPainter* pPainter);
     void drawAxis(QPainter* pPainter);
     void drawWaveformPixmap(QPainter* pPainter);
@@ -186,6 +193,15 @@ class WOverview : public WWidget, public TrackDropTarget {
     QImage m_waveformSourceImage;
     QImage m_waveformImageScaled;
 
+    // Cached layers of the widget contents that do not depend on the play
+    // position. A null pixmap needs to be redrawn.
+    // Background, end of track background, axis and waveform
+    QPixmap m_waveformLayer;
+    // Range marks and marks
+    QPixmap m_marksLayer;
+    float m_marksLayerGain;
+    bool m_marksLayerHovered;
+
     WaveformSignalColors m_signalColors;
 
     parented_ptr<ControlProxy> m_endOfTrackControl;
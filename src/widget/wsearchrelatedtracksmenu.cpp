@@ -137,7 +137,8 @@ QString WSearchRelatedTracksMenu::elideActionText(
 }
 
 void WSearchRelatedTracksMenu::addActionsForTrack(
-        const Track& track) {
+        const Track& track,
+        const QList<TrackId>& similarTrackIds) {
     // NOTE: We have to explicitly use `QString` instead of `auto`
     // when composing search queries using `QStringBuilder`. Otherwise
     // string concatenation will fail at runtime!
@@ -180,6 +181,34 @@ void WSearchRelatedTracksMenu::addActionsForTrack(
         }
     }
 
+    if (!similarTrackIds.isEmpty()) {
+        // The alternatives can't be combined with the other
+        // queries, which are joined by AND. Therefore this is
+        // a plain action without a checkbox.
+        QStringList trackQueries;
+        trackQueries.reserve(similarTrackIds.size());
+        for (const auto& trackId : similarTrackIds) {
+            trackQueries.append(QStringLiteral("id:") + trackId.toString());
+        }
+        const QString searchQuery = trackQueries.join(QStringLiteral(" | "));
+        if (addSeparatorBeforeNextAction) {
+            addSeparator();
+        }
+        addSeparatorBeforeNextAction = false;
+        auto pAction = make_parented<QAction>(
+                tr("Mixes well: %n track(s) with similar BPM, key and loudness",
+                        "",
+                        similarTrackIds.size()),
+                this);
+        connect(pAction.get(),
+                &QAction::triggered,
+                this,
+                [this, searchQuery]() {
+                    emit triggerSearch(searchQuery);
+                });
+        addAction(pAction.get());
+    }
+
     // Artist actions
     addSeparatorBeforeNextAction = !isEmpty();
     {
@@ -2,6 +2,7 @@
 
 #include <QMenu>
 
+#include "track/trackid.h"
 #include "util/parented_ptr.h"
 #include "widget/wmenucheckbox.h"
 
@@ -36,8 +37,11 @@ class WSearchRelatedTracksMenu : public QMenu {
             QWidget* pParent = nullptr);
     ~WSearchRelatedTracksMenu() override = default;
 
+    /// The similar tracks are offered as a single search for tracks
+    /// that mix well with the given track.
     void addActionsForTrack(
-            const Track& track);
+            const Track& track,
+            const QList<TrackId>& similarTrackIds = QList<TrackId>());
     bool eventFilter(QObject* pObj, QEvent* e) override;
 
   signals:
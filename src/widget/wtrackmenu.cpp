@@ -28,6 +28,7 @@
 #include "library/trackset/crate/crate.h"
 #include "library/trackset/crate/cratefeaturehelper.h"
 #include "library/trackset/crate/cratesummary.h"
+#include "library/tracksimilarityindex.h"
 #include "mixer/playerinfo.h"
 #include "mixer/playermanager.h"
 #include "moc_wtrackmenu.cpp"
@@ -60,6 +61,9 @@ constexpr WTrackMenu::Features WTrackMenu::kDeckTrackMenuFeatures;
 namespace {
 const QString kAppGroup = QStringLiteral("[App]");
 
+// The number of tracks that are offered as mixing well with a track
+constexpr int kSimilarTracksCount = 20;
+
 const QString samplerTrString(int i) {
     return QObject::tr("Sampler %1").arg(i);
 }
@@ -252,7 +256,9 @@ void WTrackMenu::createMenus() {
                         VERIFY_OR_DEBUG_ASSERT(m_pSearchRelatedMenu->isEnabled()) {
                             m_pSearchRelatedMenu->setEnabled(true);
                         }
-                        m_pSearchRelatedMenu->addActionsForTrack(*pTrack);
+                        m_pSearchRelatedMenu->addActionsForTrack(*pTrack,
+                                m_pLibrary->trackSimilarityIndex()->findNearest(
+                                        pTrack->getId(), kSimilarTracksCount));
                     }
                     m_pSearchRelatedMenu->setEnabled(
                             !m_pSearchRelatedMenu->isEmpty());